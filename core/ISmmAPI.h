@@ -391,6 +391,32 @@ namespace SourceMM
 								  size_t maxlength,
 								  const char *format,
 								  va_list ap) =0;
+
+		/**
+		 * @brief Publishes an interface by name.  MetaFactory() finds published 
+		 * interfaces without asking every IMetamodListener, so this is the 
+		 * preferred way of exposing interfaces to other plugins.  Interfaces 
+		 * are removed automatically when the plugin unloads.
+		 *
+		 * Only available if GetApiVersions() reports a major version of 2 
+		 * and a minor version of at least 1 (METAMOD_API_MINOR).
+		 *
+		 * @param plugin		Plugin API pointer.
+		 * @param iface			Interface name.
+		 * @param ptr			Interface pointer.
+		 * @return				False if the name is already published.
+		 */
+		virtual bool RegisterInterface(ISmmPlugin *plugin, const char *iface, void *ptr) =0;
+
+		/**
+		 * @brief Removes an interface published with RegisterInterface().
+		 *
+		 * Same API version requirement as RegisterInterface().
+		 *
+		 * @param plugin		Plugin API pointer.
+		 * @param iface			Interface name.
+		 */
+		virtual void UnregisterInterface(ISmmPlugin *plugin, const char *iface) =0;
 	};
 }
 
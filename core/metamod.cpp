@@ -33,6 +33,7 @@
 #include "metamod_plugins.h"
 #include "metamod_util.h"
 #include "metamod_console.h"
+#include "metamod_interfaces.h"
 #include "provider/provider_ep2.h"
 #include <sys/stat.h>
 #if SOURCE_ENGINE == SE_DOTA
@@ -99,11 +100,19 @@ Handler_GameInit();
 static void
 InitializeVSP();
 
-static int
-LoadPluginsFromFile(const char *filepath, int &skipped);
+/* A plugin listed in metaplugins.ini or a .vdf file, loaded by mm_LoadPlugins() */
+struct plugin_entry_t
+{
+	std::string path;		/* Full path */
+	std::string name;		/* As listed, for error messages */
+	bool vdf;
+};
 
-static int
-LoadVDFPluginsFromDir(const char *dir, int &skipped);
+static void
+ReadPluginsFromFile(const char *filepath, std::vector<plugin_entry_t> &plugins);
+
+static void
+ReadVDFPluginsFromDir(const char *dir, std::vector<plugin_entry_t> &plugins);
 
 struct game_dll_t
 {
@@ -129,7 +138,7 @@ static ConVar *mm_basedir = NULL;
 static CreateInterfaceFn engine_factory = NULL;
 static CreateInterfaceFn physics_factory = NULL;
 static CreateInterfaceFn filesystem_factory = NULL;
-#if !defined( _WIN64 ) && !defined( __amd64__ )
+#if !defined( _WIN64 )
 static CHookManagerAutoGen g_SH_HookManagerAutoGen(&g_SourceHook);
 #endif
 static META_RES last_meta_res;
@@ -143,36 +152,37 @@ CSourceHookImpl g_SourceHook;
 ISourceHook *g_SHPtr = &g_SourceHook;
 SourceMM::ISmmAPI *g_pMetamod = &g_Metamod;
 
-/* Helper Macro */
+/* Helper Macro
+ * Factories may hand out a new instance per call, so only misses are cached,
+ * and only while no listener answers the query: a listener may know the
+ * interface by the next call.
+ */
 #define	IFACE_MACRO(orig,nam) \
-	CPluginManager::CPlugin *pl; \
-	std::list<IMetamodListener *>::iterator event; \
-	IMetamodListener *api; \
 	int mret = 0; \
 	void *val = NULL; \
-	for (PluginIter iter = g_PluginMngr._begin(); iter != g_PluginMngr._end(); iter++) { \
-		pl = (*iter); \
-		for (event=pl->m_Events.begin(); event!=pl->m_Events.end(); event++) { \
-			api = (*event); \
-			mret = META_IFACE_FAILED; \
-			if ( (val=api->On##nam##Query(iface, &mret)) != NULL ) { \
-				if (ret) *ret = mret; \
-				return val; \
-			} \
+	const IfaceResult *cached = g_Interfaces.FindCached(IfaceCache_##nam, iface); \
+	if (cached) { \
+		if (ret) *ret = cached->ret; \
+		return cached->ptr; \
+	} \
+	CPluginManager::ListenerIter listeners(&g_PluginMngr, CPluginManager::Event_On##nam##Query); \
+	while (const CPluginManager::CListener *listener = listeners.Next()) { \
+		mret = META_IFACE_FAILED; \
+		if ( (val=listener->api->On##nam##Query(iface, &mret)) != NULL ) { \
+			if (ret) *ret = mret; \
+			return val; \
 		} \
 	} \
-	return (orig)(iface, ret);
+	mret = META_IFACE_FAILED; \
+	val = (orig)(iface, &mret); \
+	if (!val && listeners.IsEmpty()) g_Interfaces.AddCached(IfaceCache_##nam, iface, NULL, mret, 0); \
+	if (ret) *ret = mret; \
+	return val;
 
 #define ITER_EVENT(evn, args) \
-	CPluginManager::CPlugin *pl; \
-	std::list<IMetamodListener *>::iterator event; \
-	IMetamodListener *api; \
-	for (PluginIter iter = g_PluginMngr._begin(); iter != g_PluginMngr._end(); iter++) { \
-		pl = (*iter); \
-		for (event=pl->m_Events.begin(); event!=pl->m_Events.end(); event++) { \
-			api = (*event); \
-			api->evn args; \
-		} \
+	CPluginManager::ListenerIter listeners(&g_PluginMngr, CPluginManager::Event_##evn); \
+	while (const CPluginManager::CListener *listener = listeners.Next()) { \
+		listener->api->evn args; \
 	}
 
 /* Initialize everything here */
@@ -251,23 +261,18 @@ ServerFactory(const char *iface, int *ret)
 	IFACE_MACRO(gamedll_info.factory, GameDLL);
 }
 
-static int
-LoadPluginsFromFile(const char *filepath, int &skipped)
+static void
+ReadPluginsFromFile(const char *filepath, std::vector<plugin_entry_t> &plugins)
 {
 	FILE *fp;
-	int total = 0;
-	PluginId id;
-	bool already;
-
-	skipped = 0;
 
 	fp = fopen(filepath, "rt");
 	if (!fp)
 	{
-		return 0;
+		return;
 	}
 
-	char buffer[255], error[255], full_path[PATH_SIZE];
+	char buffer[255], full_path[PATH_SIZE];
 	const char *file;
 	size_t length;
 	while (!feof(fp) && fgets(buffer, sizeof(buffer), fp) != NULL)
@@ -333,22 +338,13 @@ LoadPluginsFromFile(const char *filepath, int &skipped)
 
 		g_Metamod.GetFullPluginPath(file, full_path, sizeof(full_path));
 
-		id = g_PluginMngr.Load(full_path, Pl_File, already, error, sizeof(error));
-		if (id < Pl_MinId || g_PluginMngr.FindById(id)->m_Status < Pl_Paused)
-		{
-			mm_LogMessage("[META] Failed to load plugin %s.  %s", buffer, error);
-		}
-		else
-		{
-			if (already)
-				skipped++;
-			else
-				total++;
-		}
+		plugin_entry_t entry;
+		entry.path = full_path;
+		entry.name = buffer;
+		entry.vdf = false;
+		plugins.push_back(entry);
 	}
 	fclose(fp);
-	
-	return total;
 }
 
 void InitializeVSP()
@@ -505,6 +501,17 @@ mm_StartupMetamod(bool is_vsp_load)
 	
 	g_bIsVspBridged = is_vsp_load;
 
+#if !defined( _WIN64 )
+	/* Opt-in (+mm_specializehooks 1): hook funcs are regenerated for the hooks they currently call */
+	if (atoi(provider->GetCommandLineValue("mm_specializehooks", "0")) != 0)
+	{
+		g_SH_HookManagerAutoGen.EnableSpecialization();
+	}
+#endif
+
+	/* +mm_loadtimeline <file>: the load timings of all plugins are written there once they're loaded */
+	g_PluginMngr.SetLoadTimelineFile(provider->GetCommandLineValue("mm_loadtimeline", NULL));
+
 	if (!is_vsp_load)
 	{
 		DoInitialPluginLoads();
@@ -522,6 +529,16 @@ mm_InitializeGlobals(CreateInterfaceFn engineFactory,
 	physics_factory = physicsFactory;
 	filesystem_factory = filesystemFactory;
 	gpGlobals = pGlobals;
+
+	/* Ours are looked up like the ones plugins publish */
+	g_Interfaces.Register(0, MMIFACE_SOURCEHOOK, static_cast<SourceHook::ISourceHook *>(&g_SourceHook));
+	g_Interfaces.Register(0, MMIFACE_PLMANAGER, static_cast<ISmmPluginManager *>(&g_PluginMngr));
+#if !defined( _WIN64 )
+	g_Interfaces.Register(0, MMIFACE_SH_HOOKMANAUTOGEN,
+		static_cast<SourceHook::IHookManagerAutoGen *>(&g_SH_HookManagerAutoGen));
+#endif
+	g_Interfaces.InvalidateCaches();
+
 	provider->Notify_DLLInit_Pre(engineFactory, gamedll_info.factory);
 }
 
@@ -533,6 +550,9 @@ mm_UnloadMetamod()
 
 	provider->Notify_DLLShutdown_Pre();
 
+#if !defined( _WIN64 )
+	g_SH_HookManagerAutoGen.DisableSpecialization();
+#endif
 	g_SourceHook.CompleteShutdown();
 }
 
@@ -825,6 +845,88 @@ int MetamodSource::FormatIface(char iface[], size_t maxlength)
 	return num;
 }
 
+/**
+ * Only the engine's factories and our wrappers around them stay put for the
+ * whole session, so only what they answer can be remembered by address.
+ * A plugin's factory may be gone and its address reused after an unload.
+ */
+static bool IsKnownFactory(CreateInterfaceFn fn)
+{
+	return fn != NULL
+		&& (fn == engine_factory || fn == physics_factory || fn == filesystem_factory
+			|| fn == gamedll_info.factory || fn == EngineFactory || fn == PhysicsFactory
+			|| fn == FileSystemFactory || fn == ServerFactory);
+}
+
+/**
+ * Searches for a three digit versioned interface, starting at the given
+ * version. What an earlier search of the same factory and base name found
+ * out is reused: versions known to fail aren't asked for again, and if the
+ * version which answered is in range it's the only one asked.
+ */
+static void *VersionSearch(CreateInterfaceFn fn, char *iface, size_t baselen, int start, int last, int *ret)
+{
+	IfaceProbe probe;
+	const IfaceProbe *known = g_Interfaces.FindProbe((void *)fn, iface, baselen);
+
+	probe.from = start;
+	probe.to = start - 1;
+	probe.ptr = NULL;
+	probe.ret = META_IFACE_FAILED;
+
+	if (known != NULL && known->from <= start && start <= known->to)
+	{
+		if (known->ptr != NULL && known->to <= last)
+		{
+			/* Ask again for the version which answered: it may hand out a new instance */
+			int r = META_IFACE_FAILED;
+			snprintf(&iface[baselen], 4, "%03d", known->to);
+			void *ptr = fn(iface, &r);
+			if (ret)
+			{
+				*ret = ptr ? r : META_IFACE_FAILED;
+			}
+			return ptr;
+		}
+		if (known->ptr != NULL || known->to >= last)
+		{
+			if (ret)
+			{
+				*ret = META_IFACE_FAILED;
+			}
+			return NULL;
+		}
+
+		/* Everything up to known->to failed; carry on from there */
+		probe = *known;
+	}
+	else if (known != NULL && known->ptr == NULL && known->to == start - 1)
+	{
+		probe.from = known->from;
+	}
+
+	int r = META_IFACE_FAILED;
+	while (probe.to < last)
+	{
+		probe.to++;
+		snprintf(&iface[baselen], 4, "%03d", probe.to);
+		if ((probe.ptr = fn(iface, &r)) != NULL)
+		{
+			probe.ret = r;
+			break;
+		}
+	}
+
+	g_Interfaces.AddProbe((void *)fn, iface, baselen, probe);
+
+	if (ret)
+	{
+		*ret = probe.ptr ? probe.ret : r;
+	}
+
+	return probe.ptr;
+}
+
 void *MetamodSource::InterfaceSearch(CreateInterfaceFn fn, const char *iface, int max, int *ret)
 {
 	char _if[256];	/* assume no interface goes beyond this */
@@ -848,6 +950,22 @@ void *MetamodSource::InterfaceSearch(CreateInterfaceFn fn, const char *iface, in
 
 	strcpy(_if, iface);
 
+	/* The usual "Name###" can use what earlier searches of the same factory found out */
+	if (len > 3
+		&& isdigit(_if[len - 1]) && isdigit(_if[len - 2]) && isdigit(_if[len - 3])
+		&& !isdigit(_if[len - 4])
+		&& IsKnownFactory(fn))
+	{
+		/* Like the loop below: up to max + 1, but always start and the version after it */
+		int start = atoi(&_if[len - 3]);
+		int last = (max > start) ? max + 1 : start + 1;
+		if (last > 999)
+		{
+			last = 999;
+		}
+		return VersionSearch(fn, _if, len - 3, start, last, ret);
+	}
+
 	do
 	{
 		if ((pf = (fn)(_if, ret)) != NULL)
@@ -989,67 +1107,45 @@ void *MetamodSource::MetaFactory(const char *iface, int *ret, PluginId *id)
 		return NULL;
 	}
 
-	/* First check ours... we get first chance! */
-	if (strcmp(iface, MMIFACE_SOURCEHOOK) == 0)
+	/* Published interfaces (ours among them) come first, then misses from before */
+	const IfaceResult *found = g_Interfaces.FindPublished(iface);
+	if (!found)
 	{
-		if (ret)
-		{
-			*ret = META_IFACE_OK;
-		}
-		return static_cast<void *>(static_cast<SourceHook::ISourceHook *>(&g_SourceHook));
+		found = g_Interfaces.FindCached(IfaceCache_Meta, iface);
 	}
-	else if (strcmp(iface, MMIFACE_PLMANAGER) == 0)
+	if (found)
 	{
 		if (ret)
 		{
-			*ret = META_IFACE_OK;
+			*ret = found->ret;
 		}
-		return static_cast<void *>(static_cast<ISmmPluginManager *>(&g_PluginMngr));
-	}
-	else if (strcmp(iface, MMIFACE_SH_HOOKMANAUTOGEN) == 0)
-	{
-#if defined( _WIN64 ) || defined( __amd64__ )
-		if (ret)
-		{
-			*ret = META_IFACE_FAILED;
-		}
-		return nullptr;
-#else
-		if (ret)
+		if (id && found->ptr)
 		{
-			*ret = META_IFACE_OK;
+			*id = found->id;
 		}
-		return static_cast<void *>(static_cast<SourceHook::IHookManagerAutoGen *>(&g_SH_HookManagerAutoGen));
-#endif
+		return found->ptr;
 	}
 
-	CPluginManager::CPlugin *pl;
-	std::list<IMetamodListener *>::iterator event;
-	IMetamodListener *api;
+	CPluginManager::ListenerIter listeners(&g_PluginMngr, CPluginManager::Event_OnMetamodQuery);
+	const CPluginManager::CListener *listener;
 	void *value;
 	
 	int subret = 0;
-	for (PluginIter iter = g_PluginMngr._begin();
-		 iter != g_PluginMngr._end();
-		 iter++)
+	while ((listener = listeners.Next()) != NULL)
 	{
-		pl = (*iter);
-		for (event = pl->m_Events.begin(); event != pl->m_Events.end(); event++)
+		PluginId plid = listener->id;
+		subret = META_IFACE_FAILED;
+		if ((value = listener->api->OnMetamodQuery(iface, &subret)) != NULL)
 		{
-			api = (*event);
-			subret = META_IFACE_FAILED;
-			if ((value = api->OnMetamodQuery(iface, &subret)) != NULL)
+			if (ret)
 			{
-				if (ret)
-				{
-					*ret = subret;
-				}
-				if (id)
-				{
-					*id = pl->m_Id;
-				}
-				return value;
+				*ret = subret;
+			}
+			if (id)
+			{
+				*id = plid;
 			}
+			return value;
 		}
 	}
 
@@ -1058,6 +1154,11 @@ void *MetamodSource::MetaFactory(const char *iface, int *ret, PluginId *id)
 		*ret = META_IFACE_FAILED;
 	}
 
+	/* Listeners may hand out a new instance per call, or know the interface by the next one */
+	if (listeners.IsEmpty())
+	{
+		g_Interfaces.AddCached(IfaceCache_Meta, iface, NULL, META_IFACE_FAILED, 0);
+	}
 	return NULL;
 }
 
@@ -1066,6 +1167,32 @@ void MetamodSource::AddListener(ISmmPlugin *plugin, IMetamodListener *pListener)
 	CPluginManager::CPlugin *pl = g_PluginMngr.FindByAPI(plugin);
 
 	pl->m_Events.push_back(pListener);
+	g_PluginMngr.InvalidateListeners();
+
+	/* It may answer queries which have failed so far */
+	g_Interfaces.InvalidateCaches();
+}
+
+bool MetamodSource::RegisterInterface(ISmmPlugin *plugin, const char *iface, void *ptr)
+{
+	CPluginManager::CPlugin *pl = g_PluginMngr.FindByAPI(plugin);
+
+	if (!pl)
+	{
+		return false;
+	}
+
+	return g_Interfaces.Register(pl->m_Id, iface, ptr);
+}
+
+void MetamodSource::UnregisterInterface(ISmmPlugin *plugin, const char *iface)
+{
+	CPluginManager::CPlugin *pl = g_PluginMngr.FindByAPI(plugin);
+
+	if (pl)
+	{
+		g_Interfaces.Unregister(pl->m_Id, iface);
+	}
 }
 
 const char *MetamodSource::GetGameBinaryPath()
@@ -1119,13 +1246,12 @@ void MetamodSource::UnregisterConCommandBase(ISmmPlugin *plugin, ConCommandBase
 
 void MetamodSource::UnregisterConCommandBase(PluginId id, ConCommandBase *pCommand)
 {
-	PluginIter iter;
+	CPluginManager::ListenerIter listeners(&g_PluginMngr, CPluginManager::Event_OnUnlinkConCommandBase);
+	const CPluginManager::CListener *listener;
 	CPluginManager::CPlugin *pPlugin;
-	std::list<IMetamodListener *>::iterator event;
-	IMetamodListener *pML;
-	for (iter=g_PluginMngr._begin(); iter!=g_PluginMngr._end(); iter++)
+	while ((listener = listeners.Next()) != NULL)
 	{
-		pPlugin = (*iter);
+		pPlugin = listener->pl;
 		if (pPlugin->m_Status < Pl_Paused)
 		{
 			continue;
@@ -1135,13 +1261,7 @@ void MetamodSource::UnregisterConCommandBase(PluginId id, ConCommandBase *pComma
 		{
 			continue;
 		}
-		for (event=pPlugin->m_Events.begin();
-			event!=pPlugin->m_Events.end();
-			event++)
-		{
-			pML = (*event);
-			pML->OnUnlinkConCommandBase(id, pCommand);
-		}
+		listener->api->OnUnlinkConCommandBase(id, pCommand);
 	}
 
 	return provider->UnregisterConCommandBase(pCommand);
@@ -1223,6 +1343,7 @@ void MetamodSource::SetGameDLLInfo(CreateInterfaceFn serverFactory, int version,
 	gamedll_info.factory = serverFactory;
 	gamedll_version = version;
 	is_gamedll_loaded = loaded;
+	g_Interfaces.InvalidateCaches();
 }
 
 void MetamodSource::SetVSPListener(const char *path)
@@ -1280,17 +1401,14 @@ size_t MetamodSource::GetFullPluginPath(const char *plugin, char *buffer, size_t
 	return num;
 }
 
-static bool
-ProcessVDF(const char *path, bool &skipped)
+static void
+ProcessVDF(const char *path, std::vector<plugin_entry_t> &plugins)
 {
-	PluginId id;
-	bool already;
-	char alias[24], file[255], full_path[255], error[255];
+	char alias[24], file[255], full_path[255];
 
 	if (!provider->ProcessVDF(path, file, sizeof(file), alias, sizeof(alias)))
 	{
-		skipped = false;
-		return false;
+		return;
 	}
 
 	if (alias[0] != '\0')
@@ -1298,27 +1416,19 @@ ProcessVDF(const char *path, bool &skipped)
 
 	g_Metamod.GetFullPluginPath(file, full_path, sizeof(full_path));
 
-	id = g_PluginMngr.Load(full_path, Pl_File, already, error, sizeof(error));
-	skipped = already;
-	if (id < Pl_MinId || g_PluginMngr.FindById(id)->m_Status < Pl_Paused)
-	{
-		mm_LogMessage("[META] Failed to load plugin %s: %s", file, error);
-		return false;
-	}
-
-	return true;
+	plugin_entry_t entry;
+	entry.path = full_path;
+	entry.name = file;
+	entry.vdf = true;
+	plugins.push_back(entry);
 }
 
-static int
-LoadVDFPluginsFromDir(const char *dir, int &skipped)
+static void
+ReadVDFPluginsFromDir(const char *dir, std::vector<plugin_entry_t> &plugins)
 {
-	bool success, skip;
-	int total = 0;
 	char path[MAX_PATH];
 	char relpath[MAX_PATH * 2];
 
-	skipped = 0;
-
 #if defined _MSC_VER
 	HANDLE hFind;
 	WIN32_FIND_DATA fd;
@@ -1329,7 +1439,7 @@ LoadVDFPluginsFromDir(const char *dir, int &skipped)
 	{
 		DWORD dw = GetLastError();
 		if (dw == ERROR_FILE_NOT_FOUND)
-			return 0;
+			return;
 
 		FormatMessage(FORMAT_MESSAGE_FROM_SYSTEM|FORMAT_MESSAGE_IGNORE_INSERTS,
 			NULL,
@@ -1339,18 +1449,14 @@ LoadVDFPluginsFromDir(const char *dir, int &skipped)
 			sizeof(error),
 			NULL);
 		mm_LogMessage("[META] Could not open folder \"%s\" (%s)", dir, error);
-		return 0;
+		return;
 	}
 
 	do
 	{
 		g_Metamod.PathFormat(path, sizeof(path), "%s\\%s", dir, fd.cFileName);
 		UTIL_Relatize(relpath, sizeof(relpath), mod_path.c_str(), path);
-		success = ProcessVDF(relpath, skip);
-		if (skip)
-			skipped++;
-		else if (success)
-			total++;
+		ProcessVDF(relpath, plugins);
 	} while (FindNextFile(hFind, &fd));
 
 	FindClose(hFind);
@@ -1362,7 +1468,7 @@ LoadVDFPluginsFromDir(const char *dir, int &skipped)
 	if ((pDir = opendir(dir)) == NULL)
 	{
 		mm_LogMessage("[META] Could not open folder \"%s\" (%s)", dir, strerror(errno));
-		return 0;
+		return;
 	}
 
 	while ((pEnt = readdir(pDir)) != NULL)
@@ -1379,28 +1485,57 @@ LoadVDFPluginsFromDir(const char *dir, int &skipped)
 		}
 		g_Metamod.PathFormat(path, sizeof(path), "%s/%s", dir, pEnt->d_name);
 		UTIL_Relatize(relpath, sizeof(relpath), mod_path.c_str(), path);
-		success = ProcessVDF(relpath, skip);
-		if (skip)
-			skipped++;
-		else if (success)
-			total++;
+		ProcessVDF(relpath, plugins);
 	}
 
 	closedir(pDir);
 #endif
-
-	return total;
 }
 
 int
 mm_LoadPlugins(const char *filepath, const char *vdfpath)
 {
-	int total, skipped, fskipped, vskipped;
+	int total = 0, skipped = 0;
 	const char *s = "";
+	std::vector<plugin_entry_t> plugins;
+	std::vector<std::string> files;
+	PluginId id;
+	bool already;
+	char error[255];
+
+	ReadPluginsFromFile(filepath, plugins);
+	ReadVDFPluginsFromDir(vdfpath, plugins);
+
+	/* Read all binaries at once in the background, while the plugins load one by one in list order */
+	for (size_t i = 0; i < plugins.size(); i++)
+	{
+		files.push_back(plugins[i].path);
+	}
+	g_PluginMngr.Preload(files);
+
+	for (size_t i = 0; i < plugins.size(); i++)
+	{
+		const plugin_entry_t &entry = plugins[i];
+
+		id = g_PluginMngr.Load(entry.path.c_str(), Pl_File, already, error, sizeof(error));
+		if (id < Pl_MinId || g_PluginMngr.FindById(id)->m_Status < Pl_Paused)
+		{
+			if (entry.vdf)
+				mm_LogMessage("[META] Failed to load plugin %s: %s", entry.name.c_str(), error);
+			else
+				mm_LogMessage("[META] Failed to load plugin %s.  %s", entry.name.c_str(), error);
+		}
+		else if (already)
+		{
+			skipped++;
+		}
+		else
+		{
+			total++;
+		}
+	}
 
-	total = LoadPluginsFromFile(filepath, fskipped);
-	total += LoadVDFPluginsFromDir(vdfpath, vskipped);
-	skipped = fskipped + vskipped;
+	g_PluginMngr.FinishPreload();
 
 	if (total == 0 || total > 1)
 		s = "s";
@@ -49,7 +49,7 @@ using namespace SourceMM;
 #define SOURCEMM_VERSION	SVN_FILE_VERSION_STRING
 #define SOURCEMM_DATE		__DATE__
 #define METAMOD_API_MAJOR	2		/* increase this on a breaking change */
-#define METAMOD_API_MINOR	0		/* increase this on a non-breaking API change */
+#define METAMOD_API_MINOR	1		/* increase this on a non-breaking API change */
 
 class MetamodSource : public ISmmAPI
 {
@@ -92,6 +92,8 @@ public:
 	IServerPluginCallbacks *GetVSPInfo(int *pVersion);
 	size_t Format(char *buffer, size_t maxlength, const char *format, ...);
 	size_t FormatArgs(char *buffer, size_t maxlength, const char *format, va_list ap);
+	bool RegisterInterface(ISmmPlugin *plugin, const char *iface, void *ptr);
+	void UnregisterInterface(ISmmPlugin *plugin, const char *iface);
 public:
 	bool IsLoadedAsGameDLL();
 	const char *GetGameBinaryPath();
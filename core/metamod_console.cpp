@@ -100,6 +100,42 @@ static void ReplyVersion(edict_t *client = nullptr)
 	CMDMSG(client, "    http://www.metamodsource.net/\n");
 }
 
+#define PROFILE_TOP_HOOKS	20
+
+static void ReplyHookProfile(bool filter, int id)
+{
+	using SourceHook::Impl::CHookProfiler;
+
+	const CHookProfiler &profiler = g_SourceHook.GetProfiler();
+	SourceHook::CVector<CHookProfiler::Stats> top;
+	profiler.GetTopHooks(top, PROFILE_TOP_HOOKS, filter, id);
+
+	CONMSG("Hook profile (%s, %.1f s), top %d hooks by total time:\n",
+		profiler.IsRunning() ? "running" : "stopped", profiler.GetDuration() / 1e9, PROFILE_TOP_HOOKS);
+
+	if (top.empty())
+	{
+		CONMSG("  No hook calls recorded.\n");
+		return;
+	}
+
+	CONMSG("  %-6s %-6s %-9s %12s %12s %10s %10s %10s %10s\n",
+		"Hook", "Plugin", "Vfn", "Calls", "Total(ms)", "Avg(us)", "Max(us)", "p50(us)", "p99(us)");
+	for (size_t i = 0; i < top.size(); ++i)
+	{
+		const CHookProfiler::Stats &stats = top[i];
+		char vfn[16];
+		UTIL_Format(vfn, sizeof(vfn), "%d%s", stats.vtbl_idx, stats.post ? " post" : "");
+		CONMSG("  %-6d %-6d %-9s %12llu %12.3f %10.3f %10.3f %10.3f %10.3f\n",
+			stats.hookid, stats.plug, vfn, stats.calls,
+			stats.totalTime / 1e6,
+			stats.totalTime / 1e3 / stats.calls,
+			stats.maxTime / 1e3,
+			CHookProfiler::GetPercentile(stats, 50) / 1e3,
+			CHookProfiler::GetPercentile(stats, 99) / 1e3);
+	}
+}
+
 bool Command_Meta(IMetamodSourceCommandInfo *info)
 {
 	unsigned int args = info->GetArgCount();
@@ -186,6 +222,7 @@ bool Command_Meta(IMetamodSourceCommandInfo *info)
 			char buffer[256];
 			size_t len;
 			int plnum = g_PluginMngr.GetPluginCount();
+			bool timings = (args >= 2 && strcmp(info->GetArg(2), "-t") == 0);
 
 			if (!plnum)
 			{
@@ -195,6 +232,12 @@ bool Command_Meta(IMetamodSourceCommandInfo *info)
 				CONMSG("Listing %d plugin%s:\n", plnum, (plnum > 1) ? "s" : "");
 			}
 
+			if (timings)
+			{
+				CONMSG("  %-4s %10s %10s %10s %10s %10s  %s\n",
+					"Id", "Open(ms)", "Create(ms)", "Load(ms)", "AllLd(ms)", "Total(ms)", "File");
+			}
+
 			for (i = g_PluginMngr._begin(); i != g_PluginMngr._end(); i++)
 			{
 				pl = (*i);
@@ -205,6 +248,18 @@ bool Command_Meta(IMetamodSourceCommandInfo *info)
 
 				len = 0;
 
+				if (timings)
+				{
+					CONMSG("  [%02d] %10.3f %10.3f %10.3f %10.3f %10.3f  %s\n", pl->m_Id,
+						pl->m_LoadTimes[CPluginManager::CPlugin::LoadPhase_Open] / 1e6,
+						pl->m_LoadTimes[CPluginManager::CPlugin::LoadPhase_Create] / 1e6,
+						pl->m_LoadTimes[CPluginManager::CPlugin::LoadPhase_Load] / 1e6,
+						pl->m_LoadTimes[CPluginManager::CPlugin::LoadPhase_AllLoaded] / 1e6,
+						pl->GetLoadTime() / 1e6,
+						pl->m_File.c_str());
+					continue;
+				}
+
 				if (pl->m_Status != Pl_Running)
 				{
 					len += UTIL_Format(buffer, sizeof(buffer), "  [%02d] <%s>", pl->m_Id, g_PluginMngr.GetStatusText(pl));
@@ -352,7 +407,13 @@ bool Command_Meta(IMetamodSourceCommandInfo *info)
 					CONMSG("  URL: %s\n", pl->m_API->GetURL());
 					CONMSG("  Details: API %03d, Date: %s\n", pl->m_API->GetApiVersion(), pl->m_API->GetDate());
 				}
-				CONMSG("File: %s\n\n", pl->m_File.c_str());
+				CONMSG("File: %s\n", pl->m_File.c_str());
+				CONMSG("Load time: %.3f ms (open %.3f, create %.3f, load %.3f, all loaded %.3f)\n\n",
+					pl->GetLoadTime() / 1e6,
+					pl->m_LoadTimes[CPluginManager::CPlugin::LoadPhase_Open] / 1e6,
+					pl->m_LoadTimes[CPluginManager::CPlugin::LoadPhase_Create] / 1e6,
+					pl->m_LoadTimes[CPluginManager::CPlugin::LoadPhase_Load] / 1e6,
+					pl->m_LoadTimes[CPluginManager::CPlugin::LoadPhase_AllLoaded] / 1e6);
 
 				return true;
 			}
@@ -631,6 +692,56 @@ bool Command_Meta(IMetamodSourceCommandInfo *info)
 				return true;
 			}
 		}
+		else if (strcmp(command, "profile") == 0)
+		{
+			const char *subcmd = (args >= 2) ? info->GetArg(2) : "";
+			if (strcmp(subcmd, "start") == 0)
+			{
+				g_SourceHook.StartProfiling();
+				CONMSG("Hook profiling started.\n");
+
+				return true;
+			}
+			else if (strcmp(subcmd, "stop") == 0)
+			{
+				if (!g_SourceHook.IsProfiling())
+				{
+					CONMSG("Hook profiling is not running.\n");
+					return true;
+				}
+
+				g_SourceHook.StopProfiling();
+				CONMSG("Hook profiling stopped.\n");
+
+				return true;
+			}
+			else if (strcmp(subcmd, "dump") == 0)
+			{
+				bool filter = false;
+				int id = 0;
+				if (args >= 3)
+				{
+					id = atoi(info->GetArg(3));
+					if (!g_PluginMngr.FindById(id))
+					{
+						CONMSG("Plugin %d not found.\n", id);
+						return true;
+					}
+					filter = true;
+				}
+
+				ReplyHookProfile(filter, id);
+
+				return true;
+			}
+
+			CONMSG("Usage: meta profile <start|stop|dump> [id]\n");
+			CONMSG("  start        - Start counting and timing the calls of all hooks\n");
+			CONMSG("  stop         - Stop profiling, keeping the results\n");
+			CONMSG("  dump [id]    - Show the most expensive hooks, optionally of one plugin\n");
+
+			return true;
+		}
 	}
 
 	CONMSG("Metamod:Source Menu\n");
@@ -643,9 +754,10 @@ bool Command_Meta(IMetamodSourceCommandInfo *info)
 	CONMSG("  force_unload - Forcefully unload a plugin\n");
 	CONMSG("  game         - Information about GameDLL\n");
 	CONMSG("  info         - Information about a plugin\n");
-	CONMSG("  list         - List plugins\n");
+	CONMSG("  list [-t]    - List plugins, or their load times\n");
 	CONMSG("  load         - Load a plugin\n");
 	CONMSG("  pause        - Pause a running plugin\n");
+	CONMSG("  profile      - Profile the hooks of plugins\n");
 	CONMSG("  refresh      - Reparse plugin files\n");
 	CONMSG("  retry        - Attempt to reload a plugin\n");
 	CONMSG("  unload       - Unload a loaded plugin\n");
@@ -0,0 +1,144 @@
+/**
+ * vim: set ts=4 :
+ * ======================================================
+ * Metamod:Source
+ * Copyright (C) 2004-2010 AlliedModders LLC and authors.
+ * All rights reserved.
+ * ======================================================
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software in a
+ * product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <ISmmPlugin.h>
+#include "metamod_interfaces.h"
+
+/**
+ * @brief Implementation of the interface registry
+ * @file metamod_interfaces.cpp
+ */
+
+/* Version probing (InterfaceSearch) caches up to 1000 misses per name; don't grow forever */
+#define IFACE_MAX_CACHED	4096
+
+CInterfaceRegistry g_Interfaces;
+
+bool CInterfaceRegistry::Register(PluginId id, const char *name, void *ptr)
+{
+	if (name == NULL || ptr == NULL)
+	{
+		return false;
+	}
+
+	IfaceResult result;
+	result.ptr = ptr;
+	result.ret = META_IFACE_OK;
+	result.id = id;
+
+	return m_Published.emplace(name, result).second;
+}
+
+bool CInterfaceRegistry::Unregister(PluginId id, const char *name)
+{
+	IfaceMap::iterator iter = m_Published.find(std::string_view(name));
+	if (iter == m_Published.end() || iter->second.id != id)
+	{
+		return false;
+	}
+
+	m_Published.erase(iter);
+	return true;
+}
+
+void CInterfaceRegistry::RemovePlugin(PluginId id)
+{
+	IfaceMap::iterator iter = m_Published.begin();
+	while (iter != m_Published.end())
+	{
+		if (iter->second.id == id)
+		{
+			iter = m_Published.erase(iter);
+		}
+		else
+		{
+			iter++;
+		}
+	}
+
+	InvalidateCaches();
+}
+
+const IfaceResult *CInterfaceRegistry::FindPublished(const char *name) const
+{
+	IfaceMap::const_iterator iter = m_Published.find(std::string_view(name));
+	return (iter == m_Published.end()) ? NULL : &iter->second;
+}
+
+const IfaceResult *CInterfaceRegistry::FindCached(IfaceCache cache, const char *name) const
+{
+	const IfaceMap &map = m_Cached[cache];
+	IfaceMap::const_iterator iter = map.find(std::string_view(name));
+	return (iter == map.end()) ? NULL : &iter->second;
+}
+
+void CInterfaceRegistry::AddCached(IfaceCache cache, const char *name, void *ptr, int ret, PluginId id)
+{
+	IfaceMap &map = m_Cached[cache];
+	if (map.size() >= IFACE_MAX_CACHED)
+	{
+		map.clear();
+	}
+
+	IfaceResult result;
+	result.ptr = ptr;
+	result.ret = ptr ? ret : META_IFACE_FAILED;
+	result.id = ptr ? id : 0;
+
+	map[name] = result;
+}
+
+std::string CInterfaceRegistry::ProbeKey(void *factory, const char *base, size_t baselen)
+{
+	std::string key(reinterpret_cast<const char *>(&factory), sizeof(factory));
+	key.append(base, baselen);
+	return key;
+}
+
+const IfaceProbe *CInterfaceRegistry::FindProbe(void *factory, const char *base, size_t baselen) const
+{
+	ProbeMap::const_iterator iter = m_Probes.find(ProbeKey(factory, base, baselen));
+	return (iter == m_Probes.end()) ? NULL : &iter->second;
+}
+
+void CInterfaceRegistry::AddProbe(void *factory, const char *base, size_t baselen, const IfaceProbe &probe)
+{
+	std::pair<ProbeMap::iterator, bool> res = m_Probes.emplace(ProbeKey(factory, base, baselen), probe);
+
+	/* The earlier a probe starts, the more searches it answers */
+	if (!res.second && probe.from <= res.first->second.from)
+	{
+		res.first->second = probe;
+	}
+}
+
+void CInterfaceRegistry::InvalidateCaches()
+{
+	for (int i = 0; i < IfaceCache_Total; i++)
+	{
+		m_Cached[i].clear();
+	}
+	m_Probes.clear();
+}
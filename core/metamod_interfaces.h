@@ -0,0 +1,152 @@
+/**
+ * vim: set ts=4 :
+ * ======================================================
+ * Metamod:Source
+ * Copyright (C) 2004-2010 AlliedModders LLC and authors.
+ * All rights reserved.
+ * ======================================================
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software in a
+ * product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _INCLUDE_METAMOD_INTERFACES_H_
+#define _INCLUDE_METAMOD_INTERFACES_H_
+
+/**
+ * @brief Interface registry and lookup caches
+ * @file metamod_interfaces.h
+ */
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <functional>
+#include <IPluginManager.h>
+
+/**
+ * @brief Factories whose lookups are cached.
+ */
+enum IfaceCache
+{
+	IfaceCache_Meta,			/**< MetaFactory() */
+	IfaceCache_Engine,			/**< Synthetic factories: misses of the real factory */
+	IfaceCache_Physics,
+	IfaceCache_FileSystem,
+	IfaceCache_GameDLL,
+	IfaceCache_Total
+};
+
+struct IfaceResult
+{
+	void *ptr;					/**< NULL for a cached miss */
+	int ret;					/**< META_IFACE_OK / META_IFACE_FAILED */
+	PluginId id;				/**< Plugin which answered, 0 for Metamod:Source or the real factory */
+};
+
+/**
+ * @brief What InterfaceSearch() found out about the versions of a base name.
+ */
+struct IfaceProbe
+{
+	int from;					/**< Versions from..to have been asked for; */
+	int to;						/**< all of them failed, except for to if ptr is set */
+	void *ptr;
+	int ret;
+};
+
+/**
+ * @brief Interfaces published by name (ISmmAPI::RegisterInterface), and the
+ * results of the lookups which have to ask every plugin.
+ *
+ * Only misses are cached, and only while no listener answers the query:
+ * listeners may hand out a new instance per call. Cached misses stay valid
+ * until a plugin is unloaded or a listener is added; then all of them are
+ * thrown away. Loading a plugin changes nothing by itself: its answers come
+ * from listeners, and published interfaces are looked up before the caches.
+ */
+class CInterfaceRegistry
+{
+public:
+	/**
+	 * @brief Publishes an interface. Fails if the name is taken.
+	 */
+	bool Register(PluginId id, const char *name, void *ptr);
+
+	/**
+	 * @brief Removes an interface published by the plugin.
+	 */
+	bool Unregister(PluginId id, const char *name);
+
+	/**
+	 * @brief Removes everything the plugin has published and invalidates
+	 * the caches.
+	 */
+	void RemovePlugin(PluginId id);
+
+	/**
+	 * @brief Returns a published interface, or NULL.
+	 */
+	const IfaceResult *FindPublished(const char *name) const;
+
+	/**
+	 * @brief Returns the cached result of an earlier lookup, or NULL if
+	 * the factory has to be asked.
+	 */
+	const IfaceResult *FindCached(IfaceCache cache, const char *name) const;
+
+	void AddCached(IfaceCache cache, const char *name, void *ptr, int ret, PluginId id);
+
+	/**
+	 * @brief Returns what is known about the versions of an interface
+	 * (base name without the version digits) in a factory, or NULL.
+	 */
+	const IfaceProbe *FindProbe(void *factory, const char *base, size_t baselen) const;
+
+	/**
+	 * @brief Stores the outcome of a version probe. A probe which starts at a
+	 * later version than the stored one doesn't replace it.
+	 */
+	void AddProbe(void *factory, const char *base, size_t baselen, const IfaceProbe &probe);
+
+	/**
+	 * @brief Forgets all cached results.
+	 */
+	void InvalidateCaches();
+private:
+	/* Lookups by const char * don't have to build a std::string */
+	struct NameHash
+	{
+		typedef void is_transparent;
+		size_t operator()(std::string_view name) const
+		{
+			return std::hash<std::string_view>()(name);
+		}
+	};
+	typedef std::unordered_map<std::string, IfaceResult, NameHash, std::equal_to<> > IfaceMap;
+
+	/* Factory address followed by the base name */
+	typedef std::unordered_map<std::string, IfaceProbe> ProbeMap;
+	static std::string ProbeKey(void *factory, const char *base, size_t baselen);
+
+	IfaceMap m_Published;
+	IfaceMap m_Cached[IfaceCache_Total];
+	ProbeMap m_Probes;
+};
+
+extern CInterfaceRegistry g_Interfaces;
+
+#endif //_INCLUDE_METAMOD_INTERFACES_H_
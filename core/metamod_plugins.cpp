@@ -27,6 +27,7 @@
 #include "metamod_oslink.h"
 #include "metamod.h"
 #include "metamod_plugins.h"
+#include "metamod_interfaces.h"
 #include "metamod_util.h"
 
 /** 
@@ -36,19 +37,148 @@
 
 using namespace SourceMM;
 
+/* Reading plugins waits on the disk, not the CPU; a few more threads than cores are fine */
+#define MAX_PRELOAD_THREADS		8
+
+/* Nanoseconds, for the load timings of plugins */
+static inline unsigned long long LoadClock()
+{
+	return SourceHook::Impl::CHookProfiler::Now();
+}
+
 #define ITER_PLEVENT(evn, plid) \
-	CPluginManager::CPlugin *_Xpl; \
-	std::list<IMetamodListener *>::iterator event; \
-	IMetamodListener *api; \
-	for (PluginIter iter = g_PluginMngr._begin(); iter != g_PluginMngr._end(); iter++) { \
-		_Xpl = (*iter); \
-		if (_Xpl->m_Id == plid) \
-			continue; \
-		for (event=_Xpl->m_Events.begin(); event!=_Xpl->m_Events.end(); event++) { \
-			api = (*event); \
-			api->evn(plid); \
-		} \
+	CPluginManager::ListenerIter _Xlisteners(&g_PluginMngr, CPluginManager::Event_##evn); \
+	while (const CPluginManager::CListener *_Xlistener = _Xlisteners.Next()) { \
+		if (_Xlistener->id != plid) \
+			_Xlistener->api->evn(plid); \
+	}
+
+/* Unused callbacks of listeners point here, or to a copy of it in the plugin */
+static IMetamodListener s_DefaultListener;
+
+#if defined __i386__ || defined _M_IX86 || defined __x86_64__ || defined _M_X64
+/* Skips what compilers and linkers may put in front of the body of a function */
+static unsigned char *SkipFunctionStub(void *func)
+{
+	unsigned char *code = reinterpret_cast<unsigned char *>(func);
+
+	/* Incremental linking puts a jmp rel32 in front of every function */
+	if (code[0] == 0xE9)
+	{
+		code += 5 + *reinterpret_cast<int *>(code + 1);
+	}
+
+	/* endbr32 / endbr64 */
+	if (code[0] == 0xF3 && code[1] == 0x0F && code[2] == 0x1E && (code[3] == 0xFB || code[3] == 0xFA))
+	{
+		code += 4;
+	}
+
+	return code;
+}
+#endif
+
+/**
+ * The defaults of IMetamodListener are inline, so a plugin has its own copies
+ * of them; those are recognized by being empty. A plugin's own empty override
+ * is skipped as well, which changes nothing since it wouldn't do anything.
+ */
+static bool IsEmptyFunction(void *func)
+{
+#if defined __i386__ || defined _M_IX86 || defined __x86_64__ || defined _M_X64
+	unsigned char *code = SkipFunctionStub(func);
+
+	/* repz ret */
+	if (code[0] == 0xF3 && code[1] == 0xC3)
+	{
+		code++;
+	}
+
+	/* ret / ret imm16 */
+	return code[0] == 0xC3 || code[0] == 0xC2;
+#else
+	return false;
+#endif
+}
+
+/**
+ * The query defaults aren't empty: they store META_IFACE_FAILED and return
+ * NULL. A plugin's copy is recognized by having the same code as ours, which
+ * it does when built by a similar compiler. The bodies are short, have a single
+ * ret at the end and don't refer to anything outside themselves, so the same
+ * bytes up to the ret do the same thing.
+ */
+static bool IsSameFunction(void *func, void *base)
+{
+#if defined __i386__ || defined _M_IX86 || defined __x86_64__ || defined _M_X64
+	unsigned char *code = SkipFunctionStub(func);
+	unsigned char *basecode = SkipFunctionStub(base);
+
+	for (size_t i = 0; i < 64; i++)
+	{
+		if (code[i] != basecode[i])
+		{
+			return false;
+		}
+		if (basecode[i] == 0xC3)
+		{
+			return true;
+		}
+		if (basecode[i] == 0xC2)
+		{
+			return code[i + 1] == basecode[i + 1] && code[i + 2] == basecode[i + 2];
+		}
 	}
+#endif
+	return false;
+}
+
+template <class MFP>
+static bool Implements(IMetamodListener *api, MFP mfp)
+{
+	SourceHook::MemFuncInfo mfi;
+	SourceHook::GetFuncInfo(mfp, mfi);
+
+	void *func = (*reinterpret_cast<void ***>(api))[mfi.vtblindex];
+	void *base = (*reinterpret_cast<void ***>(&s_DefaultListener))[mfi.vtblindex];
+
+	return func != base && !IsEmptyFunction(func) && !IsSameFunction(func, base);
+}
+
+static bool Implements(IMetamodListener *api, CPluginManager::ListenerEvent event)
+{
+	switch (event)
+	{
+	case CPluginManager::Event_OnPluginLoad:
+		return Implements(api, &IMetamodListener::OnPluginLoad);
+	case CPluginManager::Event_OnPluginUnload:
+		return Implements(api, &IMetamodListener::OnPluginUnload);
+	case CPluginManager::Event_OnPluginPause:
+		return Implements(api, &IMetamodListener::OnPluginPause);
+	case CPluginManager::Event_OnPluginUnpause:
+		return Implements(api, &IMetamodListener::OnPluginUnpause);
+	case CPluginManager::Event_OnLevelInit:
+		return Implements(api, &IMetamodListener::OnLevelInit);
+	case CPluginManager::Event_OnLevelShutdown:
+		return Implements(api, &IMetamodListener::OnLevelShutdown);
+	case CPluginManager::Event_OnEngineQuery:
+		return Implements(api, &IMetamodListener::OnEngineQuery);
+	case CPluginManager::Event_OnPhysicsQuery:
+		return Implements(api, &IMetamodListener::OnPhysicsQuery);
+	case CPluginManager::Event_OnFileSystemQuery:
+		return Implements(api, &IMetamodListener::OnFileSystemQuery);
+	case CPluginManager::Event_OnGameDLLQuery:
+		return Implements(api, &IMetamodListener::OnGameDLLQuery);
+	case CPluginManager::Event_OnMetamodQuery:
+		return Implements(api, &IMetamodListener::OnMetamodQuery);
+	case CPluginManager::Event_OnVSPListening:
+		return Implements(api, &IMetamodListener::OnVSPListening);
+	case CPluginManager::Event_OnUnlinkConCommandBase:
+		return Implements(api, &IMetamodListener::OnUnlinkConCommandBase);
+	default:
+		return true;
+	}
+}
 
 CPluginManager g_PluginMngr;
 
@@ -68,18 +198,27 @@ CPluginManager::CPluginManager()
 {
 	m_LastId = Pl_MinId;
 	m_AllLoaded = false;
+	m_pListeners = new ListenerTable;
+	m_ListenerWalks = 0;
+	m_ListenersValid = false;
+	m_ListenersSerial = 0;
+	m_PreloadNext = 0;
 }
 
 CPluginManager::~CPluginManager()
 {
 	std::list<CNameAlias *>::iterator iter;
 
+	FinishPreload();
+
 	for (iter = m_Aliases.begin(); iter != m_Aliases.end(); iter++)
 	{
 		delete (*iter);
 	}
 
 	m_Aliases.clear();
+
+	delete m_pListeners;
 }
 
 const char *CPluginManager::LookupAlias(const char *alias)
@@ -144,9 +283,36 @@ void CPluginManager::SetAlias(const char *alias, const char *value)
 	}
 }
 
-CPluginManager::CPlugin::CPlugin() : m_Id(0), m_Source(0), m_API(NULL), m_Lib(NULL), m_UnloadFn(NULL)
+CPluginManager::CPlugin::CPlugin() : m_Id(0), m_Source(0), m_API(NULL), m_Lib(NULL), m_UnloadFn(NULL), m_LoadStart(0)
+{
+	memset(m_LoadTimes, 0, sizeof(m_LoadTimes));
+}
+
+const char *CPluginManager::CPlugin::GetLoadPhaseName(LoadPhase phase)
 {
+	switch (phase)
+	{
+	case LoadPhase_Open:
+		return "open";
+	case LoadPhase_Create:
+		return "create";
+	case LoadPhase_Load:
+		return "load";
+	case LoadPhase_AllLoaded:
+		return "allloaded";
+	default:
+		return "unknown";
+	}
+}
 
+unsigned long long CPluginManager::CPlugin::GetLoadTime() const
+{
+	unsigned long long total = 0;
+	for (int i = 0; i < LoadPhase_Total; i++)
+	{
+		total += m_LoadTimes[i];
+	}
+	return total;
 }
 
 PluginId CPluginManager::Load(const char *file, PluginId source, bool &already, char *error, size_t maxlen)
@@ -219,9 +385,184 @@ void CPluginManager::SetAllLoaded()
 			//API 4 is when we added this callback
 			//Min version is now 5, so we ignore this check
 			//if ( (*i)->m_API->GetApiVersion() >= 004 )
+			unsigned long long start = LoadClock();
 			(*i)->m_API->AllPluginsLoaded();
+			(*i)->m_LoadTimes[CPlugin::LoadPhase_AllLoaded] = LoadClock() - start;
+		}
+	}
+
+	WriteLoadTimeline();
+}
+
+CPluginManager::ListenerIter::ListenerIter(CPluginManager *mngr, ListenerEvent event)
+{
+	if (!mngr->m_ListenersValid)
+	{
+		mngr->BuildListeners();
+	}
+
+	m_Mngr = mngr;
+	m_List = &mngr->m_pListeners->events[event];
+	m_Pos = 0;
+	m_Serial = mngr->m_ListenersSerial;
+	mngr->m_ListenerWalks++;
+}
+
+CPluginManager::ListenerIter::~ListenerIter()
+{
+	if (--m_Mngr->m_ListenerWalks == 0)
+	{
+		for (size_t i = 0; i < m_Mngr->m_RetiredListeners.size(); i++)
+		{
+			delete m_Mngr->m_RetiredListeners[i];
+		}
+		m_Mngr->m_RetiredListeners.clear();
+	}
+}
+
+const CPluginManager::CListener *CPluginManager::ListenerIter::Next()
+{
+	while (m_Pos < m_List->size())
+	{
+		const CListener &listener = (*m_List)[m_Pos++];
+		if (m_Mngr->IsListening(m_Serial, listener))
+		{
+			return &listener;
+		}
+	}
+
+	return NULL;
+}
+
+bool CPluginManager::ListenerIter::IsEmpty() const
+{
+	return m_List->empty();
+}
+
+bool CPluginManager::IsListening(unsigned int serial, const CListener &listener)
+{
+	if (serial == m_ListenersSerial)
+	{
+		return true;
+	}
+
+	/* Something was loaded or unloaded by an earlier callback */
+	PluginIter i;
+	for (i=m_Plugins.begin(); i!=m_Plugins.end(); i++)
+	{
+		if ((*i) == listener.pl && (*i)->m_Id == listener.id)
+		{
+			std::list<IMetamodListener *>::iterator iter;
+			for (iter=(*i)->m_Events.begin(); iter!=(*i)->m_Events.end(); iter++)
+			{
+				if ((*iter) == listener.api)
+				{
+					return true;
+				}
+			}
+			return false;
 		}
 	}
+
+	return false;
+}
+
+void CPluginManager::InvalidateListeners()
+{
+	m_ListenersValid = false;
+	m_ListenersSerial++;
+}
+
+void CPluginManager::BuildListeners()
+{
+	if (m_ListenerWalks > 0)
+	{
+		/* A callback changed the listeners; the walks which are running keep the old lists */
+		m_RetiredListeners.push_back(m_pListeners);
+		m_pListeners = new ListenerTable;
+	}
+	else
+	{
+		for (int event = 0; event < Event_Total; event++)
+		{
+			m_pListeners->events[event].clear();
+		}
+	}
+
+	PluginIter i;
+	std::list<IMetamodListener *>::iterator iter;
+	for (i=m_Plugins.begin(); i!=m_Plugins.end(); i++)
+	{
+		for (iter=(*i)->m_Events.begin(); iter!=(*i)->m_Events.end(); iter++)
+		{
+			CListener listener;
+			listener.pl = (*i);
+			listener.id = (*i)->m_Id;
+			listener.api = (*iter);
+
+			for (int event = 0; event < Event_Total; event++)
+			{
+				if (Implements(listener.api, (ListenerEvent)event))
+				{
+					m_pListeners->events[event].push_back(listener);
+				}
+			}
+		}
+	}
+
+	m_ListenersValid = true;
+}
+
+void CPluginManager::SetLoadTimelineFile(const char *path)
+{
+	m_TimelineFile.assign(path ? path : "");
+}
+
+void CPluginManager::WriteLoadTimeline()
+{
+	if (m_TimelineFile.size() == 0)
+	{
+		return;
+	}
+
+	FILE *fp = fopen(m_TimelineFile.c_str(), "wt");
+	if (!fp)
+	{
+		mm_LogMessage("[META] Could not write load timeline to \"%s\"", m_TimelineFile.c_str());
+		return;
+	}
+
+	/* Offsets are from the first plugin which started loading */
+	unsigned long long first = 0;
+	PluginIter i;
+	for (i=m_Plugins.begin(); i!=m_Plugins.end(); i++)
+	{
+		if ((*i)->m_LoadStart && (!first || (*i)->m_LoadStart < first))
+		{
+			first = (*i)->m_LoadStart;
+		}
+	}
+
+	fprintf(fp, "id,status,start_ms");
+	for (int phase = 0; phase < CPlugin::LoadPhase_Total; phase++)
+	{
+		fprintf(fp, ",%s_ms", CPlugin::GetLoadPhaseName((CPlugin::LoadPhase)phase));
+	}
+	fprintf(fp, ",total_ms,file\n");
+
+	for (i=m_Plugins.begin(); i!=m_Plugins.end(); i++)
+	{
+		CPlugin *pl = (*i);
+		fprintf(fp, "%d,%s,%.3f", pl->m_Id, GetStatusText(pl),
+			pl->m_LoadStart ? (pl->m_LoadStart - first) / 1e6 : 0.0);
+		for (int phase = 0; phase < CPlugin::LoadPhase_Total; phase++)
+		{
+			fprintf(fp, ",%.3f", pl->m_LoadTimes[phase] / 1e6);
+		}
+		fprintf(fp, ",%.3f,\"%s\"\n", pl->GetLoadTime() / 1e6, pl->m_File.c_str());
+	}
+
+	fclose(fp);
 }
 
 bool CPluginManager::Pause(PluginId id, char *error, size_t maxlen)
@@ -383,7 +724,7 @@ const char *CPluginManager::GetStatusText(CPlugin *pl)
 	}
 }
 
-struct Unloader : public SourceHook::Impl::UnloadListener
+struct Unloader : public SourceHook::Impl::UnloadListener, public SourceHook::CSlabAllocated<Unloader>
 {
 	CPluginManager::CPlugin *plugin_;
 	bool destroy_;
@@ -413,9 +754,102 @@ struct Unloader : public SourceHook::Impl::UnloadListener
 	}
 };
 
-CPluginManager::CPlugin *CPluginManager::_Load(const char *file, PluginId source, char *error, size_t maxlen)
+static HINSTANCE OpenPluginLib(const char *file, Pl_Status &status, char *error, size_t maxlen)
 {
 	FILE *fp;
+	HINSTANCE lib;
+
+	//Check if the file even exists
+	fp = fopen(file, "r");
+	if (!fp)
+	{
+		if (error)
+		{
+			UTIL_Format(error, maxlen, "File not found: %s", file);
+		}
+		status = Pl_NotFound;
+		return NULL;
+	}
+
+	fclose(fp);
+
+	//Load the file
+	lib = dlmount(file);
+	if (!lib)
+	{
+		if (error)
+		{
+			UTIL_Format(error, maxlen, "%s", dlerror());
+		}
+		status = Pl_Error;
+	}
+
+	return lib;
+}
+
+/* Runs on the preload workers: only pulls the file into the OS file cache */
+static void WarmPluginFile(const char *file)
+{
+	FILE *fp = fopen(file, "rb");
+	if (!fp)
+	{
+		return;
+	}
+
+	char buf[65536];
+	while (fread(buf, 1, sizeof(buf), fp) == sizeof(buf))
+	{
+	}
+
+	fclose(fp);
+}
+
+void CPluginManager::Preload(const std::vector<std::string> &files)
+{
+	FinishPreload();
+
+	m_PreloadFiles = files;
+	m_PreloadNext = 0;
+
+	size_t count = std::thread::hardware_concurrency();
+	if (count < 2)
+	{
+		count = 2;
+	}
+	if (count > MAX_PRELOAD_THREADS)
+	{
+		count = MAX_PRELOAD_THREADS;
+	}
+	if (count > m_PreloadFiles.size())
+	{
+		count = m_PreloadFiles.size();
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		m_PreloadThreads.emplace_back([this]()
+		{
+			size_t i;
+			while ((i = m_PreloadNext++) < m_PreloadFiles.size())
+			{
+				WarmPluginFile(m_PreloadFiles[i].c_str());
+			}
+		});
+	}
+}
+
+void CPluginManager::FinishPreload()
+{
+	for (size_t i = 0; i < m_PreloadThreads.size(); i++)
+	{
+		m_PreloadThreads[i].join();
+	}
+	m_PreloadThreads.clear();
+	m_PreloadFiles.clear();
+}
+
+CPluginManager::CPlugin *CPluginManager::_Load(const char *file, PluginId source, char *error, size_t maxlen)
+{
 	CPlugin *pl;
 
 	pl = new CPlugin();
@@ -427,159 +861,146 @@ CPluginManager::CPlugin *CPluginManager::_Load(const char *file, PluginId source
 	m_Plugins.push_back(pl);
 	m_LastId++;
 
-	//Check if the file even exists
-	fp = fopen(file, "r");
-	if (!fp)
-	{
-		if (error)
-		{
-			UTIL_Format(error, maxlen, "File not found: %s", file);
-		}
-		pl->m_Status = Pl_NotFound;
-	}
+	//Open the file
+	pl->m_LoadStart = LoadClock();
+	pl->m_Lib = OpenPluginLib(file, pl->m_Status, error, maxlen);
+	pl->m_LoadTimes[CPlugin::LoadPhase_Open] = LoadClock() - pl->m_LoadStart;
 
-	if (fp)
+	if (pl->m_Lib)
 	{
-		fclose(fp);
-		fp = NULL;
+		unsigned long long start = LoadClock();
+		pl->m_API = NULL;
 		
-		//Load the file
-		pl->m_Lib = dlmount(file);
-		if (!pl->m_Lib)
+		/**
+		 * First, try the new "advanced" interface
+		 */
+		METAMOD_FN_LOAD fnLoad = (METAMOD_FN_LOAD)dlsym(pl->m_Lib, "CreateInterface_MMS");
+		if (fnLoad != NULL)
 		{
-			if (error)
+			if (GlobVersionInfo.source_engine == SOURCE_ENGINE_UNKNOWN)
 			{
-				UTIL_Format(error, maxlen, "%s", dlerror());
+				GlobVersionInfo.source_engine = g_Metamod.GetSourceEngineBuild();
 			}
-			pl->m_Status = Pl_Error;
-		}
-		else
-		{
-			pl->m_API = NULL;
-			
-			/**
-			 * First, try the new "advanced" interface
-			 */
-			METAMOD_FN_LOAD fnLoad = (METAMOD_FN_LOAD)dlsym(pl->m_Lib, "CreateInterface_MMS");
-			if (fnLoad != NULL)
+			if (GlobVersionInfo.game_dir == NULL)
 			{
-				if (GlobVersionInfo.source_engine == SOURCE_ENGINE_UNKNOWN)
-				{
-					GlobVersionInfo.source_engine = g_Metamod.GetSourceEngineBuild();
-				}
-				if (GlobVersionInfo.game_dir == NULL)
-				{
-					GlobVersionInfo.game_dir = strrchr(g_Metamod.GetBaseDir(), PATH_SEP_CHAR) + 1;
-				}
+				GlobVersionInfo.game_dir = strrchr(g_Metamod.GetBaseDir(), PATH_SEP_CHAR) + 1;
+			}
 
-				/* Build path information */
-				char file_path[256];
-				size_t len = g_Metamod.PathFormat(file_path, sizeof(file_path), "%s", file);
+			/* Build path information */
+			char file_path[256];
+			size_t len = g_Metamod.PathFormat(file_path, sizeof(file_path), "%s", file);
 
-				for (size_t i = len - 1; i < len; i--)
+			for (size_t i = len - 1; i < len; i--)
+			{
+				if (_IsPathSepChar(file_path[i]))
 				{
-					if (_IsPathSepChar(file_path[i]))
-					{
-						file_path[i] = '\0';
-						break;
-					}
+					file_path[i] = '\0';
+					break;
 				}
+			}
 
-				MetamodLoaderInfo info;
-				info.pl_file = file;
-				info.pl_path = file_path;
+			MetamodLoaderInfo info;
+			info.pl_file = file;
+			info.pl_path = file_path;
 
-				pl->m_API = fnLoad(&GlobVersionInfo, &info);
+			pl->m_API = fnLoad(&GlobVersionInfo, &info);
 #if SOURCE_ENGINE == SE_CSS || SOURCE_ENGINE == SE_HL2DM || SOURCE_ENGINE == SE_DODS || SOURCE_ENGINE == SE_TF2
-				/* For plugin compat - try loading again using original OB if OB-Valve has failed */
+			/* For plugin compat - try loading again using original OB if OB-Valve has failed */
+			if (pl->m_API == NULL)
+			{
+				GlobVersionInfo.source_engine = SOURCE_ENGINE_ORANGEBOXVALVE_DEPRECATED;
+				pl->m_API = fnLoad(&GlobVersionInfo, &info);
 				if (pl->m_API == NULL)
 				{
-					GlobVersionInfo.source_engine = SOURCE_ENGINE_ORANGEBOXVALVE_DEPRECATED;
+					GlobVersionInfo.source_engine = SOURCE_ENGINE_ORANGEBOX;
 					pl->m_API = fnLoad(&GlobVersionInfo, &info);
-					if (pl->m_API == NULL)
-					{
-						GlobVersionInfo.source_engine = SOURCE_ENGINE_ORANGEBOX;
-						pl->m_API = fnLoad(&GlobVersionInfo, &info);
-					}
-					GlobVersionInfo.source_engine = g_Metamod.GetSourceEngineBuild();
 				}
-#endif
-				pl->m_UnloadFn = (METAMOD_FN_UNLOAD)dlsym(pl->m_Lib, "UnloadInterface_MMS");
+				GlobVersionInfo.source_engine = g_Metamod.GetSourceEngineBuild();
 			}
+#endif
+			pl->m_UnloadFn = (METAMOD_FN_UNLOAD)dlsym(pl->m_Lib, "UnloadInterface_MMS");
+		}
 
-			/**
-			 * If we didn't get anything, try the normal/simple interface.
-			 */
-			if (pl->m_API == NULL)
+		/**
+		 * If we didn't get anything, try the normal/simple interface.
+		 */
+		if (pl->m_API == NULL)
+		{
+			CreateInterfaceFn pfn = (CreateInterfaceFn)(dlsym(pl->m_Lib, PL_EXPOSURE_C));
+			if (!pfn)
 			{
-				CreateInterfaceFn pfn = (CreateInterfaceFn)(dlsym(pl->m_Lib, PL_EXPOSURE_C));
-				if (!pfn)
+				if (error)
+				{
+					UTIL_Format(error, maxlen, "Function %s not found", PL_EXPOSURE_C);
+				}
+				pl->m_Status = Pl_Error;
+			}
+			else
+			{
+				pl->m_API = static_cast<ISmmPlugin *>((pfn)(METAMOD_PLAPI_NAME, NULL));
+
+				if (!pl->m_API)
 				{
 					if (error)
 					{
-						UTIL_Format(error, maxlen, "Function %s not found", PL_EXPOSURE_C);
+						UTIL_Format(error, maxlen, "Failed to get API");
 					}
 					pl->m_Status = Pl_Error;
 				}
-				else
-				{
-					pl->m_API = static_cast<ISmmPlugin *>((pfn)(METAMOD_PLAPI_NAME, NULL));
+			}
+		}
+
+		pl->m_LoadTimes[CPlugin::LoadPhase_Create] = LoadClock() - start;
 
-					if (!pl->m_API)
+		if (pl->m_API != NULL)
+		{
+			int api = pl->m_API->GetApiVersion();
+			if (api < PLAPI_MIN_VERSION)
+			{
+				if (error)
+				{
+					if (api == 13)
+					{
+						UTIL_Format(error, maxlen, "Plugin uses experimental Metamod build, probably 1.6.x (%d < %d)", api, PLAPI_MIN_VERSION);
+					}
+					else if (api <= 12 && api >= 7)
+					{
+						UTIL_Format(error, maxlen, "Older Metamod version required, probably 1.4.x (%d < %d)", api, PLAPI_MIN_VERSION);
+					}
+					else
 					{
-						if (error)
-						{
-							UTIL_Format(error, maxlen, "Failed to get API");
-						}
-						pl->m_Status = Pl_Error;
+						UTIL_Format(error, maxlen, "Older Metamod version required, probably 1.0 (%d < %d)", api, PLAPI_MIN_VERSION);
 					}
 				}
+				pl->m_Status = Pl_Error;
 			}
-
-			if (pl->m_API != NULL)
+			else if (api > METAMOD_PLAPI_VERSION)
 			{
-				int api = pl->m_API->GetApiVersion();
-				if (api < PLAPI_MIN_VERSION)
+				if (error)
 				{
-					if (error)
-					{
-						if (api == 13)
-						{
-							UTIL_Format(error, maxlen, "Plugin uses experimental Metamod build, probably 1.6.x (%d < %d)", api, PLAPI_MIN_VERSION);
-						}
-						else if (api <= 12 && api >= 7)
-						{
-							UTIL_Format(error, maxlen, "Older Metamod version required, probably 1.4.x (%d < %d)", api, PLAPI_MIN_VERSION);
-						}
-						else
-						{
-							UTIL_Format(error, maxlen, "Older Metamod version required, probably 1.0 (%d < %d)", api, PLAPI_MIN_VERSION);
-						}
-					}
-					pl->m_Status = Pl_Error;
+					UTIL_Format(error, maxlen, "Plugin requires newer Metamod version (%d > %d)", api, METAMOD_PLAPI_VERSION);
 				}
-				else if (api > METAMOD_PLAPI_VERSION)
+				pl->m_Status = Pl_Error;
+			}
+			else
+			{
+				start = LoadClock();
+				bool loaded = pl->m_API->Load(pl->m_Id, &g_Metamod, error, maxlen, m_AllLoaded);
+				pl->m_LoadTimes[CPlugin::LoadPhase_Load] = LoadClock() - start;
+
+				if (loaded)
 				{
-					if (error)
+					pl->m_Status = Pl_Running;
+					if (m_AllLoaded)
 					{
-						UTIL_Format(error, maxlen, "Plugin requires newer Metamod version (%d > %d)", api, METAMOD_PLAPI_VERSION);
+						start = LoadClock();
+						pl->m_API->AllPluginsLoaded();
+						pl->m_LoadTimes[CPlugin::LoadPhase_AllLoaded] = LoadClock() - start;
 					}
-					pl->m_Status = Pl_Error;
 				}
 				else
 				{
-					if (pl->m_API->Load(pl->m_Id, &g_Metamod, error, maxlen, m_AllLoaded))
-					{
-						pl->m_Status = Pl_Running;
-						if (m_AllLoaded)
-						{
-							pl->m_API->AllPluginsLoaded();
-						}
-					}
-					else
-					{
-						pl->m_Status = Pl_Refused;
-					}
+					pl->m_Status = Pl_Refused;
 				}
 			}
 		}
@@ -588,7 +1009,9 @@ CPluginManager::CPlugin *CPluginManager::_Load(const char *file, PluginId source
 	if (pl->m_Lib && (pl->m_Status < Pl_Paused))
 	{
 		pl->m_Events.clear();
+		InvalidateListeners();
 		UnregAllConCmds(pl);
+		g_Interfaces.RemovePlugin(pl->m_Id);
 		g_SourceHook.UnloadPlugin(pl->m_Id, new Unloader(pl, false));
 	}
 
@@ -608,7 +1031,9 @@ bool CPluginManager::_Unload(CPluginManager::CPlugin *pl, bool force, char *erro
 		if (pl->m_API->Unload(error, maxlen) || force)
 		{
 			pl->m_Events.clear();
+			InvalidateListeners();
 			UnregAllConCmds(pl);
+			g_Interfaces.RemovePlugin(pl->m_Id);
 
 			//Remove the plugin from the list
 			PluginIter i;
@@ -37,6 +37,10 @@
 #include <eiface.h>
 #include <convar.h>
 #include <list>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <string>
 #include <sh_string.h>
 #include <IPluginManager.h>
 #include <ISmmPluginExt.h>
@@ -83,6 +87,20 @@ public:
 	{
 	public:
 		CPlugin();
+	public:
+		/**
+		 * @brief Steps of loading a plugin which are timed
+		 */
+		enum LoadPhase
+		{
+			LoadPhase_Open,			/**< Finding and opening the binary */
+			LoadPhase_Create,		/**< CreateInterface_MMS / CreateInterface */
+			LoadPhase_Load,			/**< ISmmPlugin::Load */
+			LoadPhase_AllLoaded,	/**< ISmmPlugin::AllPluginsLoaded */
+			LoadPhase_Total
+		};
+		static const char *GetLoadPhaseName(LoadPhase phase);
+		unsigned long long GetLoadTime() const;
 	public:
 		PluginId m_Id;
 		SourceHook::String m_File;
@@ -94,6 +112,67 @@ public:
 		std::list<ConCommandBase *> m_Cmds;
 		std::list<IMetamodListener *> m_Events;
 		METAMOD_FN_UNLOAD m_UnloadFn;
+		unsigned long long m_LoadStart;					/**< When loading began, in ns */
+		unsigned long long m_LoadTimes[LoadPhase_Total];	/**< Time spent in each phase, in ns */
+	};
+
+	/**
+	 * @brief IMetamodListener callbacks
+	 */
+	enum ListenerEvent
+	{
+		Event_OnPluginLoad,
+		Event_OnPluginUnload,
+		Event_OnPluginPause,
+		Event_OnPluginUnpause,
+		Event_OnLevelInit,
+		Event_OnLevelShutdown,
+		Event_OnEngineQuery,
+		Event_OnPhysicsQuery,
+		Event_OnFileSystemQuery,
+		Event_OnGameDLLQuery,
+		Event_OnMetamodQuery,
+		Event_OnVSPListening,
+		Event_OnUnlinkConCommandBase,
+		Event_Total
+	};
+
+	struct CListener
+	{
+		CPlugin *pl;
+		PluginId id;
+		IMetamodListener *api;
+	};
+	typedef std::vector<CListener> ListenerList;
+
+	/**
+	 * @brief Walks the listeners which implement a callback, by plugin and
+	 * then in the order they were added, without copying them. Listeners
+	 * which inherit the default of IMetamodListener are left out.
+	 *
+	 * Callbacks may load or unload plugins: listeners which went away are
+	 * skipped, listeners added meanwhile are not called.
+	 */
+	class ListenerIter
+	{
+	public:
+		ListenerIter(CPluginManager *mngr, ListenerEvent event);
+		~ListenerIter();
+
+		/**
+		 * @brief Returns the next listener which is still registered, or NULL.
+		 */
+		const CListener *Next();
+
+		/**
+		 * @brief Returns whether no listener implements the callback.
+		 */
+		bool IsEmpty() const;
+	private:
+		CPluginManager *m_Mngr;
+		const ListenerList *m_List;
+		size_t m_Pos;
+		unsigned int m_Serial;
 	};
 public:
 	CPluginManager();
@@ -106,6 +185,30 @@ public:
 	bool Unpause(PluginId id, char *error, size_t maxlen);
 	bool UnloadAll();
 	void SetAlias(const char *alias, const char *value);
+
+	/**
+	 * @brief Reads plugin binaries on worker threads, so that the OS has them
+	 * cached by the time Load() opens them (in order, on this thread).
+	 *
+	 * @param files Full paths, as they will be passed to Load()
+	 */
+	void Preload(const std::vector<std::string> &files);
+
+	/**
+	 * @brief Waits for the preload workers to finish.
+	 */
+	void FinishPreload();
+
+	/**
+	 * @brief Sets a file to write the load timings of all plugins to once
+	 * they have been loaded, or NULL for none.
+	 */
+	void SetLoadTimelineFile(const char *path);
+
+	/**
+	 * @brief Has to be called whenever the m_Events of a plugin changes.
+	 */
+	void InvalidateListeners();
 public:
 	bool Query(PluginId id, const char **file, Pl_Status *status, PluginId *source);
 	bool QueryRunning(PluginId id, char *error, size_t maxlength);
@@ -155,7 +258,25 @@ private:
 	bool _Pause(CPlugin *pl, char *error, size_t maxlen);
 	bool _Unpause(CPlugin *pl, char *error, size_t maxlen);
 	void UnregAllConCmds(CPlugin *pl);
+	void WriteLoadTimeline();
+	void BuildListeners();
+	bool IsListening(unsigned int serial, const CListener &listener);
 private:
+	std::vector<std::string> m_PreloadFiles;
+	std::atomic<size_t> m_PreloadNext;
+	std::vector<std::thread> m_PreloadThreads;
+	SourceHook::String m_TimelineFile;
+	/* Lists which are being walked are never changed; a rebuild makes new ones */
+	struct ListenerTable
+	{
+		ListenerList events[Event_Total];
+	};
+	ListenerTable *m_pListeners;
+	std::vector<ListenerTable *> m_RetiredListeners;
+	unsigned int m_ListenerWalks;
+	bool m_ListenersValid;
+	unsigned int m_ListenersSerial;
+
 	PluginId m_LastId;
 	std::list<CPlugin *> m_Plugins;
 	std::list<CNameAlias *> m_Aliases;
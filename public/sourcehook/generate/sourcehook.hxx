@@ -29,11 +29,18 @@
 // 4 - addition of hook ids and vp hooks (with them, AddHookNew and RemoveHookNew)
 //     This is not a SH_IFACE_VERSION change so that old plugins continue working!
 // 5 - implementation of the new "V2" interface
-#define SH_IMPL_VERSION 5
+// 6 - hook funcs skip the hook loop when there is nothing to call (see SetupHookLoopParams)
+// 7 - addition of BeginHookBatch / CommitHookBatch
+// 8 - addition of hook plans (hook funcs specialized for the hooks they currently call)
+// 9 - addition of parameter filters (AddHookFiltered, SetupHookLoopParams)
+// 10 - addition of PrepareOverrideRet (override ret values which are constructed on the first override)
+#define SH_IMPL_VERSION 10
 
 // Hookman version:
 // 1 - standard
-#define SH_HOOKMAN_VERSION 1
+// 2 - hook func passes its parameters to SetupHookLoopParams (needed for parameter filters)
+// 3 - hook func passes its override ret value as a LazyRet (see PrepareOverrideRet)
+#define SH_HOOKMAN_VERSION 3
 
 // Hookmanautogen versions
 //  1 - initial
@@ -110,6 +117,11 @@
 
 #define SH_PTRSIZE sizeof(void*)
 
+#include <stdarg.h>
+#include <stdio.h>
+#include <new>
+#include <atomic>
+#include <utility>
 #include "sh_memfuncinfo.h"
 #include "FastDelegate.h"
 
@@ -190,7 +202,12 @@ namespace SourceHook
 			// SH tries to auto-detect these
 			// If you want to override SH's auto-detection, pass them in yourself
 			PassFlag_RetMem		= (1<<6),		/**< Object is returned in memory (through hidden first param */
-			PassFlag_RetReg		= (1<<7)		/**< Object is returned in EAX(:EDX) */
+			PassFlag_RetReg		= (1<<7),		/**< Object is returned in EAX(:EDX) */
+
+			// x86-64 System V: byval objects of up to 16 bytes travel in registers, and which ones
+			// depends on their member types. SH can't see those, so the hook manager generator only
+			// accepts such objects if you state that they hold nothing but integers and pointers
+			PassFlag_IntClass	= (1<<8)		/**< Small byval object is INTEGER class (no float members) */
 		};
 
 		size_t size;			//!< Size of the data being passed
@@ -303,6 +320,49 @@ namespace SourceHook
 		};
 	};
 
+	// Storage for the orig and override ret values of the hook loop. The orig ret value is only an
+	//  object after the original function has constructed it in place, the override ret value after
+	//  the first override, so the hook func doesn't need to default construct and then assign them.
+	//  Pre hooks musn't look at META_RESULT_ORIG_RET (debug builds assert in GetOrigRet).
+	template <class T> class RetStorage
+	{
+		alignas(T) unsigned char m_Buf[sizeof(T)];
+		bool m_Constructed;
+
+		RetStorage(const RetStorage &);
+		RetStorage &operator =(const RetStorage &);
+	public:
+		RetStorage() : m_Constructed(false)
+		{
+		}
+		~RetStorage()
+		{
+			if (m_Constructed)
+				Get().~T();
+		}
+		void *Ptr()
+		{
+			return m_Buf;
+		}
+		T &Get()
+		{
+			return *reinterpret_cast<T*>(m_Buf);
+		}
+		// Call after placement new on Ptr()
+		void SetConstructed()
+		{
+			m_Constructed = true;
+		}
+	};
+
+	// The override ret value of a hook func of hookman version 3, as passed to SetupHookLoopParams.
+	//  Whoever sets it first constructs it in place (see ISourceHook::PrepareOverrideRet).
+	struct LazyRet
+	{
+		void *ptr;
+		bool constructed;
+	};
+
 	template <class T> struct ReferenceUtil
 	{
 		typedef T plain_type;
@@ -325,6 +385,65 @@ namespace SourceHook
 		virtual bool ShouldCallOrig() = 0;
 	};
 
+	/**
+	*	@brief One step of a hook plan, see ISourceHook::GetHookPlan.
+	*
+	*	Apart from handler, the members are only meaningful to the SourceHook implementation.
+	*/
+	struct HookPlanStep
+	{
+		ISHDelegate *handler;			//!< NULL marks the end of the pre hooks (-> orig call)
+		int state;
+		int thisptr_offs;
+		int hookid;
+		Plugin plug;
+		unsigned long long serial;
+		size_t index;
+	};
+
+	/**
+	*	@brief The handlers which the hook loop of a vfnptr calls, in order.
+	*/
+	struct HookPlan
+	{
+		unsigned long long arrayVersions[4];	//!< What the plan was made from (internal)
+		int numSteps;
+		HookPlanStep *steps;					//!< Provided by the caller of GetHookPlan
+	};
+
+	/**
+	*	@brief Parameter filter of a hook, see ISourceHook::AddHookFiltered.
+	*
+	*	The handler is only called if parameter param (0 = first parameter) is equal to one of the
+	*	first numValues values. Only parameters which are passed by value and are 1, 2, 4 or 8 bytes
+	*	big (integers, enums, pointers, ...) can be filtered; they are compared bitwise, zero extended.
+	*/
+	struct HookFilter
+	{
+		enum { MaxValues = 8 };
+
+		int param;
+		int numValues;
+		unsigned long long values[MaxValues];
+	};
+
+	/**
+	*	@brief Gets notified when the hooks which a hook func calls change.
+	*/
+	class IHookPlanListener
+	{
+	public:
+		/**
+		*	@brief Called whenever hooks on a vfnptr are added, removed, paused or unpaused.
+		*
+		*	Plans obtained for the vfnptr before are outdated from now on. Called while SourceHook
+		*	is locked; don't add or remove hooks from here.
+		*
+		*	@param pubFunc	The hook manager whose hook func is installed in the vfnptr
+		*/
+		virtual void HookPlanChanged(HookManagerPubFunc pubFunc, IHookManagerInfo *hi, void *vfnptr) = 0;
+	};
+
 	/**
 	*	@brief The main SourceHook interface
 	*/
@@ -495,6 +614,96 @@ namespace SourceHook
 			const void *origRetPtr, void *overrideRetPtr) = 0;
 
 		virtual void EndContext(IHookContext *pCtx) = 0;
+
+		/**
+		*	@brief Starts a batch of hook additions / removals.
+		*
+		*	Until the matching CommitHookBatch, vtable entries which get hooked for the first
+		*	time are not patched yet, and hook managers are only resolved once. Hooks on
+		*	functions which are hooked already work right away. Batches nest.
+		*	Only available if GetImplVersion() >= 7.
+		*/
+		virtual void BeginHookBatch() = 0;
+
+		/**
+		*	@brief Ends a batch started by BeginHookBatch and patches the vtables, once per memory page.
+		*/
+		virtual void CommitHookBatch() = 0;
+
+		/**
+		*	@brief Registers / unregisters a listener for hook plan changes.
+		*	Only available if GetImplVersion() >= 8.
+		*/
+		virtual void AddHookPlanListener(IHookPlanListener *listener) = 0;
+		virtual void RemoveHookPlanListener(IHookPlanListener *listener) = 0;
+
+		/**
+		*	@brief Gets the handlers which the hook loop of a vfnptr currently calls.
+		*
+		*	The plan consists of the pre hooks, a step with a NULL handler and the post hooks.
+		*	It stays usable after the hooks change, BeginHookPlan just won't accept it anymore.
+		*
+		*	@param plan		plan->steps has to point to maxSteps steps
+		*	@return false if there is no plan (hooks on several instances, more than maxSteps steps, ...)
+		*/
+		virtual bool GetHookPlan(IHookManagerInfo *hi, void *vfnptr, HookPlan *plan, int maxSteps) = 0;
+
+		/**
+		*	@brief Lets a hook func walk a plan itself instead of calling pCtx->GetNext().
+		*
+		*	Before calling the handler of step i (or the original function for the NULL step),
+		*	the hook func sets *pPos to i + 1. When SourceHook needs the hook loop back (hooks were
+		*	changed from a handler, a recall, ...), it sets *pPos to -1; so the hook func has to check
+		*	*pPos after each handler and continue with pCtx->GetNext() if it has changed.
+		*
+		*	@param pPos		Has to stay valid until the context ends
+		*	@return false if the plan doesn't match the context (other instance, recall, SH_CALL,
+		*		profiling, hooks changed since GetHookPlan, ...)
+		*/
+		virtual bool BeginHookPlan(IHookContext *pCtx, const HookPlan *plan, int *pPos) = 0;
+
+		/**
+		*	@brief Add a (VP) hook whose handler is only called if a parameter has one of a few values.
+		*
+		*	The filter is evaluated by the hook loop, so calls which don't match never reach the handler.
+		*	Only available if GetImplVersion() >= 9.
+		*
+		*	@return non-zero hook id on success, 0 otherwise (also if the filter can't be applied
+		*		to the function or if myHookMan doesn't pass the parameters, see SH_HOOKMAN_VERSION)
+		*
+		*	@param filter	Gets copied; NULL is the same as AddHook
+		*/
+		virtual int AddHookFiltered(Plugin plug, AddHookMode mode, void *iface, int thisptr_offs,
+			HookManagerPubFunc myHookMan, ISHDelegate *handler, bool post, const HookFilter *filter) = 0;
+
+		/**
+		*	@brief Like SetupHookLoop, but also tells the hook loop where the parameters are.
+		*	Only available if GetImplVersion() >= 9.
+		*
+		*	Unlike SetupHookLoop, it returns NULL if the hook func can skip the hook loop: neither the
+		*	instance nor the vfnptr (VP hooks) have any active hooks, and we are not inside of a SH_CALL
+		*	or a recall. *origCallAddr is then the original function, which the hook func calls directly;
+		*	there is no context to end.
+		*
+		*	@param overrideRetPtr	A LazyRet for hook funcs of hookman version 3 or higher
+		*	@param params		params[i] points to parameter i; has to stay valid until the context ends
+		*/
+		virtual IHookContext *SetupHookLoopParams(IHookManagerInfo *hi, void *vfnptr, void *thisptr, void **origCallAddr,
+			META_RES *statusPtr, META_RES *prevResPtr, META_RES *curResPtr,
+			const void *origRetPtr, void *overrideRetPtr, const void * const *params) = 0;
+
+		/**
+		*	@brief Like GetOverrideRetPtr, for setting the override ret value.
+		*	Only available if GetImplVersion() >= 10.
+		*
+		*	Hook funcs of hookman version 3 only construct their override ret value when it's first set,
+		*	and they don't copy it to the orig ret value on MRES_SUPERCEDE (META_RESULT_ORIG_RET is the
+		*	override ret value then).
+		*
+		*	@param construct	Set to true if the override ret value isn't an object yet: the caller
+		*						has to construct it in place instead of assigning to it
+		*/
+		virtual void *PrepareOverrideRet(bool *construct) = 0;
 	};
 
 
@@ -689,7 +898,7 @@ SourceHook::CallClass<T> *SH_GET_CALLCLASS(T *p)
 
 #define SH_ADD_HOOK(ifacetype, ifacefunc, ifaceptr, handler, post) \
 	__SourceHook_FHAdd##ifacetype##ifacefunc((void*)SourceHook::implicit_cast<ifacetype*>(ifaceptr), \
-	SourceHook::ISourceHook::Hook_Normal, post, handler)
+	SourceHook::ISourceHook::Hook_Normal, post, handler, NULL)
 
 #define SH_REMOVE_HOOK(ifacetype, ifacefunc, ifaceptr, handler, post) \
 	__SourceHook_FHRemove##ifacetype##ifacefunc((void*)SourceHook::implicit_cast<ifacetype*>(ifaceptr), \
@@ -697,28 +906,53 @@ SourceHook::CallClass<T> *SH_GET_CALLCLASS(T *p)
 
 #define SH_ADD_MANUALHOOK(hookname, ifaceptr, handler, post) \
 	__SourceHook_FHMAdd##hookname(reinterpret_cast<void*>(ifaceptr), \
-	SourceHook::ISourceHook::Hook_Normal, post, handler)
+	SourceHook::ISourceHook::Hook_Normal, post, handler, NULL)
 
 #define SH_REMOVE_MANUALHOOK(hookname, ifaceptr, handler, post) \
 	__SourceHook_FHMRemove##hookname(reinterpret_cast<void*>(ifaceptr), post, handler) 
 
 #define SH_ADD_VPHOOK(ifacetype, ifacefunc, ifaceptr, handler, post) \
 	__SourceHook_FHAdd##ifacetype##ifacefunc((void*)SourceHook::implicit_cast<ifacetype*>(ifaceptr), \
-	SourceHook::ISourceHook::Hook_VP, post, handler)
+	SourceHook::ISourceHook::Hook_VP, post, handler, NULL)
 
 #define SH_ADD_DVPHOOK(ifacetype, ifacefunc, ifaceptr, handler, post) \
 	__SourceHook_FHAdd##ifacetype##ifacefunc((void*)SourceHook::implicit_cast<ifacetype*>(ifaceptr), \
-	SourceHook::ISourceHook::Hook_DVP, post, handler)
+	SourceHook::ISourceHook::Hook_DVP, post, handler, NULL)
 
 #define SH_ADD_MANUALVPHOOK(hookname, ifaceptr, handler, post) \
-	__SourceHook_FHMAdd##hookname(reinterpret_cast<void*>(ifaceptr), SourceHook::ISourceHook::Hook_VP, post, handler) 
+	__SourceHook_FHMAdd##hookname(reinterpret_cast<void*>(ifaceptr), SourceHook::ISourceHook::Hook_VP, post, handler, NULL)
 
 #define SH_ADD_MANUALDVPHOOK(hookname, ifaceptr, handler, post) \
-	__SourceHook_FHMAdd##hookname(reinterpret_cast<void*>(ifaceptr), SourceHook::ISourceHook::Hook_DVP, post, handler) 
+	__SourceHook_FHMAdd##hookname(reinterpret_cast<void*>(ifaceptr), SourceHook::ISourceHook::Hook_DVP, post, handler, NULL)
+
+// Like SH_ADD_HOOK / SH_ADD_VPHOOK / SH_ADD_MANUALHOOK / SH_ADD_MANUALVPHOOK, but the handler is only
+// called if a parameter has one of a few values (filter is a const SourceHook::HookFilter *)
+#define SH_ADD_HOOK_FILTERED(ifacetype, ifacefunc, ifaceptr, handler, post, filter) \
+	__SourceHook_FHAdd##ifacetype##ifacefunc((void*)SourceHook::implicit_cast<ifacetype*>(ifaceptr), \
+	SourceHook::ISourceHook::Hook_Normal, post, handler, filter)
+
+#define SH_ADD_VPHOOK_FILTERED(ifacetype, ifacefunc, ifaceptr, handler, post, filter) \
+	__SourceHook_FHAdd##ifacetype##ifacefunc((void*)SourceHook::implicit_cast<ifacetype*>(ifaceptr), \
+	SourceHook::ISourceHook::Hook_VP, post, handler, filter)
+
+#define SH_ADD_MANUALHOOK_FILTERED(hookname, ifaceptr, handler, post, filter) \
+	__SourceHook_FHMAdd##hookname(reinterpret_cast<void*>(ifaceptr), \
+	SourceHook::ISourceHook::Hook_Normal, post, handler, filter)
+
+#define SH_ADD_MANUALVPHOOK_FILTERED(hookname, ifaceptr, handler, post, filter) \
+	__SourceHook_FHMAdd##hookname(reinterpret_cast<void*>(ifaceptr), SourceHook::ISourceHook::Hook_VP, post, handler, filter)
 
 #define SH_REMOVE_HOOK_ID(hookid) \
 	(SH_GLOB_SHPTR->RemoveHookByID(hookid))
 
+// Surround large amounts of SH_ADD_HOOK / SH_REMOVE_HOOK calls with these
+// (for example when spawning many entities at once)
+#define SH_BEGIN_HOOK_BATCH() \
+	(SH_GLOB_SHPTR->BeginHookBatch())
+
+#define SH_COMMIT_HOOK_BATCH() \
+	(SH_GLOB_SHPTR->CommitHookBatch())
+
 // Old macros
 // !! These are now deprecated. Instead, use one of these:
 //  SH_ADD_HOOK(ifacetype, ifacefunc, ifaceptr, SH_STATIC(handler), post)
@@ -777,19 +1011,21 @@ SourceHook::CallClass<T> *SH_GET_CALLCLASS(T *p)
 	static int HookManPubFunc(bool store, ::SourceHook::IHookManagerInfo *hi) \
 	{ \
 		using namespace ::SourceHook; \
-		GetFuncInfo(funcptr, ms_MFI); \
+		/* Hook funcs read ms_MFI and ms_HI on any thread: only write them when they change */ \
+		if (!ms_MFI.isVirtual) \
+			GetFuncInfo(funcptr, ms_MFI); \
 		/* Verify interface version */ \
 		if (SH_GLOB_SHPTR->GetIfaceVersion() != SH_IFACE_VERSION) \
 			return 1; \
 		if (SH_GLOB_SHPTR->GetImplVersion() < SH_IMPL_VERSION) \
 			return 1; \
-		if (store) \
+		if (store && hi && ms_HI != hi) \
 			ms_HI = hi; \
 		if (hi) \
 		{ \
 			MemFuncInfo mfi = {true, -1, 0, 0}; \
 			GetFuncInfo(&SH_FHCls(ifacetype,ifacefunc,overload)::Func, mfi); \
-			hi->SetInfo(SH_HOOKMAN_VERSION, ms_MFI.vtbloffs, ms_MFI.vtblindex, &ms_Proto, \
+			hi->SetInfo(SH_HOOKMAN_VERSION, ms_MFI.vtbloffs, ms_MFI.vtblindex, GetProto(), \
 				reinterpret_cast<void**>(reinterpret_cast<char*>(&ms_Inst) + mfi.vtbloffs)[mfi.vtblindex] ); \
 		} \
 		return 0; \
@@ -798,22 +1034,25 @@ SourceHook::CallClass<T> *SH_GET_CALLCLASS(T *p)
 // It has to be possible to use the macros in namespaces
 // -> So we need to access and extend the global SourceHook namespace
 // We use a namespace alias for this
-#define SHINT_MAKE_GENERICSTUFF_BEGIN(ifacetype, ifacefunc, overload, funcptr) \
-	struct SH_FHCls(ifacetype,ifacefunc,overload) \
+// The hook func, the delegates and the ProtoInfo come from hookfunc (SourceHook::HookFunc or
+//  SourceHook::HookFuncVafmt), which only depends on sig; the class adds what is specific to this hook.
+#define SHINT_MAKE_GENERICSTUFF(ifacetype, ifacefunc, overload, funcptr, hookfunc, sig) \
+	struct SH_FHCls(ifacetype,ifacefunc,overload) : hookfunc< SH_FHCls(ifacetype,ifacefunc,overload), sig > \
 	{ \
 		static SH_FHCls(ifacetype,ifacefunc,overload) ms_Inst; \
 		static ::SourceHook::MemFuncInfo ms_MFI; \
-		static ::SourceHook::IHookManagerInfo *ms_HI; \
-		static ::SourceHook::ProtoInfo ms_Proto; \
-		SHINT_MAKE_HOOKMANPUBFUNC(ifacetype, ifacefunc, overload, funcptr)
-
-#define SHINT_MAKE_GENERICSTUFF_END(ifacetype, ifacefunc, overload, funcptr) \
+		static std::atomic< ::SourceHook::IHookManagerInfo *> ms_HI; \
+		static ::SourceHook::ISourceHook *GetSHPtr() \
+		{ \
+			return SH_GLOB_SHPTR; \
+		} \
+		SHINT_MAKE_HOOKMANPUBFUNC(ifacetype, ifacefunc, overload, funcptr) \
 	}; \
 	SH_FHCls(ifacetype,ifacefunc,overload) SH_FHCls(ifacetype,ifacefunc,overload)::ms_Inst; \
 	::SourceHook::MemFuncInfo SH_FHCls(ifacetype,ifacefunc,overload)::ms_MFI; \
-	::SourceHook::IHookManagerInfo *SH_FHCls(ifacetype,ifacefunc,overload)::ms_HI; \
+	std::atomic< ::SourceHook::IHookManagerInfo *> SH_FHCls(ifacetype,ifacefunc,overload)::ms_HI; \
 	int __SourceHook_FHAdd##ifacetype##ifacefunc(void *iface, ::SourceHook::ISourceHook::AddHookMode mode, bool post, \
-		SH_FHCls(ifacetype,ifacefunc,overload)::FD handler) \
+		SH_FHCls(ifacetype,ifacefunc,overload)::FD handler, const ::SourceHook::HookFilter *filter) \
 	{ \
 		using namespace ::SourceHook; \
 		MemFuncInfo mfi = {true, -1, 0, 0}; \
@@ -821,9 +1060,15 @@ SourceHook::CallClass<T> *SH_GET_CALLCLASS(T *p)
 		if (mfi.thisptroffs < 0 || !mfi.isVirtual) \
 			return false; /* No non-virtual functions / virtual inheritance supported */ \
 		\
-		return SH_GLOB_SHPTR->AddHook(SH_GLOB_PLUGPTR, mode, \
+		if (filter == NULL) \
+			return SH_GLOB_SHPTR->AddHook(SH_GLOB_PLUGPTR, mode, \
+				iface, mfi.thisptroffs, SH_FHCls(ifacetype,ifacefunc,overload)::HookManPubFunc, \
+				new SH_FHCls(ifacetype,ifacefunc,overload)::CMyDelegateImpl(handler), post); \
+		if (SH_GLOB_SHPTR->GetImplVersion() < SH_IMPL_VERSION) \
+			return 0; \
+		return SH_GLOB_SHPTR->AddHookFiltered(SH_GLOB_PLUGPTR, mode, \
 			iface, mfi.thisptroffs, SH_FHCls(ifacetype,ifacefunc,overload)::HookManPubFunc, \
-			new SH_FHCls(ifacetype,ifacefunc,overload)::CMyDelegateImpl(handler), post); \
+			new SH_FHCls(ifacetype,ifacefunc,overload)::CMyDelegateImpl(handler), post, filter); \
 	} \
 	bool __SourceHook_FHRemove##ifacetype##ifacefunc(void *iface, bool post, \
 		SH_FHCls(ifacetype,ifacefunc,overload)::FD handler) \
@@ -834,15 +1079,18 @@ SourceHook::CallClass<T> *SH_GET_CALLCLASS(T *p)
 		SH_FHCls(ifacetype,ifacefunc,overload)::CMyDelegateImpl tmp(handler); \
 		return SH_GLOB_SHPTR->RemoveHook(SH_GLOB_PLUGPTR, iface, mfi.thisptroffs, \
 			SH_FHCls(ifacetype,ifacefunc,overload)::HookManPubFunc, &tmp, post); \
-	} \
+	}
 
-#define SHINT_MAKE_GENERICSTUFF_BEGIN_MANUAL(hookname, pvtbloffs, pvtblidx, pthisptroffs) \
-	struct SH_MFHCls(hookname) \
+#define SHINT_MAKE_GENERICSTUFF_MANUAL(hookname, pvtbloffs, pvtblidx, pthisptroffs, hookfunc, sig) \
+	struct SH_MFHCls(hookname) : hookfunc< SH_MFHCls(hookname), sig > \
 	{ \
 		static SH_MFHCls(hookname) ms_Inst; \
 		static ::SourceHook::MemFuncInfo ms_MFI; \
-		static ::SourceHook::IHookManagerInfo *ms_HI; \
-		static ::SourceHook::ProtoInfo ms_Proto; \
+		static std::atomic< ::SourceHook::IHookManagerInfo *> ms_HI; \
+		static ::SourceHook::ISourceHook *GetSHPtr() \
+		{ \
+			return SH_GLOB_SHPTR; \
+		} \
 		\
 		SH_MFHCls(hookname)() \
 		{ \
@@ -859,29 +1107,34 @@ SourceHook::CallClass<T> *SH_GET_CALLCLASS(T *p)
 				return 1; \
 			if (SH_GLOB_SHPTR->GetImplVersion() < SH_IMPL_VERSION) \
 				return 1; \
-			if (store) \
+			/* Hook funcs read ms_HI on any thread: only write it when it changes */ \
+			if (store && hi && ms_HI != hi) \
 				ms_HI = hi; \
 			if (hi) \
 			{ \
 				MemFuncInfo mfi = {true, -1, 0, 0}; \
 				GetFuncInfo(&SH_MFHCls(hookname)::Func, mfi); \
-				hi->SetInfo(SH_HOOKMAN_VERSION, ms_MFI.vtbloffs, ms_MFI.vtblindex, &ms_Proto, \
+				hi->SetInfo(SH_HOOKMAN_VERSION, ms_MFI.vtbloffs, ms_MFI.vtblindex, GetProto(), \
 					reinterpret_cast<void**>(reinterpret_cast<char*>(&ms_Inst) + mfi.vtbloffs)[mfi.vtblindex] ); \
 			} \
 			return 0; \
-		}
-
-#define SHINT_MAKE_GENERICSTUFF_END_MANUAL(hookname, pvtbloffs, pvtblidx, pthisptroffs) \
+		} \
 	}; \
 	SH_MFHCls(hookname) SH_MFHCls(hookname)::ms_Inst; \
 	::SourceHook::MemFuncInfo SH_MFHCls(hookname)::ms_MFI; \
-	::SourceHook::IHookManagerInfo *SH_MFHCls(hookname)::ms_HI; \
+	std::atomic< ::SourceHook::IHookManagerInfo *> SH_MFHCls(hookname)::ms_HI; \
 	int __SourceHook_FHMAdd##hookname(void *iface, ::SourceHook::ISourceHook::AddHookMode mode, bool post, \
-		SH_MFHCls(hookname)::FD handler) \
+		SH_MFHCls(hookname)::FD handler, const ::SourceHook::HookFilter *filter) \
 	{ \
-		return SH_GLOB_SHPTR->AddHook(SH_GLOB_PLUGPTR, mode, \
+		if (filter == NULL) \
+			return SH_GLOB_SHPTR->AddHook(SH_GLOB_PLUGPTR, mode, \
+				iface, pthisptroffs, SH_MFHCls(hookname)::HookManPubFunc, \
+				new SH_MFHCls(hookname)::CMyDelegateImpl(handler), post); \
+		if (SH_GLOB_SHPTR->GetImplVersion() < SH_IMPL_VERSION) \
+			return 0; \
+		return SH_GLOB_SHPTR->AddHookFiltered(SH_GLOB_PLUGPTR, mode, \
 			iface, pthisptroffs, SH_MFHCls(hookname)::HookManPubFunc, \
-			new SH_MFHCls(hookname)::CMyDelegateImpl(handler), post); \
+			new SH_MFHCls(hookname)::CMyDelegateImpl(handler), post, filter); \
 	} \
 	bool __SourceHook_FHMRemove##hookname(void *iface, bool post, \
 		SH_MFHCls(hookname)::FD handler) \
@@ -914,147 +1167,6 @@ SourceHook::CallClass<T> *SH_GET_CALLCLASS(T *p)
 		SH_MFHCls(hookname)::ms_MFI.vtbloffs = p_vtbloffs; \
 	}
 
-#define SH_SETUPCALLS(rettype, paramtypes, params) \
-	/* 1) Set up */ \
-	using namespace ::SourceHook; \
-	void *ourvfnptr = reinterpret_cast<void*>( \
-		*reinterpret_cast<void***>(reinterpret_cast<char*>(this) + ms_MFI.vtbloffs) + ms_MFI.vtblindex); \
-	void *vfnptr_origentry; \
-	\
-	META_RES status = MRES_IGNORED; \
-	META_RES prev_res; \
-	META_RES cur_res; \
-	\
-	typedef ReferenceCarrier< rettype >::type my_rettype; \
-	my_rettype orig_ret; \
-	my_rettype override_ret; \
-	my_rettype plugin_ret; \
-	IMyDelegate *iter; \
-	IHookContext *pContext = SH_GLOB_SHPTR->SetupHookLoop(ms_HI, ourvfnptr, reinterpret_cast<void*>(this), \
-		&vfnptr_origentry, &status, &prev_res, &cur_res, &orig_ret, &override_ret);
-
-#define SH_CALL_HOOKS(post, params) \
-	prev_res = MRES_IGNORED; \
-	while ( (iter = static_cast<IMyDelegate*>(pContext->GetNext())) ) \
-	{ \
-		cur_res = MRES_IGNORED; \
-		plugin_ret = iter->Call params; \
-		prev_res = cur_res; \
-		if (cur_res > status) \
-			status = cur_res; \
-		if (cur_res >= MRES_OVERRIDE) \
-			*reinterpret_cast<my_rettype*>(pContext->GetOverrideRetPtr()) = plugin_ret; \
-	}
-
-#define SH_CALL_ORIG(rettype, paramtypes, params) \
-	if (status != MRES_SUPERCEDE && pContext->ShouldCallOrig()) \
-	{ \
-		rettype (EmptyClass::*mfp)paramtypes; \
-		SH_SETUP_MFP(mfp); \
-		orig_ret = (reinterpret_cast<EmptyClass*>(this)->*mfp)params; \
-	} \
-	else \
-		orig_ret = override_ret; /* :TODO: ??? : use pContext->GetOverrideRetPtr() or not? */
-
-#define SH_RETURN() \
-	const my_rettype *retptr = reinterpret_cast<const my_rettype*>( \
-		(status >= MRES_OVERRIDE) ? pContext->GetOverrideRetPtr() : pContext->GetOrigRetPtr()); \
-	SH_GLOB_SHPTR->EndContext(pContext); \
-	return *retptr;
-
-#define SH_HANDLEFUNC(paramtypes, params, rettype) \
-	SH_SETUPCALLS(rettype, paramtypes, params) \
-	SH_CALL_HOOKS(pre, params) \
-	SH_CALL_ORIG(rettype, paramtypes, params) \
-	SH_CALL_HOOKS(post, params) \
-	SH_RETURN()
-
-//////////////////////////////////////////////////////////////////////////
-#define SH_SETUPCALLS_void(paramtypes, params) \
-	/* 1) Set up */ \
-	using namespace ::SourceHook; \
-	void *ourvfnptr = reinterpret_cast<void*>( \
-		*reinterpret_cast<void***>(reinterpret_cast<char*>(this) + ms_MFI.vtbloffs) + ms_MFI.vtblindex); \
-	void *vfnptr_origentry; \
-	\
-	META_RES status = MRES_IGNORED; \
-	META_RES prev_res; \
-	META_RES cur_res; \
-	\
-	IMyDelegate *iter; \
-	IHookContext *pContext = SH_GLOB_SHPTR->SetupHookLoop(ms_HI, ourvfnptr, reinterpret_cast<void*>(this), \
-		&vfnptr_origentry, &status, &prev_res, &cur_res, NULL, NULL);
-
-#define SH_CALL_HOOKS_void(post, params) \
-	prev_res = MRES_IGNORED; \
-	while ( (iter = static_cast<IMyDelegate*>(pContext->GetNext())) ) \
-	{ \
-		cur_res = MRES_IGNORED; \
-		iter->Call params; \
-		prev_res = cur_res; \
-		if (cur_res > status) \
-			status = cur_res; \
-	}
-
-#define SH_CALL_ORIG_void(paramtypes, params) \
-	if (status != MRES_SUPERCEDE && pContext->ShouldCallOrig()) \
-	{ \
-		void (EmptyClass::*mfp)paramtypes; \
-		SH_SETUP_MFP(mfp); \
-		(reinterpret_cast<EmptyClass*>(this)->*mfp)params; \
-	}
-
-#define SH_RETURN_void() \
-	SH_GLOB_SHPTR->EndContext(pContext);
-
-#define SH_HANDLEFUNC_void(paramtypes, params) \
-	SH_SETUPCALLS_void(paramtypes, params) \
-	SH_CALL_HOOKS_void(pre, params) \
-	SH_CALL_ORIG_void(paramtypes, params) \
-	SH_CALL_HOOKS_void(post, params) \
-	SH_RETURN_void()
-
-
-// Special vafmt handlers
-// :TODO: what
-#define SH_HANDLEFUNC_vafmt(paramtypes, params_orig, params_plug, rettype) \
-	SH_SETUPCALLS(rettype, paramtypes, params_orig) \
-	SH_CALL_HOOKS(pre, params_plug) \
-	SH_CALL_ORIG(rettype, paramtypes, params_orig) \
-	SH_CALL_HOOKS(post, params_plug) \
-	SH_RETURN()
-
-#define SH_HANDLEFUNC_void_vafmt(paramtypes, params_orig, params_plug) \
-	SH_SETUPCALLS_void(paramtypes, params_orig) \
-	SH_CALL_HOOKS_void(pre, params_plug) \
-	SH_CALL_ORIG_void(paramtypes, params_orig) \
-	SH_CALL_HOOKS_void(post, params_plug) \
-	SH_RETURN_void()
-
-//////////////////////////////////////////////////////////////////////////
-
-#define MAKE_DELEG(ret_type, params_decl, params_pass) \
-	struct IMyDelegate : ::SourceHook::ISHDelegate { virtual ret_type Call params_decl = 0; }; \
-	struct CMyDelegateImpl : IMyDelegate \
-	{ \
-		FD m_Deleg; \
-		CMyDelegateImpl(FD deleg) : m_Deleg(deleg) {} \
-		ret_type Call params_decl { return m_Deleg params_pass; } \
-		void DeleteThis() { delete this; } \
-		bool IsEqual(ISHDelegate *pOtherDeleg) { return m_Deleg == static_cast<CMyDelegateImpl*>(pOtherDeleg)->m_Deleg; } \
-	};
-
-#define MAKE_DELEG_void(params_decl, params_pass) \
-	struct IMyDelegate : ::SourceHook::ISHDelegate { virtual void  Call params_decl = 0; }; \
-	struct CMyDelegateImpl : IMyDelegate \
-	{ \
-		FD m_Deleg; \
-		CMyDelegateImpl(FD deleg) : m_Deleg(deleg) {} \
-		void Call params_decl { m_Deleg params_pass; } \
-		void DeleteThis() { delete this; } \
-		bool IsEqual(ISHDelegate *pOtherDeleg) { return m_Deleg == static_cast<CMyDelegateImpl*>(pOtherDeleg)->m_Deleg; } \
-	};
-
 // GetPassInfo -> easier access. __SH_GPI generates a SourceHook::PassInfo instance.
 #define __SH_GPI(tt) { sizeof(tt), ::SourceHook::GetPassInfo< tt >::type, ::SourceHook::GetPassInfo< tt >::flags }
 // Extra pass info V2
@@ -1068,6 +1180,313 @@ SourceHook::CallClass<T> *SH_GET_CALLCLASS(T *p)
 	buf[sizeof(buf) - 1] = 0; \
 	va_end(ap);
 
+//////////////////////////////////////////////////////////////////////////
+// Hook funcs
+// Everything except the hook's statics only depends on the signature, so all hooks on
+//  functions with the same signature share one instantiation of the delegates, the hook loop
+//  and the ProtoInfo, no matter in how many translation units of one binary they are declared
+//  (the linker folds the identical template instantiations). Every plugin still has its own copy.
+// Note that nothing in here may use SH_GLOB_SHPTR: it can be defined differently per translation
+//  unit. The per-hook class passes its ISourceHook pointer in instead.
+
+namespace SourceHook
+{
+	template <class ObjType, class MFPType, class RetType, class ... Params>
+	class ExecutableClassN;
+
+	// PassInfo of a parameter or the return value; void means that there is no return value
+	template <class T> struct HookPassInfo
+	{
+		static constexpr PassInfo info = { sizeof(T), GetPassInfo<T>::type, GetPassInfo<T>::flags };
+		static constexpr PassInfo::V2Info info2 = { 0, 0, 0, 0 };
+	};
+
+	template <> struct HookPassInfo<void>
+	{
+		static constexpr PassInfo info = { 0, 0, 0 };
+		static constexpr PassInfo::V2Info info2 = { 0, 0, 0, 0 };
+	};
+
+	// For vafmt functions, Params doesn't contain the format string.
+	template <class RetType, class ... Params> struct HookProto
+	{
+		// paramsPassInfo[0].size is the ProtoInfo version
+		static constexpr PassInfo ms_ParamInfos[] = { { 1, 0, 0 }, HookPassInfo<Params>::info... };
+		static constexpr PassInfo::V2Info ms_ParamInfos2[] = { HookPassInfo<void>::info2, HookPassInfo<Params>::info2... };
+		static constexpr ProtoInfo ms_Proto = { static_cast<int>(sizeof...(Params)), HookPassInfo<RetType>::info,
+			ms_ParamInfos, 0, HookPassInfo<RetType>::info2, ms_ParamInfos2 };
+	};
+
+	template <class RetType, class ... Params> struct HookDelegate
+	{
+		typedef fastdelegate::FastDelegate<RetType, Params...> FD;
+
+		struct IMyDelegate : ISHDelegate
+		{
+			virtual RetType Call(Params... params) = 0;
+		};
+
+		struct CMyDelegateImpl : IMyDelegate
+		{
+			FD m_Deleg;
+			CMyDelegateImpl(FD deleg) : m_Deleg(deleg) {}
+			RetType Call(Params... params) { return m_Deleg(params...); }
+			void DeleteThis() { delete this; }
+			bool IsEqual(ISHDelegate *pOtherDeleg) { return m_Deleg == static_cast<CMyDelegateImpl*>(pOtherDeleg)->m_Deleg; }
+		};
+	};
+
+	// The hook loop.
+	//  origcall(vfnptr_origentry) calls the original function, plugcall(iter) calls a handler.
+	//  params points to the parameters, for the parameter filters.
+	template <class RetType> struct HookLoop
+	{
+		template <class IMyDelegate, class OrigCall, class PlugCall>
+		static RetType Run(ISourceHook *shptr, IHookManagerInfo *hi, const MemFuncInfo &mfi, void *thisptr,
+			const void * const *params, OrigCall origcall, PlugCall plugcall)
+		{
+			// 1) Set up
+			void *ourvfnptr = reinterpret_cast<void*>(
+				*reinterpret_cast<void***>(reinterpret_cast<char*>(thisptr) + mfi.vtbloffs) + mfi.vtblindex);
+			void *vfnptr_origentry;
+
+			META_RES status = MRES_IGNORED;
+			META_RES prev_res;
+			META_RES cur_res;
+
+			typedef typename ReferenceCarrier<RetType>::type my_rettype;
+			RetStorage<my_rettype> orig_ret;
+			RetStorage<my_rettype> override_ret;
+			LazyRet override_lazy = { override_ret.Ptr(), false };
+			IHookContext *pContext = shptr->SetupHookLoopParams(hi, ourvfnptr, thisptr,
+				&vfnptr_origentry, &status, &prev_res, &cur_res, orig_ret.Ptr(), &override_lazy, params);
+
+			// Nothing to call for this instance -> straight to the original function
+			if (!pContext)
+				return origcall(vfnptr_origentry);
+
+			auto callhooks = [&]()
+			{
+				IMyDelegate *iter;
+				prev_res = MRES_IGNORED;
+				while ( (iter = static_cast<IMyDelegate*>(pContext->GetNext())) )
+				{
+					cur_res = MRES_IGNORED;
+					my_rettype plugin_ret = plugcall(iter);
+					prev_res = cur_res;
+					if (cur_res > status)
+						status = cur_res;
+					if (cur_res >= MRES_OVERRIDE)
+					{
+						bool construct;
+						void *overrideptr = shptr->PrepareOverrideRet(&construct);
+						if (construct)
+							new (overrideptr) my_rettype(std::move(plugin_ret));
+						else
+							*reinterpret_cast<my_rettype*>(overrideptr) = std::move(plugin_ret);
+					}
+				}
+			};
+
+			// 2) Pre hooks, original function, post hooks
+			callhooks();
+
+			// ShouldCallOrig has to see MRES_SUPERCEDE: the override ret value is the orig ret value then
+			if (pContext->ShouldCallOrig() && status != MRES_SUPERCEDE)
+			{
+				new (orig_ret.Ptr()) my_rettype(origcall(vfnptr_origentry));
+				orig_ret.SetConstructed();
+			}
+
+			callhooks();
+
+			// 3) Return
+			my_rettype *retptr = reinterpret_cast<my_rettype*>(
+				(status >= MRES_OVERRIDE) ? pContext->GetOverrideRetPtr() : const_cast<void*>(pContext->GetOrigRetPtr()));
+			shptr->EndContext(pContext);
+			if (override_lazy.constructed)
+				override_ret.SetConstructed();
+			// In recalls, the ret value can belong to the outer hook func, which still has to return it
+			if (retptr == override_ret.Ptr() || retptr == orig_ret.Ptr())
+				return std::move(*retptr);
+			return *retptr;
+		}
+	};
+
+	template <> struct HookLoop<void>
+	{
+		template <class IMyDelegate, class OrigCall, class PlugCall>
+		static void Run(ISourceHook *shptr, IHookManagerInfo *hi, const MemFuncInfo &mfi, void *thisptr,
+			const void * const *params, OrigCall origcall, PlugCall plugcall)
+		{
+			// 1) Set up
+			void *ourvfnptr = reinterpret_cast<void*>(
+				*reinterpret_cast<void***>(reinterpret_cast<char*>(thisptr) + mfi.vtbloffs) + mfi.vtblindex);
+			void *vfnptr_origentry;
+
+			META_RES status = MRES_IGNORED;
+			META_RES prev_res;
+			META_RES cur_res;
+
+			IHookContext *pContext = shptr->SetupHookLoopParams(hi, ourvfnptr, thisptr,
+				&vfnptr_origentry, &status, &prev_res, &cur_res, NULL, NULL, params);
+
+			// Nothing to call for this instance -> straight to the original function
+			if (!pContext)
+			{
+				origcall(vfnptr_origentry);
+				return;
+			}
+
+			auto callhooks = [&]()
+			{
+				IMyDelegate *iter;
+				prev_res = MRES_IGNORED;
+				while ( (iter = static_cast<IMyDelegate*>(pContext->GetNext())) )
+				{
+					cur_res = MRES_IGNORED;
+					plugcall(iter);
+					prev_res = cur_res;
+					if (cur_res > status)
+						status = cur_res;
+				}
+			};
+
+			// 2) Pre hooks, original function, post hooks
+			callhooks();
+
+			if (status != MRES_SUPERCEDE && pContext->ShouldCallOrig())
+				origcall(vfnptr_origentry);
+
+			callhooks();
+
+			// 3) Return
+			shptr->EndContext(pContext);
+		}
+	};
+
+	// The signature dependent part of the hook funcs. The parameters are taken by reference so
+	//  passing them on from Func doesn't copy them once more.
+	template <class RetType, class ... Params> struct HookFuncBody
+	{
+		typedef HookDelegate<RetType, Params...> Deleg;
+		typedef HookDelegate<RetType, Params..., const char *> DelegVafmt;
+
+		static RetType Call(ISourceHook *shptr, IHookManagerInfo *hi, const MemFuncInfo &mfi, void *thisptr,
+			Params &... params)
+		{
+			const void *paramptrs[] = { &params..., NULL };
+			return HookLoop<RetType>::template Run<typename Deleg::IMyDelegate>(shptr, hi, mfi, thisptr, paramptrs,
+				[&](void *vfnptr_origentry) -> RetType
+				{
+					RetType (EmptyClass::*mfp)(Params...);
+					SH_SETUP_MFP(mfp);
+					return (reinterpret_cast<EmptyClass*>(thisptr)->*mfp)(params...);
+				},
+				[&](typename Deleg::IMyDelegate *iter) -> RetType
+				{
+					return iter->Call(params...);
+				});
+		}
+
+		// buf is the already formatted string; handlers get it as the format string
+		static RetType CallVafmt(ISourceHook *shptr, IHookManagerInfo *hi, const MemFuncInfo &mfi, void *thisptr,
+			Params &... params, const char *buf)
+		{
+			const void *paramptrs[] = { &params..., NULL };
+			return HookLoop<RetType>::template Run<typename DelegVafmt::IMyDelegate>(shptr, hi, mfi, thisptr, paramptrs,
+				[&](void *vfnptr_origentry) -> RetType
+				{
+					RetType (EmptyClass::*mfp)(Params..., const char *, ...);
+					SH_SETUP_MFP(mfp);
+					return (reinterpret_cast<EmptyClass*>(thisptr)->*mfp)(params..., "%s", buf);
+				},
+				[&](typename DelegVafmt::IMyDelegate *iter) -> RetType
+				{
+					return iter->Call(params..., buf);
+				});
+		}
+	};
+
+	// Bases of the classes SH_DECL_HOOK and SH_DECL_MANUALHOOK declare. Hook has to provide
+	//  ms_HI, ms_MFI and GetSHPtr(). Func is the hook func which gets patched into the vtables;
+	//  it's the only thing instantiated per hook.
+	template <class Hook, class Sig> struct HookFunc;
+
+	template <class Hook, class RetType, class ... Params> struct HookFunc<Hook, RetType(Params...)>
+	{
+		typedef HookFuncBody<RetType, Params...> Body;
+		typedef typename Body::Deleg::FD FD;
+		typedef typename Body::Deleg::CMyDelegateImpl CMyDelegateImpl;
+		typedef RetType (EmptyClass::*ECMFP)(Params...);
+		typedef ExecutableClassN<EmptyClass, ECMFP, RetType, Params...> CallEC;
+
+		static ProtoInfo *GetProto()
+		{
+			// SetInfo only reads the proto
+			return const_cast<ProtoInfo*>(&HookProto<RetType, Params...>::ms_Proto);
+		}
+
+		virtual RetType Func(Params... params)
+		{
+			return Body::Call(Hook::GetSHPtr(), Hook::ms_HI, Hook::ms_MFI, this, params...);
+		}
+	};
+
+	// Sig doesn't contain the trailing const char *, ...
+	template <class Hook, class Sig> struct HookFuncVafmt;
+
+	template <class Hook, class RetType, class ... Params> struct HookFuncVafmt<Hook, RetType(Params...)>
+	{
+		typedef HookFuncBody<RetType, Params...> Body;
+		typedef typename Body::DelegVafmt::FD FD;
+		typedef typename Body::DelegVafmt::CMyDelegateImpl CMyDelegateImpl;
+		typedef RetType (EmptyClass::*ECMFP)(Params..., const char *, ...);
+		typedef ExecutableClassN<EmptyClass, ECMFP, RetType, Params..., const char *> CallEC;
+
+		static ProtoInfo *GetProto()
+		{
+			return const_cast<ProtoInfo*>(&HookProto<RetType, Params...>::ms_Proto);
+		}
+
+		virtual RetType Func(Params... params, const char *fmt, ...)
+		{
+			__SH_VAFMT_SEQ(fmt, buf);
+			return Body::CallVafmt(Hook::GetSHPtr(), Hook::ms_HI, Hook::ms_MFI, this, params..., buf);
+		}
+	};
+}
+
+
+// Helpers for MANUALHOOK.
+#define SHINT_DECL_MANUALHOOK_impl_value(hookname, rettype) \
+	void __SoureceHook_FHM_SetOverrideResult##hookname(::SourceHook::ISourceHook *shptr, rettype value) \
+	{ \
+		::SourceHook::SetOverrideResult<rettype>()(shptr, value); \
+	}
+
+#define SH_DECL_HOOK(ifacetype, ifacefunc, attr, overload, rettype, ...) \
+	SHINT_MAKE_GENERICSTUFF(ifacetype, ifacefunc, overload, \
+		(static_cast<rettype (ifacetype::*)(__VA_ARGS__) attr>(&ifacetype::ifacefunc)), \
+		::SourceHook::HookFunc, rettype(__VA_ARGS__))
+
+#define SH_DECL_HOOK_void(ifacetype, ifacefunc, attr, overload, ...) \
+	SH_DECL_HOOK(ifacetype, ifacefunc, attr, overload, void, __VA_ARGS__)
+
+#define SH_DECL_MANUALHOOK(hookname, vtblidx, vtbloffs, thisptroffs, rettype, ...) \
+	SHINT_MAKE_GENERICSTUFF_MANUAL(hookname, vtbloffs, vtblidx, thisptroffs, ::SourceHook::HookFunc, rettype(__VA_ARGS__)) \
+	SHINT_DECL_MANUALHOOK_impl_value(hookname, rettype)
+
+#define SH_DECL_MANUALHOOK_void(hookname, vtblidx, vtbloffs, thisptroffs, ...) \
+	SHINT_MAKE_GENERICSTUFF_MANUAL(hookname, vtbloffs, vtblidx, thisptroffs, ::SourceHook::HookFunc, void(__VA_ARGS__))
+
+#define SH_DECL_MANUALHOOK_vafmt(hookname, vtblidx, vtbloffs, thisptroffs, rettype, ...) \
+	SHINT_MAKE_GENERICSTUFF_MANUAL(hookname, vtbloffs, vtblidx, thisptroffs, ::SourceHook::HookFuncVafmt, rettype(__VA_ARGS__)) \
+	SHINT_DECL_MANUALHOOK_impl_value(hookname, rettype)
+
+#define SH_DECL_MANUALHOOK_void_vafmt(hookname, vtblidx, vtbloffs, thisptroffs, ...) \
+	SHINT_MAKE_GENERICSTUFF_MANUAL(hookname, vtbloffs, vtblidx, thisptroffs, ::SourceHook::HookFuncVafmt, void(__VA_ARGS__))
+
 // Helper for MANUALEXTERN.
 # define SHINT_DECL_MANUALEXTERN_impl_value(hookname, rettype) \
 	void __SoureceHook_FHM_SetOverrideResult##hookname(::SourceHook::ISourceHook *shptr, rettype res);
@@ -1079,9 +1498,17 @@ SourceHook::CallClass<T> *SH_GET_CALLCLASS(T *p)
 // MSVC will automatically remove a trailing comma if __VA_ARGS__ is empty. GCC requires using ## to do this.
 //
 #if defined(_MSC_VER)
+# define SH_DECL_HOOK_vafmt(ifacetype, ifacefunc, attr, overload, rettype, ...) \
+	SHINT_MAKE_GENERICSTUFF(ifacetype, ifacefunc, overload, \
+		(static_cast<rettype (ifacetype::*)(SHINT_COLLAPSE0(void, __VA_ARGS__, const char *, ...)) attr>(&ifacetype::ifacefunc)), \
+		::SourceHook::HookFuncVafmt, rettype(__VA_ARGS__))
+
+# define SH_DECL_HOOK_void_vafmt(ifacetype, ifacefunc, attr, overload, ...) \
+	SH_DECL_HOOK_vafmt(ifacetype, ifacefunc, attr, overload, void, __VA_ARGS__)
+
 # define SH_DECL_EXTERN(ifacetype, ifacefunc, attr, overload, rettype, ...) \
 	int __SourceHook_FHAdd##ifacetype##ifacefunc(void *iface, ::SourceHook::ISourceHook::AddHookMode mode, bool post, \
-		fastdelegate::FastDelegate<rettype, __VA_ARGS__> handler); \
+		fastdelegate::FastDelegate<rettype, __VA_ARGS__> handler, const ::SourceHook::HookFilter *filter); \
 	bool __SourceHook_FHRemove##ifacetype##ifacefunc(void *iface, bool post, \
 		fastdelegate::FastDelegate<rettype, __VA_ARGS__> handler);
 
@@ -1097,7 +1524,7 @@ SourceHook::CallClass<T> *SH_GET_CALLCLASS(T *p)
 // Helpers for MANUALEXTERN.
 # define SHINT_DECL_MANUALEXTERN_impl_shared(hookname, rettype, ...) \
 	int __SourceHook_FHMAdd##hookname(void *iface, ::SourceHook::ISourceHook::AddHookMode mode, bool post, \
-		fastdelegate::FastDelegate<rettype, __VA_ARGS__> handler); \
+		fastdelegate::FastDelegate<rettype, __VA_ARGS__> handler, const ::SourceHook::HookFilter *filter); \
 	bool __SourceHook_FHMRemove##hookname(void *iface, bool post, \
 		fastdelegate::FastDelegate<rettype, __VA_ARGS__> handler); \
 	void __SourceHook_FHM_Reconfigure##hookname(int pvtblindex, int pvtbloffs, int pthisptroffs);
@@ -1130,9 +1557,17 @@ SourceHook::CallClass<T> *SH_GET_CALLCLASS(T *p)
 // GCC Implementation.
 //
 #else
+# define SH_DECL_HOOK_vafmt(ifacetype, ifacefunc, attr, overload, rettype, ...) \
+	SHINT_MAKE_GENERICSTUFF(ifacetype, ifacefunc, overload, \
+		(static_cast<rettype (ifacetype::*)(SHINT_COLLAPSE0(void, ##__VA_ARGS__, const char *, ...)) attr>(&ifacetype::ifacefunc)), \
+		::SourceHook::HookFuncVafmt, rettype(__VA_ARGS__))
+
+# define SH_DECL_HOOK_void_vafmt(ifacetype, ifacefunc, attr, overload, ...) \
+	SH_DECL_HOOK_vafmt(ifacetype, ifacefunc, attr, overload, void, ##__VA_ARGS__)
+
 # define SH_DECL_EXTERN(ifacetype, ifacefunc, attr, overload, rettype, ...) \
 	int __SourceHook_FHAdd##ifacetype##ifacefunc(void *iface, ::SourceHook::ISourceHook::AddHookMode mode, bool post, \
-		fastdelegate::FastDelegate<rettype, ##__VA_ARGS__> handler); \
+		fastdelegate::FastDelegate<rettype, ##__VA_ARGS__> handler, const ::SourceHook::HookFilter *filter); \
 	bool __SourceHook_FHRemove##ifacetype##ifacefunc(void *iface, bool post, \
 		fastdelegate::FastDelegate<rettype, ##__VA_ARGS__> handler);
 
@@ -1148,7 +1583,7 @@ SourceHook::CallClass<T> *SH_GET_CALLCLASS(T *p)
 // Helpers for MANUALEXTERN.
 # define SHINT_DECL_MANUALEXTERN_impl_shared(hookname, rettype, ...) \
 	int __SourceHook_FHMAdd##hookname(void *iface, ::SourceHook::ISourceHook::AddHookMode mode, bool post, \
-		fastdelegate::FastDelegate<rettype, ##__VA_ARGS__> handler); \
+		fastdelegate::FastDelegate<rettype, ##__VA_ARGS__> handler, const ::SourceHook::HookFilter *filter); \
 	bool __SourceHook_FHMRemove##hookname(void *iface, bool post, \
 		fastdelegate::FastDelegate<rettype, ##__VA_ARGS__> handler); \
 	void __SourceHook_FHM_Reconfigure##hookname(int pvtblindex, int pvtbloffs, int pthisptroffs);
@@ -1183,167 +1618,49 @@ SourceHook::CallClass<T> *SH_GET_CALLCLASS(T *p)
 @[$1,0,$a:
 // ********* Support for $1 arguments *********
 #define SH_DECL_HOOK$1(ifacetype, ifacefunc, attr, overload, rettype@[$2,1,$1:, param$2@]) \
-	SHINT_MAKE_GENERICSTUFF_BEGIN(ifacetype, ifacefunc, overload, (static_cast<rettype (ifacetype::*)(@[$2,1,$1|, :param$2@]) attr> \
-		(&ifacetype::ifacefunc))) \
-		typedef fastdelegate::FastDelegate<rettype@[$2,1,$1:, param$2@]> FD; \
-		MAKE_DELEG(rettype, (@[$2,1,$1|, :param$2 p$2@]), (@[$2,1,$1|, :p$2@])); \
-		virtual rettype Func(@[$2,1,$1|, :param$2 p$2@]) \
-		{ SH_HANDLEFUNC((@[$2,1,$1|, :param$2@]), (@[$2,1,$1|, :p$2@]), rettype); } \
-	SHINT_MAKE_GENERICSTUFF_END(ifacetype, ifacefunc, overload, \
-		(static_cast<rettype (ifacetype::*)(@[$2,1,$1|, :param$2@]) attr>(&ifacetype::ifacefunc))) \
-	\
-	const ::SourceHook::PassInfo __SourceHook_ParamInfos_##ifacetype##ifacefunc##overload[] = { {1, 0, 0}@[$2,1,$1:, __SH_GPI(param$2)@] }; \
-	const ::SourceHook::PassInfo::V2Info __SourceHook_ParamInfos2_##ifacetype##ifacefunc##overload[] = { __SH_EPI@[$2,1,$1:, __SH_EPI@] }; \
-	::SourceHook::ProtoInfo SH_FHCls(ifacetype, ifacefunc, overload)::ms_Proto = { $1, __SH_GPI(rettype), \
-		__SourceHook_ParamInfos_##ifacetype##ifacefunc##overload, 0, __SH_EPI, __SourceHook_ParamInfos2_##ifacetype##ifacefunc##overload };
+	SH_DECL_HOOK(ifacetype, ifacefunc, attr, overload, rettype@[$2,1,$1:, param$2@])
 
 #define SH_DECL_EXTERN$1(ifacetype, ifacefunc, attr, overload, rettype@[$2,1,$1:, param$2@]) \
 	SH_DECL_EXTERN(ifacetype, ifacefunc, attr, overload, rettype@[$2,1,$1|:, param$2@])
 
 #define SH_DECL_HOOK$1_void(ifacetype, ifacefunc, attr, overload@[$2,1,$1:, param$2@]) \
-	SHINT_MAKE_GENERICSTUFF_BEGIN(ifacetype, ifacefunc, overload, (static_cast<void (ifacetype::*)(@[$2,1,$1|, :param$2@]) attr> \
-		(&ifacetype::ifacefunc))) \
-		typedef fastdelegate::FastDelegate<void@[$1!=0:, @]@[$2,1,$1|, :param$2@]> FD; \
-		MAKE_DELEG_void((@[$2,1,$1|, :param$2 p$2@]), (@[$2,1,$1|, :p$2@])); \
-		virtual void Func(@[$2,1,$1|, :param$2 p$2@]) \
-		{ SH_HANDLEFUNC_void((@[$2,1,$1|, :param$2@]), (@[$2,1,$1|, :p$2@])); } \
-	SHINT_MAKE_GENERICSTUFF_END(ifacetype, ifacefunc, overload, \
-		(static_cast<void (ifacetype::*)(@[$2,1,$1|, :param$2@]) attr>(&ifacetype::ifacefunc))) \
-	\
-	const ::SourceHook::PassInfo __SourceHook_ParamInfos_##ifacetype##ifacefunc##overload[] = { {1, 0, 0}@[$2,1,$1:,__SH_GPI(param$2)@] }; \
-	const ::SourceHook::PassInfo::V2Info __SourceHook_ParamInfos2_##ifacetype##ifacefunc##overload[] = { __SH_EPI@[$2,1,$1:, __SH_EPI@] }; \
-	::SourceHook::ProtoInfo SH_FHCls(ifacetype, ifacefunc, overload)::ms_Proto = { $1, { 0, 0, 0 }, \
-		__SourceHook_ParamInfos_##ifacetype##ifacefunc##overload, 0, __SH_EPI, __SourceHook_ParamInfos2_##ifacetype##ifacefunc##overload };
+	SH_DECL_HOOK_void(ifacetype, ifacefunc, attr, overload@[$2,1,$1:, param$2@])
 
 #define SH_DECL_EXTERN$1_void(ifacetype, ifacefunc, attr, overload@[$2,1,$1:, param$2@]) \
 	SH_DECL_EXTERN_void(ifacetype, ifacefunc, attr, overload@[$1!=0:, @]@[$2,1,$1|, :param$2@])
 
 #define SH_DECL_HOOK$1_vafmt(ifacetype, ifacefunc, attr, overload, rettype@[$2,1,$1:, param$2@]) \
-	SHINT_MAKE_GENERICSTUFF_BEGIN(ifacetype, ifacefunc, overload, (static_cast<rettype (ifacetype::*)(@[$2,1,$1|, :param$2@]@[$1!=0:, @]const char *, ...) attr> \
-		(&ifacetype::ifacefunc))) \
-		typedef fastdelegate::FastDelegate<rettype, @[$2,1,$1|, :param$2@]@[$1!=0:, @]const char *> FD; \
-		MAKE_DELEG(rettype, (@[$2,1,$1|, :param$2 p$2@]@[$1!=0:, @]const char *px), (@[$2,1,$1|, :p$2@]@[$1!=0:, @]px)); \
-		virtual rettype Func(@[$2,1,$1|, :param$2 p$2@] @[$1!=0:, @]const char *fmt, ...) \
-		{ \
-			__SH_VAFMT_SEQ(fmt, buf); \
-			SH_HANDLEFUNC_vafmt((@[$2,1,$1:param$2, @]const char *, ...), (@[$2,1,$1|, :p$2@]@[$1!=0:, @]"%s", buf), (@[$2,1,$1|, :p$2@]@[$1!=0:, @]buf), rettype); \
-		} \
-	SHINT_MAKE_GENERICSTUFF_END(ifacetype, ifacefunc, overload, \
-		(static_cast<rettype (ifacetype::*)(@[$2,1,$1|, :param$2@]@[$1!=0:, @]const char *, ...) attr>(&ifacetype::ifacefunc))) \
-	\
-	const ::SourceHook::PassInfo __SourceHook_ParamInfos_##ifacetype##ifacefunc##overload[] = { {1, 0, 0}@[$2,1,$1:, __SH_GPI(param$2)@] }; \
-	const ::SourceHook::PassInfo::V2Info __SourceHook_ParamInfos2_##ifacetype##ifacefunc##overload[] = { __SH_EPI@[$2,1,$1:, __SH_EPI@] }; \
-	::SourceHook::ProtoInfo SH_FHCls(ifacetype, ifacefunc, overload)::ms_Proto = { $1, __SH_GPI(rettype), \
-		__SourceHook_ParamInfos_##ifacetype##ifacefunc##overload, 0, __SH_EPI, __SourceHook_ParamInfos2_##ifacetype##ifacefunc##overload };
+	SH_DECL_HOOK_vafmt(ifacetype, ifacefunc, attr, overload, rettype@[$2,1,$1:, param$2@])
 
 #define SH_DECL_EXTERN$1_vafmt(ifacetype, ifacefunc, attr, overload, rettype@[$2,1,$1:, param$2@]) \
 	SH_DECL_EXTERN_vafmt(ifacetype, ifacefunc, attr, overload, rettype@[$1!=0:, @]@[$2,1,$1|, :param$2@])
 
 #define SH_DECL_HOOK$1_void_vafmt(ifacetype, ifacefunc, attr, overload@[$2,1,$1:, param$2@]) \
-	SHINT_MAKE_GENERICSTUFF_BEGIN(ifacetype, ifacefunc, overload, (static_cast<void (ifacetype::*)(@[$2,1,$1|, :param$2@]@[$1!=0:, @]const char *, ...) attr> \
-		(&ifacetype::ifacefunc))) \
-		typedef fastdelegate::FastDelegate<void, @[$2,1,$1|, :param$2@]@[$1!=0:, @]const char *> FD; \
-		MAKE_DELEG_void((@[$2,1,$1|, :param$2 p$2@]@[$1!=0:, @]const char *px), (@[$2,1,$1|, :p$2@]@[$1!=0:, @]px)); \
-		virtual void Func(@[$2,1,$1|, :param$2 p$2@]@[$1!=0:, @]const char *fmt, ...) \
-		{ \
-			__SH_VAFMT_SEQ(fmt, buf); \
-			SH_HANDLEFUNC_void_vafmt((@[$2,1,$1:param$2, @]const char *, ...), (@[$2,1,$1|, :p$2@]@[$1!=0:, @]"%s", buf), (@[$2,1,$1|, :p$2@]@[$1!=0:, @]buf)); \
-		} \
-	SHINT_MAKE_GENERICSTUFF_END(ifacetype, ifacefunc, overload, \
-		(static_cast<void (ifacetype::*)(@[$2,1,$1|, :param$2@]@[$1!=0:, @]const char *, ...) attr>(&ifacetype::ifacefunc))) \
-	\
-	const ::SourceHook::PassInfo __SourceHook_ParamInfos_##ifacetype##ifacefunc##overload[] = { {1, 0, 0}@[$2,1,$1:, __SH_GPI(param$2)@] }; \
-	const ::SourceHook::PassInfo::V2Info __SourceHook_ParamInfos2_##ifacetype##ifacefunc##overload[] = { __SH_EPI@[$2,1,$1:, __SH_EPI@] }; \
-	::SourceHook::ProtoInfo SH_FHCls(ifacetype, ifacefunc, overload)::ms_Proto = { $1, { 0, 0, 0 }, \
-		__SourceHook_ParamInfos_##ifacetype##ifacefunc##overload, 0, __SH_EPI, __SourceHook_ParamInfos2_##ifacetype##ifacefunc##overload };
+	SH_DECL_HOOK_void_vafmt(ifacetype, ifacefunc, attr, overload@[$2,1,$1:, param$2@])
 
 #define SH_DECL_EXTERN$1_void_vafmt(ifacetype, ifacefunc, attr, overload@[$2,1,$1:, param$2@]) \
 	SH_DECL_EXTERN_void_vafmt(ifacetype, ifacefunc, attr, overload@[$1!=0:, @]@[$2,1,$1|, :param$2@])
 
 #define SH_DECL_MANUALHOOK$1(hookname, vtblidx, vtbloffs, thisptroffs, rettype@[$2,1,$1:, param$2@]) \
-	SHINT_MAKE_GENERICSTUFF_BEGIN_MANUAL(hookname, vtbloffs, vtblidx, thisptroffs) \
-		typedef fastdelegate::FastDelegate<rettype@[$1!=0:, @]@[$2,1,$1|, :param$2@]> FD; \
-		MAKE_DELEG(rettype, (@[$2,1,$1|, :param$2 p$2@]), (@[$2,1,$1|, :p$2@])); \
-		virtual rettype Func(@[$2,1,$1|, :param$2 p$2@]) \
-		{ SH_HANDLEFUNC((@[$2,1,$1|, :param$2@]), (@[$2,1,$1|, :p$2@]), rettype); } \
-		typedef rettype(::SourceHook::EmptyClass::*ECMFP)(@[$2,1,$1|, :param$2@]); \
-		typedef SourceHook::ExecutableClassN< ::SourceHook::EmptyClass, ECMFP, rettype@[$2,1,$1:, param$2@] > CallEC; \
-		typedef rettype RetType; \
-	SHINT_MAKE_GENERICSTUFF_END_MANUAL(hookname, vtbloffs, vtblidx, thisptroffs) \
-	\
-	const ::SourceHook::PassInfo __SourceHook_ParamInfosM_##hookname[] = { {1, 0, 0}@[$2,1,$1:, __SH_GPI(param$2)@] }; \
-	const ::SourceHook::PassInfo::V2Info __SourceHook_ParamInfos2M_##hookname[] = { __SH_EPI@[$2,1,$1:, __SH_EPI@] }; \
-	::SourceHook::ProtoInfo SH_MFHCls(hookname)::ms_Proto = { $1, __SH_GPI(rettype), \
-		__SourceHook_ParamInfosM_##hookname, 0, __SH_EPI, __SourceHook_ParamInfos2M_##hookname }; \
-	void __SoureceHook_FHM_SetOverrideResult##hookname(::SourceHook::ISourceHook *shptr, rettype value) \
-	{ \
-		::SourceHook::SetOverrideResult<SH_MFHCls(hookname)::RetType>()(shptr, value); \
-	}
+	SH_DECL_MANUALHOOK(hookname, vtblidx, vtbloffs, thisptroffs, rettype@[$2,1,$1:, param$2@])
 
 #define SH_DECL_MANUALEXTERN$1(hookname, rettype@[$2,1,$1:, param$2@]) \
 	SH_DECL_MANUALEXTERN(hookname, rettype@[$2,1,$1|:, param$2@])
 
 #define SH_DECL_MANUALHOOK$1_vafmt(hookname, vtblidx, vtbloffs, thisptroffs, rettype@[$2,1,$1:, param$2@]) \
-	SHINT_MAKE_GENERICSTUFF_BEGIN_MANUAL(hookname, vtbloffs, vtblidx, thisptroffs) \
-		typedef fastdelegate::FastDelegate<rettype, @[$2,1,$1:param$2, @]const char *> FD; \
-		MAKE_DELEG(rettype, (@[$2,1,$1:param$2 p$2, @]const char *px), (@[$2,1,$1:p$2, @]px)); \
-		virtual rettype Func(@[$2,1,$1:param$2 p$2, @]const char *fmt, ...) \
-		{ \
-			__SH_VAFMT_SEQ(fmt, buf); \
-			SH_HANDLEFUNC_vafmt((@[$2,1,$1:param$2, @]const char *, ...), (@[$2,1,$1|, :p$2@]@[$1!=0:, @]"%s", buf), (@[$2,1,$1|, :p$2@]@[$1!=0:, @]buf), rettype); \
-		} \
-		typedef rettype(::SourceHook::EmptyClass::*ECMFP)(@[$2,1,$1:param$2, @]const char *, ...); \
-		typedef SourceHook::ExecutableClassN< ::SourceHook::EmptyClass, ECMFP, rettype@[$2,1,$1:, param$2@], const char * > CallEC; \
-		typedef rettype RetType; \
-	SHINT_MAKE_GENERICSTUFF_END_MANUAL(hookname, vtbloffs, vtblidx, thisptroffs) \
-	\
-	const ::SourceHook::PassInfo __SourceHook_ParamInfosM_##hookname[] = { {1, 0, 0}@[$2,1,$1:, __SH_GPI(param$2)@] }; \
-	const ::SourceHook::PassInfo::V2Info __SourceHook_ParamInfos2M_##hookname[] = { __SH_EPI@[$2,1,$1:, __SH_EPI@] }; \
-	::SourceHook::ProtoInfo SH_MFHCls(hookname)::ms_Proto = { $1, __SH_GPI(rettype), \
-		__SourceHook_ParamInfosM_##hookname, 0, __SH_EPI, __SourceHook_ParamInfos2M_##hookname }; \
-	void __SoureceHook_FHM_SetOverrideResult##hookname(::SourceHook::ISourceHook *shptr, rettype value) \
-	{ \
-		::SourceHook::SetOverrideResult<SH_MFHCls(hookname)::RetType>()(shptr, value); \
-	}
+	SH_DECL_MANUALHOOK_vafmt(hookname, vtblidx, vtbloffs, thisptroffs, rettype@[$2,1,$1:, param$2@])
 
 #define SH_DECL_MANUALEXTERN$1_vafmt(hookname, rettype@[$2,1,$1:, param$2@]) \
 	SH_DECL_MANUALEXTERN_vafmt(hookname, rettype@[$1!=0:, @]@[$2,1,$1|, :param$2@])
 
 #define SH_DECL_MANUALHOOK$1_void(hookname, vtblidx, vtbloffs, thisptroffs@[$2,1,$1:, param$2@]) \
-	SHINT_MAKE_GENERICSTUFF_BEGIN_MANUAL(hookname, vtbloffs, vtblidx, thisptroffs) \
-		typedef fastdelegate::FastDelegate<void@[$1!=0:, @]@[$2,1,$1|, :param$2@]> FD; \
-		MAKE_DELEG_void((@[$2,1,$1|, :param$2 p$2@]), (@[$2,1,$1|, :p$2@])); \
-		virtual void Func(@[$2,1,$1|, :param$2 p$2@]) \
-		{ SH_HANDLEFUNC_void((@[$2,1,$1|, :param$2@]), (@[$2,1,$1|, :p$2@])); } \
-		typedef void(::SourceHook::EmptyClass::*ECMFP)(@[$2,1,$1|, :param$2@]); \
-		typedef SourceHook::ExecutableClassN<SourceHook::EmptyClass, ECMFP, void@[$2,1,$1:, param$2@]> CallEC; \
-	SHINT_MAKE_GENERICSTUFF_END_MANUAL(hookname, vtbloffs, vtblidx, thisptroffs) \
-	\
-	const ::SourceHook::PassInfo __SourceHook_ParamInfosM_##hookname[] = { {1, 0, 0}@[$2,1,$1:, __SH_GPI(param$2)@] }; \
-	const ::SourceHook::PassInfo::V2Info __SourceHook_ParamInfos2M_##hookname[] = { __SH_EPI@[$2,1,$1:, __SH_EPI@] }; \
-	::SourceHook::ProtoInfo SH_MFHCls(hookname)::ms_Proto = { $1, { 0, 0, 0 }, \
-		__SourceHook_ParamInfosM_##hookname	, 0, __SH_EPI, __SourceHook_ParamInfos2M_##hookname };
+	SH_DECL_MANUALHOOK_void(hookname, vtblidx, vtbloffs, thisptroffs@[$2,1,$1:, param$2@])
 
 #define SH_DECL_MANUALEXTERN$1_void(hookname@[$2,1,$1:, param$2@]) \
 	SH_DECL_MANUALEXTERN_void(hookname@[$1!=0:, @]@[$2,1,$1|, :param$2@])
 
 #define SH_DECL_MANUALHOOK$1_void_vafmt(hookname, vtblidx, vtbloffs, thisptroffs@[$2,1,$1:, param$2@]) \
-	SHINT_MAKE_GENERICSTUFF_BEGIN_MANUAL(hookname, vtbloffs, vtblidx, thisptroffs) \
-		typedef fastdelegate::FastDelegate<void, @[$2,1,$1:param$2, @]const char *> FD; \
-		MAKE_DELEG_void((@[$2,1,$1:param$2 p$2, @]const char *px), (@[$2,1,$1:p$2, @]px)); \
-		virtual void Func(@[$2,1,$1:param$2 p$2, @]const char *fmt, ...) \
-		{ \
-			__SH_VAFMT_SEQ(fmt, buf); \
-			SH_HANDLEFUNC_void_vafmt((@[$2,1,$1:param$2, @]const char *, ...), (@[$2,1,$1|, :p$2@]@[$1!=0:, @]"%s", buf), (@[$2,1,$1|, :p$2@]@[$1!=0:, @]buf)); \
-		} \
-		typedef void(::SourceHook::EmptyClass::*ECMFP)(@[$2,1,$1:param$2, @]const char *, ...); \
-		typedef SourceHook::ExecutableClassN< ::SourceHook::EmptyClass, ECMFP, void@[$2,1,$1:, param$2@], const char * > CallEC; \
-	SHINT_MAKE_GENERICSTUFF_END_MANUAL(hookname, vtbloffs, vtblidx, thisptroffs) \
-	\
-	const ::SourceHook::PassInfo __SourceHook_ParamInfosM_##hookname[] = { {1, 0, 0}@[$2,1,$1:, __SH_GPI(param$2)@] }; \
-	const ::SourceHook::PassInfo::V2Info __SourceHook_ParamInfos2M_##hookname[] = { __SH_EPI@[$2,1,$1:, __SH_EPI@] }; \
-	::SourceHook::ProtoInfo SH_MFHCls(hookname)::ms_Proto = { $1, { 0, 0, 0 }, \
-		__SourceHook_ParamInfosM_##hookname	, 0, __SH_EPI, __SourceHook_ParamInfos2M_##hookname };
+	SH_DECL_MANUALHOOK_void_vafmt(hookname, vtblidx, vtbloffs, thisptroffs@[$2,1,$1:, param$2@])
 
 #define SH_DECL_MANUALEXTERN$1_void_vafmt(hookname@[$2,1,$1:, param$2@]) \
 	SH_DECL_MANUALEXTERN_void_vafmt(hookname@[$1!=0:, @]@[$2,1,$1|, :param$2@])
@@ -1513,7 +1830,12 @@ namespace SourceHook
 	{
 		void operator()(ISourceHook *shptr, T res)
 		{
-			*reinterpret_cast<T*>(shptr->GetOverrideRetPtr()) = res;
+			bool construct;
+			void *overrideptr = shptr->PrepareOverrideRet(&construct);
+			if (construct)
+				new (overrideptr) T(res);
+			else
+				*reinterpret_cast<T*>(overrideptr) = res;
 		}
 	};
 	template <class T> struct OverrideFunctor<T&>
@@ -1521,7 +1843,13 @@ namespace SourceHook
 		void operator()(ISourceHook *shptr, T &res)
 		{
 			// overrideretptr points to ReferenceCarrier<T&>
-			*reinterpret_cast<typename ReferenceCarrier<T&>::type *>(shptr->GetOverrideRetPtr()) = res;
+			typedef typename ReferenceCarrier<T&>::type carrier;
+			bool construct;
+			void *overrideptr = shptr->PrepareOverrideRet(&construct);
+			if (construct)
+				new (overrideptr) carrier(res);
+			else
+				*reinterpret_cast<carrier *>(overrideptr) = res;
 		}
 	};
 
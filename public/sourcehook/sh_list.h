@@ -16,6 +16,10 @@
 
 namespace SourceHook
 {
+	// Default base of list nodes: plain new / delete
+	template <class Node> class CListNodeNew
+	{
+	};
 
 	//This class is from CSDM for AMX Mod X
 	/*
@@ -40,13 +44,14 @@ namespace SourceHook
 			node2->next = m_Head
 			node2->prev = node1
 	*/
-	template <class T>
+	template <class T, template <class> class NodeAlloc = CListNodeNew>
 	class List
 	{
 	public:
 		class iterator;
 		friend class iterator;
-		class ListNode
+		// NodeAlloc can route new / delete of the nodes elsewhere; the sentinel is always malloc'd
+		class ListNode : public NodeAlloc<ListNode>
 		{
 		public:
 			ListNode(const T & o) : obj(o) { };
@@ -1,13 +1,16 @@
 #ifndef __SH_PAGEALLOC_H__
 #define __SH_PAGEALLOC_H__
 
+#include <string.h>
 #include "sh_list.h"
+#include "sh_vector.h"
 #include "sh_memory.h"
 
 # if SH_XP == SH_XP_WINAPI
 #		include <windows.h>
 # elif SH_XP == SH_XP_POSIX
 #		include <sys/mman.h>
+#		include <sys/syscall.h>
 #		include <unistd.h>
 # else
 #		error Unsupported OS/Compiler
@@ -30,6 +33,15 @@ namespace SourceHook
 	IMPORTANT: the memory that Alloc() returns is not a in a defined state!
 	It could be in read+exec OR read+write mode.
 	-> call SetRE() or SetRW() before using allocated memory!
+
+	Arena mode (dualMapped in the constructor): every region is shared memory mapped twice, once
+	read+exec and once read+write. Alloc() returns addresses in the exec view; write the code through
+	GetWritable() instead of flipping the protection, so SetRE()/SetRW() don't have to issue syscalls
+	anymore and code on the same page keeps running on other threads. Small blocks are handed out from
+	per size class free lists there, which are refilled a page at a time.
+	Where the system doesn't let us map memory twice, regions fall back to a single mapping; then
+	GetWritable() returns its argument and SetRE()/SetRW() work as usual. So always use the
+	SetRW(); write through GetWritable(); SetRE(); sequence.
 	*/
 	class CPageAlloc
 	{
@@ -57,6 +69,7 @@ namespace SourceHook
 			size_t minAlignment;
 			AUList allocUnits;
 			bool isRE;						// true: RE, otherwise: RW
+			void *rwPtr;					// read+write view in arena mode; NULL if single mapped
 
 			void CheckGap(size_t gap_begin, size_t gap_end, size_t reqsize,
 				size_t &smallestgap_pos, size_t &smallestgap_size, size_t &outAlignBytes)
@@ -141,6 +154,13 @@ namespace SourceHook
 
 			void DebugCleanMemory(unsigned char* start, size_t size)
 			{
+				if (rwPtr)
+				{
+					memset(reinterpret_cast<unsigned char*>(rwPtr) + (start - reinterpret_cast<unsigned char*>(startPtr)),
+						0xCC, size);
+					return;
+				}
+
 				bool wasRE = isRE;
 				if (isRE)
 				{
@@ -164,38 +184,131 @@ namespace SourceHook
 				return addr >= startPtr && addr < reinterpret_cast<void*>(reinterpret_cast<char*>(startPtr) + size);
 			}
 
+			void *GetWritable(void *addr)
+			{
+				if (!rwPtr)
+					return addr;
+				return reinterpret_cast<char*>(rwPtr) + (reinterpret_cast<char*>(addr) - reinterpret_cast<char*>(startPtr));
+			}
+
 			void FreeRegion()
 			{
 #if SH_XP == SH_XP_POSIX
+				if (rwPtr)
+					munmap(rwPtr, size);
 				munmap(startPtr, size);
 #elif SH_XP == SH_XP_WINAPI
-				VirtualFree(startPtr, 0, MEM_RELEASE);
+				if (rwPtr)
+				{
+					UnmapViewOfFile(rwPtr);
+					UnmapViewOfFile(startPtr);
+				}
+				else
+				{
+					VirtualFree(startPtr, 0, MEM_RELEASE);
+				}
 #endif
 			}
 
+			// The exec view never changes in arena mode
 			void SetRE()
 			{
-				SetMemAccess(startPtr, size, SH_MEM_READ | SH_MEM_EXEC);
+				if (!rwPtr)
+					SetMemAccess(startPtr, size, SH_MEM_READ | SH_MEM_EXEC);
 				isRE = true;
 			}
 
 			void SetRW()
 			{
-				SetMemAccess(startPtr, size, SH_MEM_READ | SH_MEM_WRITE);
+				if (!rwPtr)
+					SetMemAccess(startPtr, size, SH_MEM_READ | SH_MEM_WRITE);
 				isRE = false;
 			}
 		};
 
+		// Small blocks (arena mode only): block sizes are 16, 32 and 64 bytes
+		static const size_t NUM_SIZE_CLASSES = 3;
+		static const size_t MAX_SMALL_SIZE = 64;
+
+		struct SmallChunk
+		{
+			void *startPtr;
+			size_t sizeClass;
+		};
+
 		typedef List<AllocatedRegion> ARList;
 
 		size_t m_MinAlignment;
 		size_t m_PageSize;
+		bool m_DualMapped;
 		ARList m_Regions;
 
+		CVector<void*> m_SmallFree[NUM_SIZE_CLASSES];
+		CVector<SmallChunk> m_SmallChunks;
+
+		// Maps the region twice; returns false if the system doesn't let us
+		bool MapDual(AllocatedRegion &region)
+		{
+#if SH_SYS == SH_SYS_LINUX && defined SYS_memfd_create
+			// 1 = MFD_CLOEXEC; the fd is closed right away anyway, the views keep the memory
+			int fd = static_cast<int>(syscall(SYS_memfd_create, "sourcehook", 1));
+			if (fd < 0)
+				return false;
+
+			void *rx = MAP_FAILED;
+			void *rw = MAP_FAILED;
+			if (ftruncate(fd, region.size) == 0)
+			{
+				rw = mmap(0, region.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+				rx = mmap(0, region.size, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+			}
+			close(fd);
+
+			if (rw == MAP_FAILED || rx == MAP_FAILED)
+			{
+				if (rw != MAP_FAILED)
+					munmap(rw, region.size);
+				if (rx != MAP_FAILED)
+					munmap(rx, region.size);
+				return false;
+			}
+
+			region.startPtr = rx;
+			region.rwPtr = rw;
+			return true;
+#elif SH_XP == SH_XP_WINAPI
+			unsigned long long size = region.size;
+			HANDLE mapping = CreateFileMapping(INVALID_HANDLE_VALUE, NULL, PAGE_EXECUTE_READWRITE | SEC_COMMIT,
+				static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), NULL);
+			if (mapping == NULL)
+				return false;
+
+			void *rw = MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, region.size);
+			void *rx = MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_EXECUTE, 0, 0, region.size);
+			CloseHandle(mapping);
+
+			if (rw == NULL || rx == NULL)
+			{
+				if (rw)
+					UnmapViewOfFile(rw);
+				if (rx)
+					UnmapViewOfFile(rx);
+				return false;
+			}
+
+			region.startPtr = rx;
+			region.rwPtr = rw;
+			return true;
+#else
+			return false;
+#endif
+		}
+
 		bool AddRegion(size_t minSize, bool isolated)
 		{
 			AllocatedRegion newRegion;
 			newRegion.startPtr = 0;
+			newRegion.rwPtr = NULL;
 			newRegion.isolated = isolated;
 			newRegion.minAlignment = m_MinAlignment;
 
@@ -205,11 +318,20 @@ namespace SourceHook
 			if (newRegion.size < minSize)
 				newRegion.size += m_PageSize;
 
+			if (m_DualMapped && MapDual(newRegion))
+			{
+				newRegion.isRE = true;
+				m_Regions.push_back(newRegion);
+				return true;
+			}
+
 #if SH_XP == SH_XP_POSIX
 # if !defined MAP_ANONYMOUS
 #  define MAP_ANONYMOUS MAP_ANON
 # endif
 			newRegion.startPtr = mmap(0, newRegion.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (newRegion.startPtr == MAP_FAILED)
+				newRegion.startPtr = 0;
 #elif SH_XP == SH_XP_WINAPI
 			newRegion.startPtr = VirtualAlloc(NULL, newRegion.size, MEM_COMMIT, PAGE_READWRITE);
 #endif
@@ -248,8 +370,71 @@ namespace SourceHook
 			return tmp ? addr : NULL;
 		}
 
+		// Returns -1 if size doesn't fit into a size class
+		int GetSizeClass(size_t size)
+		{
+			size_t blockSize = 16;
+			for (size_t sizeClass = 0; sizeClass < NUM_SIZE_CLASSES; ++sizeClass, blockSize *= 2)
+			{
+				if (size <= blockSize && m_MinAlignment <= blockSize)
+					return static_cast<int>(sizeClass);
+			}
+			return -1;
+		}
+
+		void *AllocSmall(size_t sizeClass)
+		{
+			CVector<void*> &freeList = m_SmallFree[sizeClass];
+			if (freeList.empty())
+			{
+				// Carve a new page into blocks; block sizes are powers of two >= m_MinAlignment,
+				// so they stay aligned
+				char *chunk = reinterpret_cast<char*>(AllocPriv(m_PageSize, false));
+				if (!chunk)
+					return NULL;
+
+				SmallChunk newChunk;
+				newChunk.startPtr = chunk;
+				newChunk.sizeClass = sizeClass;
+				m_SmallChunks.push_back(newChunk);
+
+				// Hand out blocks in ascending order
+				size_t blockSize = static_cast<size_t>(16) << sizeClass;
+				for (size_t offs = m_PageSize; offs >= blockSize; offs -= blockSize)
+					freeList.push_back(chunk + offs - blockSize);
+			}
+
+			void *block = freeList[freeList.size() - 1];
+			freeList.pop_back();
+			return block;
+		}
+
+		bool FreeSmall(void *ptr)
+		{
+			for (size_t i = 0; i < m_SmallChunks.size(); ++i)
+			{
+				char *start = reinterpret_cast<char*>(m_SmallChunks[i].startPtr);
+				if (ptr >= start && ptr < start + m_PageSize)
+				{
+					size_t blockSize = static_cast<size_t>(16) << m_SmallChunks[i].sizeClass;
+					for (ARList::iterator iter = m_Regions.begin(); iter != m_Regions.end(); ++iter)
+					{
+						if (iter->Contains(ptr))
+						{
+							iter->DebugCleanMemory(reinterpret_cast<unsigned char*>(ptr), blockSize);
+							break;
+						}
+					}
+					m_SmallFree[m_SmallChunks[i].sizeClass].push_back(ptr);
+					return true;
+				}
+			}
+			return false;
+		}
+
 	public:
-		CPageAlloc(size_t minAlignment = 4 /* power of 2 */ ) : m_MinAlignment(minAlignment)
+		CPageAlloc(size_t minAlignment = 4 /* power of 2 */, bool dualMapped = false) : m_MinAlignment(minAlignment),
+			m_DualMapped(dualMapped)
 		{
 #if SH_XP == SH_XP_POSIX
 			m_PageSize = sysconf(_SC_PAGESIZE);
@@ -271,6 +456,12 @@ namespace SourceHook
 
 		void *Alloc(size_t size)
 		{
+			if (m_DualMapped && size <= MAX_SMALL_SIZE)
+			{
+				int sizeClass = GetSizeClass(size);
+				if (sizeClass >= 0)
+					return AllocSmall(sizeClass);
+			}
 			return AllocPriv(size, false);
 		}
 
@@ -281,6 +472,10 @@ namespace SourceHook
 
 		void Free(void *ptr)
 		{
+			// Small blocks stay with their size class; the pages are only given back at destruction
+			if (m_DualMapped && FreeSmall(ptr))
+				return;
+
 			for (ARList::iterator iter = m_Regions.begin(); iter != m_Regions.end(); ++iter)
 			{
 				if (iter->TryFree(ptr))
@@ -319,6 +514,17 @@ namespace SourceHook
 			}
 		}
 
+		// Where the code at ptr has to be written to
+		void *GetWritable(void *ptr)
+		{
+			for (ARList::iterator iter = m_Regions.begin(); iter != m_Regions.end(); ++iter)
+			{
+				if (iter->Contains(ptr))
+					return iter->GetWritable(ptr);
+			}
+			return ptr;
+		}
+
 		size_t GetPageSize()
 		{
 			return m_PageSize;
@@ -0,0 +1,200 @@
+/* ======== SourceHook ========
+* Copyright (C) 2004-2010 Metamod:Source Development Team
+* No warranties of any kind
+*
+* License: zlib/libpng
+*
+* Author(s): Pavol "PM OnoTo" Marko
+* ============================
+*/
+
+#ifndef __SH_SLABALLOC_H__
+#define __SH_SLABALLOC_H__
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <atomic>
+#include "sh_list.h"
+
+namespace SourceHook
+{
+	/*
+	Type-segregated slab allocator.
+
+	Every type gets its own pool. A pool carves fixed size slots out of ~4K slabs and
+	keeps freed slots in a free list, so objects which are created and destroyed all the
+	time (list nodes, hooks, cleanup tasks) don't go through malloc every time and all
+	end up next to each other.
+
+	The pool state is a plain static without a constructor or destructor: it works before
+	static initialization and after static destruction, in whatever order the objects
+	using it are destroyed. Once the last object of a pool is freed, all slabs but one
+	are given back; the one that stays keeps alloc/free cycles from going to malloc.
+
+	A pool is shared by everything in the module which allocates the same type, so it is
+	guarded by a spinlock. The pools are meant for SourceHook's own objects; the public
+	containers keep using plain new.
+	*/
+	template <class T> class CSlabAllocator
+	{
+		// Slots are aligned like malloc'd memory would be (at least on the platforms we care about)
+		static const size_t SLOT_ALIGN = 2 * sizeof(void*);
+		static const size_t SLOT_SIZE = (sizeof(T) + SLOT_ALIGN - 1) & ~(SLOT_ALIGN - 1);
+		static const size_t HEADER_SIZE = SLOT_ALIGN;
+		static const size_t SLAB_SIZE = 4096;
+		static const size_t SLOTS_PER_SLAB = (SLAB_SIZE - HEADER_SIZE) / SLOT_SIZE >= 8 ?
+			(SLAB_SIZE - HEADER_SIZE) / SLOT_SIZE : 8;
+
+		struct FreeSlot
+		{
+			FreeSlot *next;
+		};
+
+		struct Slab
+		{
+			Slab *next;
+		};
+
+		struct Pool
+		{
+			std::atomic_flag lock;
+			Slab *slabs;
+			FreeSlot *freeSlots;
+			size_t liveCount;
+		};
+
+		static Pool ms_Pool;
+
+		class AutoLock
+		{
+		public:
+			AutoLock()
+			{
+				while (ms_Pool.lock.test_and_set(std::memory_order_acquire))
+					;
+			}
+			~AutoLock()
+			{
+				ms_Pool.lock.clear(std::memory_order_release);
+			}
+		};
+
+		static void AddSlab()
+		{
+			Slab *slab = reinterpret_cast<Slab*>(malloc(HEADER_SIZE + SLOTS_PER_SLAB * SLOT_SIZE));
+			if (!slab)
+				return;
+
+			slab->next = ms_Pool.slabs;
+			ms_Pool.slabs = slab;
+
+			// Chain the slots backwards so they are handed out in address order
+			char *slots = reinterpret_cast<char*>(slab) + HEADER_SIZE;
+			for (size_t i = SLOTS_PER_SLAB; i > 0; --i)
+			{
+				FreeSlot *slot = reinterpret_cast<FreeSlot*>(slots + (i - 1) * SLOT_SIZE);
+				slot->next = ms_Pool.freeSlots;
+				ms_Pool.freeSlots = slot;
+			}
+		}
+
+		// Only called with no live objects: keeps the first slab, with all of its slots free
+		static void ReleaseSpareSlabs()
+		{
+			Slab *keep = ms_Pool.slabs;
+			if (!keep)
+				return;
+
+			Slab *slab = keep->next;
+			while (slab)
+			{
+				Slab *next = slab->next;
+				free(slab);
+				slab = next;
+			}
+			keep->next = NULL;
+
+			ms_Pool.freeSlots = NULL;
+			char *slots = reinterpret_cast<char*>(keep) + HEADER_SIZE;
+			for (size_t i = SLOTS_PER_SLAB; i > 0; --i)
+			{
+				FreeSlot *slot = reinterpret_cast<FreeSlot*>(slots + (i - 1) * SLOT_SIZE);
+				slot->next = ms_Pool.freeSlots;
+				ms_Pool.freeSlots = slot;
+			}
+		}
+	public:
+		static void *Alloc()
+		{
+			AutoLock lock;
+			if (!ms_Pool.freeSlots)
+			{
+				AddSlab();
+				if (!ms_Pool.freeSlots)
+					return NULL;
+			}
+
+			FreeSlot *slot = ms_Pool.freeSlots;
+			ms_Pool.freeSlots = slot->next;
+			++ms_Pool.liveCount;
+			return slot;
+		}
+
+		static void Free(void *ptr)
+		{
+			if (!ptr)
+				return;
+
+			AutoLock lock;
+			FreeSlot *slot = reinterpret_cast<FreeSlot*>(ptr);
+			slot->next = ms_Pool.freeSlots;
+			ms_Pool.freeSlots = slot;
+
+			if (--ms_Pool.liveCount == 0 && ms_Pool.slabs && ms_Pool.slabs->next)
+				ReleaseSpareSlabs();
+		}
+
+		static size_t GetLiveCount()
+		{
+			AutoLock lock;
+			return ms_Pool.liveCount;
+		}
+
+		static size_t GetSlabCount()
+		{
+			AutoLock lock;
+			size_t count = 0;
+			for (Slab *slab = ms_Pool.slabs; slab; slab = slab->next)
+				++count;
+			return count;
+		}
+	};
+
+	template <class T> typename CSlabAllocator<T>::Pool CSlabAllocator<T>::ms_Pool = { ATOMIC_FLAG_INIT };
+
+	// Derive from this to make new / delete of T go through T's slab pool.
+	// Derived classes which are bigger than T fall back to malloc.
+	template <class T> class CSlabAllocated
+	{
+	public:
+		static void *operator new(size_t size) noexcept
+		{
+			if (size != sizeof(T))
+				return malloc(size);
+			return CSlabAllocator<T>::Alloc();
+		}
+
+		static void operator delete(void *ptr, size_t size)
+		{
+			if (size != sizeof(T))
+				free(ptr);
+			else
+				CSlabAllocator<T>::Free(ptr);
+		}
+	};
+
+	// List whose nodes come from a slab pool
+	template <class T> using PooledList = List<T, CSlabAllocated>;
+}
+
+#endif
@@ -495,6 +495,49 @@ namespace SourceHook
 			}
 			return end();
 		}
+		/**
+		 * Looks the key up in its own bucket only; unlike find(), this does
+		 * not walk the whole table. Returns NULL if the key is not present.
+		 */
+		V * retrieve(const K & key)
+		{
+			size_t place = HashFunction(key) % m_numBuckets;
+			if (!m_Buckets[place])
+				return NULL;
+			typename List<THashNode *>::iterator iter;
+			for (iter=m_Buckets[place]->begin(); iter!=m_Buckets[place]->end(); iter++)
+			{
+				if (Compare((*iter)->key, key) == 0)
+					return &((*iter)->val);
+			}
+			return NULL;
+		}
+		/**
+		 * Bucket-local counterpart of erase(). Returns false if the key was not present.
+		 */
+		bool remove(const K & key)
+		{
+			size_t place = HashFunction(key) % m_numBuckets;
+			if (!m_Buckets[place])
+				return false;
+			typename List<THashNode *>::iterator iter;
+			for (iter=m_Buckets[place]->begin(); iter!=m_Buckets[place]->end(); iter++)
+			{
+				if (Compare((*iter)->key, key) == 0)
+				{
+					delete (*iter);
+					m_Buckets[place]->erase(iter);
+					if (m_Buckets[place]->empty())
+					{
+						delete m_Buckets[place];
+						m_Buckets[place] = NULL;
+						m_percentUsed -= (1.0f / (float)m_numBuckets);
+					}
+					return true;
+				}
+			}
+			return false;
+		}
 		template <typename U>
 		iterator FindAlt(const U & u)
 		{
@@ -39,46 +39,231 @@ namespace SourceHook
 			return -1;
 		return 0;
 	}
+	template<>
+	int HashFunction<void*>(void * const & k)
+	{
+		// Objects are at least pointer-aligned, so the low bits carry no information
+		uintptr_t addr = reinterpret_cast<uintptr_t>(k);
+		return static_cast<int>((addr >> 3) ^ (addr >> 17));
+	}
+	template<>
+	int Compare<void*>(void * const & k1, void * const & k2)
+	{
+		if (k1 == k2)
+			return 0;
+		if (k1 > k2)
+			return 1;
+		return -1;
+	}
 
 	namespace Impl
 	{
+		//////////////////////////////////////////////////////////////////////////
+		// CHookArray
+		//////////////////////////////////////////////////////////////////////////
+
+		std::atomic<HookSerial> CHookArray::ms_LastVersion(0);
+		const CHookArray CHookArray::ms_Empty(0, 0);
+
+		CHookArray *CHookArray::Create(const PooledList<CHook> &hooks)
+		{
+			size_t count = 0;
+			for (PooledList<CHook>::iterator iter = hooks.begin(); iter != hooks.end(); ++iter)
+			{
+				if (!iter->IsPaused())
+					++count;
+			}
+
+			void *mem = malloc(sizeof(CHookArray) + count * sizeof(Entry));
+			CHookArray *array = new (mem) CHookArray(++ms_LastVersion, count);
+
+			Entry *entries = array->GetEntries();
+			for (PooledList<CHook>::iterator iter = hooks.begin(); iter != hooks.end(); ++iter)
+			{
+				if (iter->IsPaused())
+					continue;
+
+				Entry &entry = *entries++;
+				entry.m_pHandler = iter->GetHandler();
+				entry.m_ThisPointerOffset = iter->GetThisPointerOffset();
+				entry.m_HookID = iter->GetID();
+				entry.m_OwnerPlugin = iter->GetOwnerPlugin();
+				entry.m_Serial = iter->GetSerial();
+				entry.m_pFilter = iter->GetFilter();
+			}
+			return array;
+		}
+
+		void CHookArray::Free(void *array)
+		{
+			// Entries and header are trivially destructible
+			if (array != &ms_Empty)
+				free(array);
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// CIface
+		//////////////////////////////////////////////////////////////////////////
+
+		CIface::CIface(void *ptr, CEpochManager *pEpochs)
+			: m_Ptr(ptr), m_pEpochs(pEpochs), m_pPreHookArray(&CHookArray::ms_Empty),
+			m_pPostHookArray(&CHookArray::ms_Empty)
+		{
+		}
+
+		CIface::~CIface()
+		{
+			// Nobody can see us anymore (we have been retired) -> no need to retire anything
+			CHookArray::Free(const_cast<CHookArray*>(m_pPreHookArray.load(std::memory_order_relaxed)));
+			CHookArray::Free(const_cast<CHookArray*>(m_pPostHookArray.load(std::memory_order_relaxed)));
+
+			// Before getting deleted, delete all remaining hook handlers
+			for (PooledList<CHook>::iterator iter = m_PreHooks.begin(); iter != m_PreHooks.end(); ++iter)
+			{
+				iter->GetHandler()->DeleteThis();
+				delete iter->GetFilter();
+			}
+
+			for (PooledList<CHook>::iterator iter = m_PostHooks.begin(); iter != m_PostHooks.end(); ++iter)
+			{
+				iter->GetHandler()->DeleteThis();
+				delete iter->GetFilter();
+			}
+		}
+
+		void CIface::PublishArray(std::atomic<const CHookArray *> &array, const PooledList<CHook> &hooks)
+		{
+			const CHookArray *newArray = hooks.empty() ? &CHookArray::ms_Empty : CHookArray::Create(hooks);
+			const CHookArray *oldArray = array.exchange(newArray, std::memory_order_acq_rel);
+			if (oldArray != &CHookArray::ms_Empty)
+				m_pEpochs->Retire(&CHookArray::Free, const_cast<CHookArray*>(oldArray));
+		}
+
+		// Has to be called after a hook in the list was modified (ie. paused / unpaused)
+		void CIface::HookListChanged(bool post)
+		{
+			if (post)
+				PublishArray(m_pPostHookArray, m_PostHooks);
+			else
+				PublishArray(m_pPreHookArray, m_PreHooks);
+		}
+
 		//////////////////////////////////////////////////////////////////////////
 		// CVfnPtrList
 		//////////////////////////////////////////////////////////////////////////
 
-		CVfnPtr *CVfnPtrList::GetVfnPtr(void *vfnptr)
+		CVfnPtr *CVfnPtrList::GetVfnPtr(void *vfnptr, CEpochManager *pEpochs, CPatchBatch *pBatch)
 		{
 			iterator iter = find(vfnptr);
 			if (iter == end())
 			{
 				// No vfnptr info object found
 				// --> create a new one
-				CVfnPtr newVfnPtr(vfnptr);
-				if (newVfnPtr.Init())
+				CVfnPtr *newVfnPtr = new CVfnPtr(vfnptr, pEpochs, pBatch);
+				if (newVfnPtr->Init())
 				{
 					push_back(newVfnPtr);
 
-					return &(back());
+					iter = PooledList<CVfnPtr*>::end();
+					--iter;
+					m_Index[vfnptr] = iter;
+					return newVfnPtr;
 				}
 				else
 				{
 					// Initialization failed.
+					delete newVfnPtr;
 					return NULL;
 				}
 			}
 			else
 			{
-				return &(*iter);
+				return *iter;
 			}
 		}
 
+		CVfnPtrList::iterator CVfnPtrList::find(void *vfnptr)
+		{
+			iterator *pIter = m_Index.retrieve(vfnptr);
+			return pIter ? *pIter : end();
+		}
+
+		CVfnPtrList::iterator CVfnPtrList::erase(iterator where)
+		{
+			m_Index.remove((*where)->GetPtr());
+			return PooledList<CVfnPtr*>::erase(where);
+		}
+
 		//////////////////////////////////////////////////////////////////////////
 		// CSourceHookImpl
 		//////////////////////////////////////////////////////////////////////////
 		
 
-		CSourceHookImpl::CSourceHookImpl()
+		CSourceHookImpl::CSourceHookImpl() : m_LastHookSerial(0), m_HasPendingUnloads(false),
+			m_pActiveProfiler(NULL), m_BatchDepth(0), m_BatchHookManPlug(0), m_BatchHookManPubFunc(NULL),
+			m_BatchHookMan(NULL)
+		{
+		}
+
+		CVfnPtr *CSourceHookImpl::FindVfnPtr(IHookManagerInfo *hi, void *vfnptr)
 		{
+			// The hook manager clears its hi pointer when its last vfnptr is removed,
+			// which another thread may have just done
+			return hi ? static_cast<CHookManager*>(hi)->FindVfnPtr(vfnptr) : NULL;
+		}
+
+		void *CSourceHookImpl::GetCurrentVfnPtrEntry(void *vfnptr)
+		{
+			// A hook func which was entered before its vfnptr got removed on another thread.
+			// The vtable entry has been patched back before the vfnptr was unpublished,
+			// so it holds the original function or the hook func of the next hook manager.
+			return *reinterpret_cast<void**>(vfnptr);
+		}
+
+		static void RunCleanupTask(void *task)
+		{
+			reinterpret_cast<ICleanupTask*>(task)->CleanupAndDeleteThis();
+		}
+
+		static void DeleteHandler(void *handler)
+		{
+			reinterpret_cast<ISHDelegate*>(handler)->DeleteThis();
+		}
+
+		static void DeleteFilter(void *filter)
+		{
+			delete reinterpret_cast<CHookFilter*>(filter);
+		}
+
+		// Returns NULL if the filter can't be applied to the hook manager's function
+		static CHookFilter *CompileHookFilter(const HookFilter &filter, const CHookManager &hookMan)
+		{
+			// Only hook funcs which pass their parameters to SetupHookLoopParams can evaluate filters
+			if (hookMan.GetVersion() < 2)
+				return NULL;
+
+			const CProto &proto = *hookMan.GetProto();
+			if (filter.param < 0 || filter.param >= proto.GetNumOfParams())
+				return NULL;
+			if (filter.numValues < 1 || filter.numValues > HookFilter::MaxValues)
+				return NULL;
+
+			const IntPassInfo &pi = proto.GetParam(filter.param);
+			if (!(pi.flags & PassInfo::PassFlag_ByVal) ||
+				(pi.size != 1 && pi.size != 2 && pi.size != 4 && pi.size != 8))
+			{
+				return NULL;
+			}
+
+			CHookFilter *pFilter = new CHookFilter;
+			pFilter->m_Param = filter.param;
+			pFilter->m_Size = pi.size;
+			pFilter->m_NumValues = filter.numValues;
+
+			unsigned long long mask = (pi.size == 8) ? ~0ULL : ((1ULL << (pi.size * 8)) - 1);
+			for (int i = 0; i < filter.numValues; ++i)
+				pFilter->m_Values[i] = filter.values[i] & mask;
+			return pFilter;
 		}
 		CSourceHookImpl::~CSourceHookImpl()
 		{
@@ -95,16 +280,260 @@ namespace SourceHook
 			return SH_IMPL_VERSION;
 		}
 
+		CHookManager *CSourceHookImpl::ResolveHookManager(Plugin plug, HookManagerPubFunc pubFunc)
+		{
+			// Hook storms tend to use the same hook manager over and over again
+			if (m_BatchDepth > 0 && m_BatchHookMan != NULL && m_BatchHookManPlug == plug &&
+				m_BatchHookManPubFunc == pubFunc)
+			{
+				return m_BatchHookMan;
+			}
+
+			CHookManager hookManager(plug, pubFunc);
+			if (!hookManager)
+				return NULL;
+
+			CHookManager *pHookMan = m_HookManList.GetHookMan(hookManager);
+			if (m_BatchDepth > 0)
+			{
+				m_BatchHookManPlug = plug;
+				m_BatchHookManPubFunc = pubFunc;
+				m_BatchHookMan = pHookMan;
+			}
+			return pHookMan;
+		}
+
+		void CSourceHookImpl::BeginHookBatch()
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_WriteLock);
+
+			if (m_BatchDepth++ == 0)
+				m_PatchBatch.Begin();
+		}
+
+		void CSourceHookImpl::CommitHookBatch()
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_WriteLock);
+
+			if (m_BatchDepth == 0)
+				return;
+
+			if (--m_BatchDepth == 0)
+			{
+				m_BatchHookMan = NULL;
+				m_PatchBatch.Commit();
+			}
+
+			// Tell the plan listeners about each vfnptr once, now that its hooks are complete
+			if (m_BatchDepth == 0)
+			{
+				CVector<void*> changed(m_BatchPlanChanges);
+				m_BatchPlanChanges.clear();
+				for (size_t i = 0; i < changed.size(); ++i)
+				{
+					CVfnPtrList::iterator vfnptr_iter = m_VfnPtrs.find(changed[i]);
+					if (vfnptr_iter != m_VfnPtrs.end())
+						HookSetChanged(*vfnptr_iter);
+				}
+			}
+		}
+
+		void CSourceHookImpl::HookSetChanged(CVfnPtr *pVfnPtr)
+		{
+			pVfnPtr->UpdateIdle();
+			UnpatchIdle();
+			if (pVfnPtr->IsIdle() && !pVfnPtr->IsUnpatched())
+				m_IdleVfnPtrs.push_back(pVfnPtr->GetPtr());
+
+			// Hook loops of this thread which are on a plan may be in the middle of the changed hooks
+			HookContextStack &contexts = GetContextStack();
+			for (HookContextStack::iterator ctx_iter = contexts.begin(); ctx_iter != contexts.end(); ++ctx_iter)
+			{
+				ctx_iter->LeavePlan();
+			}
+
+			if (m_PlanListeners.empty())
+				return;
+
+			if (m_BatchDepth > 0)
+			{
+				for (size_t i = 0; i < m_BatchPlanChanges.size(); ++i)
+				{
+					if (m_BatchPlanChanges[i] == pVfnPtr->GetPtr())
+						return;
+				}
+				m_BatchPlanChanges.push_back(pVfnPtr->GetPtr());
+				return;
+			}
+
+			CHookManager *pHookMan = pVfnPtr->GetActiveHookMan();
+			if (pHookMan == NULL)
+				return;
+
+			for (size_t i = 0; i < m_PlanListeners.size(); ++i)
+				m_PlanListeners[i]->HookPlanChanged(pHookMan->GetPubFunc(), pHookMan, pVfnPtr->GetPtr());
+		}
+
+		void CSourceHookImpl::UnpatchIdle()
+		{
+			// Slots which went idle on an earlier change and are still idle now get their original
+			// entry back; pausing and unpausing a hook right away never touches the vtable
+			for (size_t i = 0; i < m_IdleVfnPtrs.size(); ++i)
+			{
+				CVfnPtrList::iterator vfnptr_iter = m_VfnPtrs.find(m_IdleVfnPtrs[i]);
+				if (vfnptr_iter != m_VfnPtrs.end())
+					(*vfnptr_iter)->Unpatch();
+			}
+			m_IdleVfnPtrs.clear();
+		}
+
+		void CSourceHookImpl::AddHookPlanListener(IHookPlanListener *listener)
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_WriteLock);
+
+			m_PlanListeners.push_back(listener);
+		}
+
+		void CSourceHookImpl::RemoveHookPlanListener(IHookPlanListener *listener)
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_WriteLock);
+
+			for (size_t i = 0; i < m_PlanListeners.size(); ++i)
+			{
+				if (m_PlanListeners[i] == listener)
+				{
+					m_PlanListeners.erase(m_PlanListeners.iterAt(i));
+					return;
+				}
+			}
+		}
+
+		bool CSourceHookImpl::GetHookPlan(IHookManagerInfo *hi, void *vfnptr, HookPlan *plan, int maxSteps)
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_WriteLock);
+
+			CVfnPtr *pVfnPtr = FindVfnPtr(hi, vfnptr);
+			if (pVfnPtr == NULL)
+				return false;
+
+			// A plan covers the VP hooks and the hooks of at most one instance
+			CIface *pIface = NULL;
+			PooledList<CIface*> &ifaces = pVfnPtr->GetIfaceList();
+			for (PooledList<CIface*>::iterator iface_iter = ifaces.begin(); iface_iter != ifaces.end(); ++iface_iter)
+			{
+				CIface *pCur = *iface_iter;
+				if (pCur->GetPtr() == NULL || (!pCur->GetPreHookArray().size() && !pCur->GetPostHookArray().size()))
+					continue;
+				if (pIface != NULL)
+					return false;
+				pIface = pCur;
+			}
+			CIface *pVPIface = pVfnPtr->FindIface(NULL);
+
+			// In hook loop order
+			const CHookArray *arrays[4] =
+			{
+				pIface ? &pIface->GetPreHookArray() : &CHookArray::ms_Empty,
+				pVPIface ? &pVPIface->GetPreHookArray() : &CHookArray::ms_Empty,
+				pIface ? &pIface->GetPostHookArray() : &CHookArray::ms_Empty,
+				pVPIface ? &pVPIface->GetPostHookArray() : &CHookArray::ms_Empty
+			};
+			static const int states[4] =
+			{
+				CHookContext::State_Pre, CHookContext::State_PreVP,
+				CHookContext::State_Post, CHookContext::State_PostVP
+			};
+
+			int num = 0;
+			for (int i = 0; i < 4; ++i)
+			{
+				if (i == 2)
+				{
+					// End of the pre hooks
+					if (num >= maxSteps)
+						return false;
+					HookPlanStep &step = plan->steps[num++];
+					memset(&step, 0, sizeof(step));
+					step.state = CHookContext::State_OrigCall;
+				}
+
+				plan->arrayVersions[i] = arrays[i]->GetVersion();
+				for (size_t j = 0; j < arrays[i]->size(); ++j)
+				{
+					if (num >= maxSteps)
+						return false;
+					const CHookArray::Entry &entry = (*arrays[i])[j];
+
+					// Plans call every handler in them
+					if (entry.m_pFilter)
+						return false;
+
+					HookPlanStep &step = plan->steps[num++];
+					step.handler = entry.m_pHandler;
+					step.state = states[i];
+					step.thisptr_offs = entry.m_ThisPointerOffset;
+					step.hookid = entry.m_HookID;
+					step.plug = entry.m_OwnerPlugin;
+					step.serial = entry.m_Serial;
+					step.index = j;
+				}
+			}
+			plan->numSteps = num;
+			return true;
+		}
+
+		bool CSourceHookImpl::BeginHookPlan(IHookContext *pCtx, const HookPlan *plan, int *pPos)
+		{
+			CHookContext *pContext = static_cast<CHookContext*>(pCtx);
+
+			// Only fresh hook loops; the profiler wants to see every handler
+			if (pContext->m_State != CHookContext::State_Born || pContext->m_pProfiler != NULL)
+				return false;
+
+			// Array versions are unique, so this also makes sure that the plan is for our instance
+			CIface *pIface = pContext->pIface;
+			CIface *pVPIface = pContext->pVfnPtr->FindIface(NULL);
+			if ((pIface ? pIface->GetPreHookArray().GetVersion() : 0) != plan->arrayVersions[0] ||
+				(pVPIface ? pVPIface->GetPreHookArray().GetVersion() : 0) != plan->arrayVersions[1] ||
+				(pIface ? pIface->GetPostHookArray().GetVersion() : 0) != plan->arrayVersions[2] ||
+				(pVPIface ? pVPIface->GetPostHookArray().GetVersion() : 0) != plan->arrayVersions[3])
+			{
+				return false;
+			}
+
+			pContext->m_pPlan = plan;
+			pContext->m_pPlanPos = pPos;
+			*pPos = 0;
+			return true;
+		}
+
 		int CSourceHookImpl::AddHook(Plugin plug, AddHookMode mode, void *iface, int thisptr_offs, HookManagerPubFunc myHookMan,
 			ISHDelegate *handler, bool post)
+		{
+			return AddHookFiltered(plug, mode, iface, thisptr_offs, myHookMan, handler, post, NULL);
+		}
+
+		int CSourceHookImpl::AddHookFiltered(Plugin plug, AddHookMode mode, void *iface, int thisptr_offs,
+			HookManagerPubFunc myHookMan, ISHDelegate *handler, bool post, const HookFilter *filter)
 		{
 			if (mode != Hook_Normal && mode != Hook_VP && mode != Hook_DVP)
 				return 0;
 
+			std::lock_guard<std::recursive_mutex> lock(m_WriteLock);
+
 			// Get info about hook manager
-			CHookManager hookManager(plug, myHookMan);
-			if (!hookManager)
+			CHookManager *pHookMan = ResolveHookManager(plug, myHookMan);
+			if (!pHookMan)
 				return 0;
+			CHookManager &hookManager = *pHookMan;
+
+			CHookFilter *pFilter = NULL;
+			if (filter)
+			{
+				pFilter = CompileHookFilter(*filter, hookManager);
+				if (!pFilter)
+					return 0;
+			}
 
 			void *adjustediface = NULL;
 			void **cur_vtptr = NULL;
@@ -141,31 +570,30 @@ namespace SourceHook
 				break;
 			}
 
-			CVfnPtr *vfnPtr = m_VfnPtrs.GetVfnPtr(cur_vfnptr);
+			CVfnPtr *vfnPtr = m_VfnPtrs.GetVfnPtr(cur_vfnptr, &m_Epochs, &m_PatchBatch);
 			if (!vfnPtr)
 			{
 				// Could not create the vfnptr info object.
 				// This could be because a thunk generation on GCC
 				// has failed. See sourcehook_impl_cvfnptr.cpp
 				// for details.
+				delete pFilter;
 				return false;
 			}
 
-			vfnPtr->AddHookMan(m_HookManList.GetHookMan(hookManager));
+			vfnPtr->AddHookMan(pHookMan);
 			CIface &ifaceinst = vfnPtr->GetIface(adjustediface);
 
 			// Add the hook
 			CHook hook(plug, thisptr_offs, handler, 
 
 				m_HookIDMan.New(hookManager.GetProto(), hookManager.GetVtblOffs(), hookManager.GetVtblIdx(),
-					cur_vfnptr, adjustediface, plug, thisptr_offs, handler, post)
+					cur_vfnptr, adjustediface, plug, thisptr_offs, handler, post),
 
-				);
+				++m_LastHookSerial, pFilter);
 
-			if (post)
-				ifaceinst.GetPostHookList().push_back(hook);
-			else
-				ifaceinst.GetPreHookList().push_back(hook);
+			ifaceinst.AddHook(hook, post);
+			HookSetChanged(vfnPtr);
 
 			return hook.GetID();
 		}
@@ -173,6 +601,8 @@ namespace SourceHook
 		bool CSourceHookImpl::RemoveHook(Plugin plug, void *iface, int thisptr_offs, HookManagerPubFunc myHookMan,
 			ISHDelegate *handler, bool post)
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_WriteLock);
+
 			// Get info about hook manager and compute adjustediface
 			CHookManager tmpHookMan(plug, myHookMan);
 
@@ -199,6 +629,8 @@ namespace SourceHook
 
 		bool CSourceHookImpl::RemoveHookByID(int hookid)
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_WriteLock);
+
 			const CHookIDManager::Entry *hentry;
 
 			hentry = m_HookIDMan.QueryHook(hookid);
@@ -209,53 +641,56 @@ namespace SourceHook
 			}
 
 			// find vfnptr
-			List<CVfnPtr>::iterator vfnptr_iter = m_VfnPtrs.find(hentry->vfnptr);
+			CVfnPtrList::iterator vfnptr_iter = m_VfnPtrs.find(hentry->vfnptr);
 			if (vfnptr_iter == m_VfnPtrs.end())
 				return false;
+			CVfnPtr *pVfnPtr = *vfnptr_iter;
 
 			// find iface
-			List<CIface>::iterator iface_iter = vfnptr_iter->GetIfaceList().find(hentry->adjustediface);
-			if (iface_iter == vfnptr_iter->GetIfaceList().end())
+			CIface *pIface = pVfnPtr->FindIface(hentry->adjustediface);
+			if (pIface == NULL)
 				return false;
 
 			// find hook
-			List<CHook> &hooks = hentry->post ? iface_iter->GetPostHookList() : iface_iter->GetPreHookList();
-			List<CHook>::iterator hook_iter = hooks.find(hookid);
+			PooledList<CHook> &hooks = hentry->post ? pIface->GetPostHookList() : pIface->GetPreHookList();
+			PooledList<CHook>::iterator hook_iter = hooks.find(hookid);
 			if (hook_iter == hooks.end())
 				return false;
 
-			hook_iter->GetHandler()->DeleteThis();
+			ISHDelegate *handler = hook_iter->GetHandler();
+			const CHookFilter *filter = hook_iter->GetFilter();
 
-			// Iterator movage!
-			List<CHook>::iterator oldhookiter = hook_iter;
-			hook_iter = hooks.erase(hook_iter);
+			// Running hook loops notice the change of the hook array themselves (see CHookContext::NextHook)
+			pIface->EraseHook(hook_iter, hentry->post);
+			HookSetChanged(pVfnPtr);
 
-			for (CStack<CHookContext>::iterator ctx_iter = m_ContextStack.begin();
-				ctx_iter != m_ContextStack.end(); ++ctx_iter)
-			{
-				ctx_iter->HookRemoved(oldhookiter, hook_iter);
-			}
+			// Hook loops on other threads may be about to call it.
+			// Only retire it once it's unpublished, see CEpochManager.
+			m_Epochs.Retire(&DeleteHandler, handler);
+			if (filter)
+				m_Epochs.Retire(&DeleteFilter, const_cast<CHookFilter*>(filter));
 
-			if (iface_iter->GetPreHookList().empty() && iface_iter->GetPostHookList().empty())
+			if (pIface->GetPreHookList().empty() && pIface->GetPostHookList().empty())
 			{
 				// -> Kill all contexts that use it!
-				for (CStack<CHookContext>::iterator ctx_iter = m_ContextStack.begin();
-					ctx_iter != m_ContextStack.end(); ++ctx_iter)
+				// Only the ones of this thread: contexts on other threads keep the retired iface
+				// and find no more hooks in it.
+				HookContextStack &contexts = GetContextStack();
+				for (HookContextStack::iterator ctx_iter = contexts.begin(); ctx_iter != contexts.end(); ++ctx_iter)
 				{
-					ctx_iter->IfaceRemoved(&(*iface_iter));
+					ctx_iter->IfaceRemoved(pIface);
 				}
 
 				// There are no hooks on this iface anymore...
-				iface_iter = vfnptr_iter->GetIfaceList().erase(iface_iter);
+				pVfnPtr->EraseIface(pIface);
 
-				if (vfnptr_iter->GetIfaceList().empty())
+				if (pVfnPtr->GetIfaceList().empty())
 				{
 					// No ifaces at all -> Deactivate the hook
 
-					for (CStack<CHookContext>::iterator ctx_iter = m_ContextStack.begin();
-						ctx_iter != m_ContextStack.end(); ++ctx_iter)
+					for (HookContextStack::iterator ctx_iter = contexts.begin(); ctx_iter != contexts.end(); ++ctx_iter)
 					{
-						ctx_iter->VfnPtrRemoved(&(*vfnptr_iter));
+						ctx_iter->VfnPtrRemoved(pVfnPtr);
 					}
 
 					RevertAndRemoveVfnPtr(vfnptr_iter);
@@ -263,103 +698,111 @@ namespace SourceHook
 			}
 
 			m_HookIDMan.Remove(hookid);
+			m_Epochs.Reclaim();
 			return true;
 		}
 
-		List<CVfnPtr>::iterator CSourceHookImpl::RevertAndRemoveVfnPtr(List<CVfnPtr>::iterator vfnptr_iter)
+		CVfnPtrList::iterator CSourceHookImpl::RevertAndRemoveVfnPtr(CVfnPtrList::iterator vfnptr_iter)
 		{
-			ICleanupTask *cleanupTask = vfnptr_iter->GetCleanupTask();
+			CVfnPtr *pVfnPtr = *vfnptr_iter;
+
+			// Do the work
+			pVfnPtr->Revert();
+			pVfnPtr->Detach();
 
 			// Some vfnptrs require cleanup.
 			// Concrete case: on GCC, when the original vtable entry is not even
 			// we generate an even-aligned thunk to call the original function.
-			// If the vfnptr is being removed from a pre hook on the vfnptr
-			// we have to delay the cleanup of this thunk until the hook loop is done
-			// (because the orig function call mechanism is going to use the thunk).
-
+			// Hook loops which are running at the moment (on any thread) may still
+			// call the original function through the thunk, so it is retired together
+			// with the vfnptr.
+			ICleanupTask *cleanupTask = pVfnPtr->GetCleanupTask();
 			if (cleanupTask != NULL)
-			{
-				// If this vfnptr is in use in one of the hook loops running at the moment
-				// Schedule it for removal on the DEEPEST hook loop.
-
-				size_t numOfContexts = m_ContextStack.size();
-				// m_ContextStack.at(0) is the deepest hook context
-				// m_ContextStack.at(size-1) = m_ContextStack.front is the uppermost
-
-				bool cleanupImmedieately = true;
-
-				CVfnPtr *vfnPtrObjAddr = &(*vfnptr_iter);
-				for (size_t i = 0; i < numOfContexts; ++i)
-				{
-					CHookContext &context = m_ContextStack.at(i);
-					if (context.pVfnPtr == vfnPtrObjAddr)
-					{
-						// Found a hook context using this vfnptr at the moment.
-						context.m_CleanupTask = cleanupTask;
-						cleanupImmedieately = false;			// Delay the cleanup
-						break;
-					}
-				}
-
-				if (cleanupImmedieately)
-				{
-					cleanupTask->CleanupAndDeleteThis();
-				}
-			}
+				m_Epochs.Retire(&RunCleanupTask, cleanupTask);
 
-			// Do the work
-			vfnptr_iter->Revert();
+			m_Epochs.RetireObject(pVfnPtr);
 			return m_VfnPtrs.erase(vfnptr_iter);
 		}
 
 		void CSourceHookImpl::SetRes(META_RES res)
 		{
-			*m_ContextStack.front().pCurRes = res;
+			*GetContextStack().front().pCurRes = res;
 		}
 
 		META_RES CSourceHookImpl::GetPrevRes()
 		{
-			return *m_ContextStack.front().pPrevRes;
+			return *GetContextStack().front().pPrevRes;
 		}
 
 		META_RES CSourceHookImpl::GetStatus()
 		{
-			return *m_ContextStack.front().pStatus;
+			return *GetContextStack().front().pStatus;
 
 		}
 
 		const void *CSourceHookImpl::GetOrigRet()
 		{
-			return m_ContextStack.front().pOrigRet;
+			CHookContext &ctx = GetContextStack().front();
+
+			// The hook func only constructs the orig ret value once the original function
+			// has returned (see RetStorage)
+			if (ctx.m_pPlan)
+				ctx.SyncPlan();
+			SH_ASSERT(ctx.m_State != CHookContext::State_Pre && ctx.m_State != CHookContext::State_PreVP &&
+				ctx.m_State != CHookContext::State_Recall_Pre && ctx.m_State != CHookContext::State_Recall_PreVP,
+				("META_RESULT_ORIG_RET used in a pre hook"));
+
+			// Superceded: the hook func hasn't copied the override ret value
+			if (ctx.m_Superceded)
+				return ctx.pOverrideRet;
+			return ctx.pOrigRet;
 		}
 
 		const void *CSourceHookImpl::GetOverrideRet()
 		{
-			return (*m_ContextStack.front().pStatus < MRES_OVERRIDE) ?
-				NULL : m_ContextStack.front().pOverrideRet;
+			return (*GetContextStack().front().pStatus < MRES_OVERRIDE) ?
+				NULL : GetContextStack().front().pOverrideRet;
 		}
 
 		void *CSourceHookImpl::GetIfacePtr()
 		{
+			// The hook func may have walked its plan without telling us
+			if (GetContextStack().front().m_pPlan)
+				GetContextStack().front().SyncPlan();
+
 			// If in recall: return last one
-			if (m_ContextStack.front().m_State >= CHookContext::State_Recall_Pre &&
-				m_ContextStack.front().m_State <= CHookContext::State_Recall_PostVP)
+			if (GetContextStack().front().m_State >= CHookContext::State_Recall_Pre &&
+				GetContextStack().front().m_State <= CHookContext::State_Recall_PostVP)
 			{
-				return m_ContextStack.second().pIfacePtr;
+				return GetContextStack().second().pIfacePtr;
 			}
 			else
 			{
-				return m_ContextStack.front().pIfacePtr;
+				return GetContextStack().front().pIfacePtr;
 			}
 		}
 
 		void *CSourceHookImpl::GetOverrideRetPtr()
 		{
-			return m_ContextStack.front().pOverrideRet;
+			return GetContextStack().front().pOverrideRet;
+		}
+
+		void *CSourceHookImpl::PrepareOverrideRet(bool *construct)
+		{
+			CHookContext &ctx = GetContextStack().front();
+
+			// The caller constructs it right away
+			*construct = ctx.pOverrideConstructed && !*ctx.pOverrideConstructed;
+			if (*construct)
+				*ctx.pOverrideConstructed = true;
+
+			return ctx.pOverrideRet;
 		}
 
 		void CSourceHookImpl::UnloadPlugin(Plugin plug, UnloadListener *listener)
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_WriteLock);
+
 			// 1) Remove all hooks by this plugin
 
 			CVector<int> removehooks;
@@ -382,33 +825,44 @@ namespace SourceHook
 			// free them as the context stack drops to 0, or we could change the pubfunc API to
 			// know whether it's active or not. Rather than deal with this extra complexity, we
 			// just conservatively wait until the context stack hits 0 before unloading.
-			if (m_ContextStack.size() == 0)
+			// With several threads, that's when no thread is inside of SourceHook anymore
+			// and the retired hook handlers have been deleted.
+			m_Epochs.Reclaim();
+			if (!m_Epochs.IsAnyThreadActive() && !m_Epochs.HasRetired())
 			{
 				listener->ReadyToUnload(plug);
 			}
 			else
 			{
 				m_PendingUnloads.push_back(new PendingUnload(listener, plug));
+				m_HasPendingUnloads.store(true);
 			}
 		}
 
 		CHookManList::iterator CSourceHookImpl::RemoveHookManager(CHookManList::iterator hookman_iter)
 		{
+			if (&(*hookman_iter) == m_BatchHookMan)
+				m_BatchHookMan = NULL;
+
 			// 2) Remove it
 			for (CVfnPtrList::iterator vfnptr_iter = m_VfnPtrs.begin();
 				vfnptr_iter != m_VfnPtrs.end();)
 			{
-				if (!vfnptr_iter->HookManRemoved(&(*hookman_iter)))
+				CHookManager *pActive = (*vfnptr_iter)->GetActiveHookMan();
+				if (!(*vfnptr_iter)->HookManRemoved(&(*hookman_iter)))
 				{
 					// This vfnptr has no more hook managers
 					// and asks to be removed.
 
-					m_HookIDMan.RemoveAll(vfnptr_iter->GetPtr());
+					m_HookIDMan.RemoveAll((*vfnptr_iter)->GetPtr());
 
 					vfnptr_iter = RevertAndRemoveVfnPtr(vfnptr_iter);
 				}
 				else
 				{
+					// Another hook manager's hook func has taken over
+					if ((*vfnptr_iter)->GetActiveHookMan() != pActive)
+						HookSetChanged(*vfnptr_iter);
 					++vfnptr_iter;
 				}
 			}
@@ -418,50 +872,82 @@ namespace SourceHook
 
 		void CSourceHookImpl::RemoveHookManager(Plugin plug, HookManagerPubFunc pubFunc)
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_WriteLock);
+
 			// Find the hook manager
 			CHookManList::iterator hookman_iter = m_HookManList.find(CHookManager::Descriptor(plug, pubFunc));
 
 			if (hookman_iter != m_HookManList.end())
 			{
 				RemoveHookManager(hookman_iter);
+				m_Epochs.Reclaim();
 			}
 		}
 
 		void CSourceHookImpl::SetIgnoreHooks(void *vfnptr)
 		{
+			CEpochManager::ThreadState &thread = m_Epochs.GetThreadState();
+			m_Epochs.Enter(thread);
+
 			CHookContext ctx;
 			ctx.m_State = CHookContext::State_Ignore;
-			m_ContextStack.push(ctx);
+			thread.m_Contexts.push(ctx);
 		}
 
 		void CSourceHookImpl::ResetIgnoreHooks(void *vfnptr)
 		{
-			if (!m_ContextStack.empty() && m_ContextStack.front().m_State == CHookContext::State_Ignore)
+			HookContextStack &contexts = GetContextStack();
+			if (!contexts.empty() && contexts.front().m_State == CHookContext::State_Ignore)
 			{
 				// Actually use EndContext
-				// instead of m_ContextStack.pop directly
-				// because it runs the cleanup task if neccesary
-				EndContext(&(m_ContextStack.front()));
+				// instead of popping the context directly
+				// because it leaves the epoch and resolves pending unloads
+				EndContext(&(contexts.front()));
 			}
 		}
 
 		void *CSourceHookImpl::GetOrigVfnPtrEntry(void *vfnptr)
 		{
-			for (CVfnPtrList::iterator vfnptr_iter = m_VfnPtrs.begin(); vfnptr_iter != m_VfnPtrs.end(); ++vfnptr_iter)
-			{
-				if (vfnptr_iter->GetPtr() == vfnptr)
-					return vfnptr_iter->GetOrigEntry();
-			}
-			return NULL;
+			std::lock_guard<std::recursive_mutex> lock(m_WriteLock);
+
+			CVfnPtrList::iterator vfnptr_iter = m_VfnPtrs.find(vfnptr);
+			return vfnptr_iter == m_VfnPtrs.end() ? NULL : (*vfnptr_iter)->GetOrigEntry();
+		}
+
+		void CSourceHookImpl::StartProfiling()
+		{
+			m_Profiler.Start();
+			m_pActiveProfiler.store(&m_Profiler);
+		}
+
+		void CSourceHookImpl::StopProfiling()
+		{
+			m_pActiveProfiler.store(NULL);
+			m_Profiler.Stop();
+		}
+
+		bool CSourceHookImpl::IsProfiling() const
+		{
+			return m_pActiveProfiler.load() != NULL;
+		}
+
+		const CHookProfiler &CSourceHookImpl::GetProfiler() const
+		{
+			return m_Profiler;
 		}
 
 		void CSourceHookImpl::DoRecall()
 		{
+			CEpochManager::ThreadState &thread = m_Epochs.GetThreadState();
+
 			CHookContext newCtx;
-			CHookContext &curCtx = m_ContextStack.front();
+			CHookContext &curCtx = thread.m_Contexts.front();
 
+			// The recall continues where we are; the hook func of curCtx has to leave its plan
+			curCtx.LeavePlan();
 
 			newCtx.m_State = curCtx.m_State + (CHookContext::State_Recall_Pre - CHookContext::State_Pre);
+			newCtx.m_pProfiler = curCtx.m_pProfiler;
 			if (newCtx.m_State == CHookContext::State_Recall_Post || newCtx.m_State == CHookContext::State_Recall_PostVP)
 			{
 				// Also save orig ret
@@ -475,21 +961,47 @@ namespace SourceHook
 
 			newCtx.pStatus = curCtx.pStatus;
 			newCtx.pOverrideRet = curCtx.pOverrideRet;
+			newCtx.pOverrideConstructed = curCtx.pOverrideConstructed;
+			newCtx.m_Superceded = false;
 			newCtx.pPrevRes = curCtx.pPrevRes;
-			newCtx.m_Iter = curCtx.m_Iter;
+			newCtx.m_LastSerial = curCtx.m_LastSerial;
+			newCtx.m_LastIndex = curCtx.m_LastIndex;
+			newCtx.m_ArrayVersion = curCtx.m_ArrayVersion;
 
 			// Take this with us!
 			newCtx.pCurRes = curCtx.pCurRes;
 
-			m_ContextStack.push(newCtx);
+			m_Epochs.Enter(thread);
+			thread.m_Contexts.push(newCtx);
 			curCtx.m_State = CHookContext::State_Dead;
 		}
 
 		IHookContext *CSourceHookImpl::SetupHookLoop(IHookManagerInfo *hi, void *vfnptr, void *thisptr, void **origCallAddr, META_RES *statusPtr,
 			META_RES *prevResPtr, META_RES *curResPtr, const void *origRetPtr, void *overrideRetPtr)
 		{
+			// Older hook funcs always expect a context
+			return SetupContext(hi, vfnptr, thisptr, origCallAddr, statusPtr, prevResPtr, curResPtr,
+				origRetPtr, overrideRetPtr, NULL, false);
+		}
+
+		IHookContext *CSourceHookImpl::SetupHookLoopParams(IHookManagerInfo *hi, void *vfnptr, void *thisptr, void **origCallAddr,
+			META_RES *statusPtr, META_RES *prevResPtr, META_RES *curResPtr, const void *origRetPtr, void *overrideRetPtr,
+			const void * const *params)
+		{
+			return SetupContext(hi, vfnptr, thisptr, origCallAddr, statusPtr, prevResPtr, curResPtr,
+				origRetPtr, overrideRetPtr, params, true);
+		}
+
+		IHookContext *CSourceHookImpl::SetupContext(IHookManagerInfo *hi, void *vfnptr, void *thisptr, void **origCallAddr,
+			META_RES *statusPtr, META_RES *prevResPtr, META_RES *curResPtr, const void *origRetPtr, void *overrideRetPtr,
+			const void * const *params, bool mayBypass)
+		{
+			CEpochManager::ThreadState &thread = m_Epochs.GetThreadState();
+			HookContextStack &contexts = thread.m_Contexts;
+
 			CHookContext *pCtx = NULL;
-			CHookContext *oldctx = m_ContextStack.empty() ? NULL : &m_ContextStack.front();
+			CHookContext *oldctx = contexts.empty() ? NULL : &contexts.front();
+			bool *overrideConstructed = NULL;
 			if (oldctx)
 			{
 				// SH_CALL
@@ -499,25 +1011,21 @@ namespace SourceHook
 					oldctx->m_CallOrig = true;
 					oldctx->m_State = CHookContext::State_Dead;
 
-					List<CVfnPtr*> &vfnptr_list = static_cast<CHookManager*>(hi)->GetVfnPtrList();
-					List<CVfnPtr*>::iterator vfnptr_iter;
-					for (vfnptr_iter = vfnptr_list.begin();
-						vfnptr_iter != vfnptr_list.end(); ++vfnptr_iter)
-					{
-						if (**vfnptr_iter == vfnptr)
-							break;
-					}
-					if (vfnptr_iter == vfnptr_list.end())
+					CVfnPtr *pVfnPtr = FindVfnPtr(hi, vfnptr);
+					if (pVfnPtr == NULL)
 					{
-						SH_ASSERT(false, ("How can a hook exist on a vfnptr which we don't have in our db?!"));
+						// Another thread has just removed it
+						*origCallAddr = GetCurrentVfnPtrEntry(vfnptr);
 					}
 					else
 					{
-						*origCallAddr = (*vfnptr_iter)->GetOrigCallAddr();
-						oldctx->pVfnPtr = *vfnptr_iter;
+						*origCallAddr = pVfnPtr->GetOrigCallAddr();
+						oldctx->pVfnPtr = pVfnPtr;
 					}
 
 					oldctx->pOrigRet = origRetPtr;
+					oldctx->pStatus = statusPtr;
+					oldctx->m_Superceded = false;
 					return oldctx;
 				}
 				// Recall
@@ -529,13 +1037,12 @@ namespace SourceHook
 					*statusPtr = *(oldctx->pStatus);
 					*prevResPtr = *(oldctx->pPrevRes);
 
-					pCtx->m_Iter = oldctx->m_Iter;
-
 					// Only have possibility of calling the orig func in pre recall mode
 					pCtx->m_CallOrig = (oldctx->m_State == CHookContext::State_Recall_Pre || 
 						oldctx->m_State == CHookContext::State_Recall_PreVP);
 
 					overrideRetPtr = pCtx->pOverrideRet;
+					overrideConstructed = pCtx->pOverrideConstructed;
 
 					// When the status is low so there's no override return value and we're in a post recall,
 					// give it the orig return value as override return value.
@@ -544,36 +1051,65 @@ namespace SourceHook
 					{
 						origRetPtr = oldctx->pOrigRet;
 						if (*statusPtr < MRES_OVERRIDE)
+						{
 							overrideRetPtr = const_cast<void*>(pCtx->pOrigRet);
+							overrideConstructed = NULL;
+						}
 					}
 				}
 			}
-			if (!pCtx)
+			bool isNew = pCtx == NULL;
+
+			// Has to happen before we look anything up; recalls are inside already
+			if (isNew)
+				m_Epochs.Enter(thread);
+
+			CVfnPtr *pVfnPtr = FindVfnPtr(hi, vfnptr);
+			CIface *pIface = pVfnPtr ? pVfnPtr->FindIface(thisptr) : NULL;
+
+			// Nothing to call for this instance -> the hook func calls the original function directly
+			if (isNew && mayBypass)
+			{
+				void *bypassAddr = GetBypassCallAddr(pVfnPtr, pIface, vfnptr);
+				if (bypassAddr)
+				{
+					m_Epochs.Leave(thread);
+					*origCallAddr = bypassAddr;
+					return NULL;
+				}
+			}
+
+			if (isNew)
 			{
-				pCtx = m_ContextStack.make_next();
+				// Only constructed on the first override
+				if (overrideRetPtr && static_cast<CHookManager*>(hi)->GetVersion() >= 3)
+				{
+					LazyRet *lazy = reinterpret_cast<LazyRet*>(overrideRetPtr);
+					overrideRetPtr = lazy->ptr;
+					overrideConstructed = &lazy->constructed;
+				}
+
+				pCtx = contexts.make_next();
 				pCtx->m_State = CHookContext::State_Born;
 				pCtx->m_CallOrig = true;
+				pCtx->m_pPlan = NULL;
+				pCtx->m_pProfiler = m_pActiveProfiler.load(std::memory_order_relaxed);
+				pCtx->m_ProfHookID = 0;
 			}
 
 			pCtx->pIface = NULL;
 
-			List<CVfnPtr*> &vfnptr_list = static_cast<CHookManager*>(hi)->GetVfnPtrList();
-			List<CVfnPtr*>::iterator vfnptr_iter; 
-			for (vfnptr_iter = vfnptr_list.begin();
-				vfnptr_iter != vfnptr_list.end(); ++vfnptr_iter)
-			{
-				if (**vfnptr_iter == vfnptr)
-					break;
-			}
-			if (vfnptr_iter == vfnptr_list.end())
+			if (pVfnPtr == NULL)
 			{
 				pCtx->m_State = CHookContext::State_Dead;
+				*origCallAddr = GetCurrentVfnPtrEntry(vfnptr);
 			}
 			else
 			{
-				pCtx->pVfnPtr = *vfnptr_iter;
+				pCtx->pVfnPtr = pVfnPtr;
+				pCtx->m_VtblIdx = static_cast<CHookManager*>(hi)->GetVtblIdx();
 				*origCallAddr = pCtx->pVfnPtr->GetOrigCallAddr();
-				pCtx->pIface = pCtx->pVfnPtr->FindIface(thisptr);
+				pCtx->pIface = pIface;
 			}
 
 			pCtx->pStatus = statusPtr;
@@ -581,14 +1117,47 @@ namespace SourceHook
 			pCtx->pCurRes = curResPtr;
 			pCtx->pThisPtr = thisptr;
 			pCtx->pOverrideRet = overrideRetPtr;
+			pCtx->pOverrideConstructed = overrideConstructed;
+			pCtx->m_Superceded = false;
 			pCtx->pOrigRet = origRetPtr;
+			pCtx->m_pParams = params;
 
 			return pCtx;
 		}
 
+		void *CSourceHookImpl::GetBypassCallAddr(CVfnPtr *pVfnPtr, CIface *pIface, void *vfnptr)
+		{
+			// Removed on another thread: the vtable entry is the original function or the next hook func
+			if (pVfnPtr == NULL)
+				return GetCurrentVfnPtrEntry(vfnptr);
+
+			// Ifaces whose hooks are all paused don't need the hook loop either
+			if (pIface && (pIface->GetPreHookArray().size() || pIface->GetPostHookArray().size()))
+				return NULL;
+
+			CIface *pVPIface = pVfnPtr->FindIface(NULL);
+			if (pVPIface && (pVPIface->GetPreHookArray().size() || pVPIface->GetPostHookArray().size()))
+				return NULL;
+
+			// The caller has left SourceHook by the time it calls the address. A thunk for an odd
+			// original entry may be freed by then; only the hook loop keeps it alive.
+			if (pVfnPtr->GetOrigCallAddr() != pVfnPtr->GetOrigEntry())
+				return NULL;
+
+			return pVfnPtr->GetOrigEntry();
+		}
+
 		void CSourceHookImpl::ResolvePendingUnloads(bool force)
 		{
-			List<PendingUnload *>::iterator iter = m_PendingUnloads.begin();
+			std::lock_guard<std::recursive_mutex> lock(m_WriteLock);
+
+			// The plugins' hook handlers have to be deleted before their code goes away.
+			// Forcing frees them even if other threads are still inside of SourceHook.
+			m_Epochs.Reclaim(force);
+			if (!force && (m_Epochs.IsAnyThreadActive() || m_Epochs.HasRetired()))
+				return;
+
+			PooledList<PendingUnload *>::iterator iter = m_PendingUnloads.begin();
 			while (iter != m_PendingUnloads.end())
 			{
 				PendingUnload *unload = *iter;
@@ -608,23 +1177,35 @@ namespace SourceHook
 					iter = m_PendingUnloads.erase(iter);
 				}
 			}
+
+			m_HasPendingUnloads.store(!m_PendingUnloads.empty());
 		}
 
 		void CSourceHookImpl::EndContext(IHookContext *pCtx)
 		{
-			// Do clean up task, if any is associated with this context
-			m_ContextStack.front().DoCleanupTaskAndDeleteIt();
-			// Then remove it
-			m_ContextStack.pop();
-
-			// If we've reached 0 contexts and there are pending unloads,
-			// resolve them now.
-			if (m_ContextStack.size() == 0 && m_PendingUnloads.size() != 0)
-				ResolvePendingUnloads();
+			CEpochManager::ThreadState &thread = m_Epochs.GetThreadState();
+			thread.m_Contexts.pop();
+			m_Epochs.Leave(thread);
+
+			// If we've reached 0 contexts on the main thread, free what the hook loops have left
+			// behind and resolve pending unloads. Don't wait for a writer on another thread though.
+			if (thread.m_Contexts.empty() && m_Epochs.IsOwnerThread(thread) &&
+				(m_Epochs.HasRetired() || m_HasPendingUnloads.load(std::memory_order_relaxed)))
+			{
+				std::unique_lock<std::recursive_mutex> lock(m_WriteLock, std::try_to_lock);
+				if (lock.owns_lock())
+				{
+					m_Epochs.Reclaim();
+					if (m_PendingUnloads.size() != 0)
+						ResolvePendingUnloads();
+				}
+			}
 		}
 
 		void CSourceHookImpl::CompleteShutdown()
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_WriteLock);
+
 			CVector<int> removehooks;
 			m_HookIDMan.FindAllHooks(removehooks);
 
@@ -634,6 +1215,8 @@ namespace SourceHook
 
 		void CSourceHookImpl::PausePlugin(Plugin plug)
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_WriteLock);
+
 			CVector<int> pausehooks;
 			m_HookIDMan.FindAllHooks(pausehooks, plug);
 
@@ -643,6 +1226,8 @@ namespace SourceHook
 
 		void CSourceHookImpl::UnpausePlugin(Plugin plug)
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_WriteLock);
+
 			CVector<int> unpausehooks;
 			m_HookIDMan.FindAllHooks(unpausehooks, plug);
 
@@ -662,6 +1247,8 @@ namespace SourceHook
 
 		bool CSourceHookImpl::SetHookPaused(int hookid, bool paused)
 		{
+			std::lock_guard<std::recursive_mutex> lock(m_WriteLock);
+
 			const CHookIDManager::Entry *hentry;
 
 			hentry = m_HookIDMan.QueryHook(hookid);
@@ -672,38 +1259,110 @@ namespace SourceHook
 			}
 
 			// find vfnptr
-			List<CVfnPtr>::iterator vfnptr_iter = m_VfnPtrs.find(hentry->vfnptr);
+			CVfnPtrList::iterator vfnptr_iter = m_VfnPtrs.find(hentry->vfnptr);
 			if (vfnptr_iter == m_VfnPtrs.end())
 				return false;
 
 			// find iface
-			List<CIface>::iterator iface_iter = vfnptr_iter->GetIfaceList().find(hentry->adjustediface);
-			if (iface_iter == vfnptr_iter->GetIfaceList().end())
+			CIface *pIface = (*vfnptr_iter)->FindIface(hentry->adjustediface);
+			if (pIface == NULL)
 				return false;
 
 			// find hook
-			List<CHook> &hooks = hentry->post ? iface_iter->GetPostHookList() : iface_iter->GetPreHookList();
-			List<CHook>::iterator hook_iter = hooks.find(hookid);
+			PooledList<CHook> &hooks = hentry->post ? pIface->GetPostHookList() : pIface->GetPreHookList();
+			PooledList<CHook>::iterator hook_iter = hooks.find(hookid);
 			if (hook_iter == hooks.end())
 				return false;
 
 			hook_iter->SetPaused(paused);
+			pIface->HookListChanged(hentry->post);
+			HookSetChanged(*vfnptr_iter);
+			m_Epochs.Reclaim();
 			return true;
 		}
 
 		//////////////////////////////////////////////////////////////////////////
 		// CHookContext
 		//////////////////////////////////////////////////////////////////////////
+		ISHDelegate *CHookContext::NextHook(const CHookArray &hooks)
+		{
+			const CHookArray::Entry *entries = hooks.GetEntries();
+			size_t count = hooks.size();
+
+			size_t pos;
+			if (m_ArrayVersion == hooks.GetVersion())
+				pos = m_LastIndex + 1;
+			else if (m_LastSerial == 0)
+				pos = 0;
+			else
+			{
+				// The array was rebuilt since we've called the last hook;
+				// continue with the first hook that was added after it
+				pos = hooks.UpperBound(m_LastSerial);
+			}
+
+			// Skip the hooks whose filter doesn't want this call. Without the parameters
+			// (old hook managers), filtered hooks are called for every call.
+			if (m_pParams)
+			{
+				while (pos < count && entries[pos].m_pFilter && !entries[pos].m_pFilter->Matches(m_pParams))
+					++pos;
+			}
+
+			if (pos >= count)
+				return NULL;
+
+			const CHookArray::Entry &entry = entries[pos];
+			m_LastSerial = entry.m_Serial;
+			m_LastHookID = entry.m_HookID;
+			m_LastPlug = entry.m_OwnerPlugin;
+			m_LastIndex = pos;
+			m_ArrayVersion = hooks.GetVersion();
+
+			pIfacePtr = reinterpret_cast<void*>(reinterpret_cast<char*>(pThisPtr) - entry.m_ThisPointerOffset);
+			return entry.m_pHandler;
+		}
+
 		ISHDelegate *CHookContext::GetNext()
+		{
+			if (m_pPlan)
+				LeavePlan();
+
+			if (m_pProfiler == NULL)
+				return NextHandler();
+
+			// The previous handler has returned
+			CHookProfiler::Timestamp now = CHookProfiler::Now();
+			if (m_ProfHookID != 0)
+				m_pProfiler->Record(m_ProfHookID, m_ProfSerial, m_ProfPlug, m_VtblIdx, m_ProfPost, now - m_ProfStart);
+
+			ISHDelegate *handler = NextHandler();
+			if (handler)
+			{
+				m_ProfHookID = m_LastHookID;
+				m_ProfSerial = m_LastSerial;
+				m_ProfPlug = m_LastPlug;
+				m_ProfPost = m_State == State_Post || m_State == State_PostVP;
+				m_ProfStart = CHookProfiler::Now();
+			}
+			else
+			{
+				m_ProfHookID = 0;
+			}
+			return handler;
+		}
+
+		ISHDelegate *CHookContext::NextHandler()
 		{
 			CIface *pVPIface;
+			ISHDelegate *handler;
 			switch (m_State)
 			{
 			case State_Dead:
 				return NULL;
 
 			case State_Born:
-				m_Iter = List<CHook>::iterator();
+				ResetIter();
 				m_State = State_Pre;
 
 				// fall-through
@@ -712,23 +1371,15 @@ namespace SourceHook
 			case State_Pre:
 				if (pIface)
 				{
-					if (!m_Iter)
-						m_Iter = pIface->GetPreHookList().begin();
-					else
-						++m_Iter;
-					SkipPaused(m_Iter, pIface->GetPreHookList());
-
-					if (m_Iter != pIface->GetPreHookList().end())
-					{
-						pIfacePtr = reinterpret_cast<void*>(reinterpret_cast<char*>(pThisPtr) - m_Iter->GetThisPointerOffset());
-						return m_Iter->GetHandler();
-					}
+					handler = NextHook(pIface->GetPreHookArray());
+					if (handler)
+						return handler;
 				}
 
 				// end of normal hooks -> VP
 				
 				m_State = State_PreVP;
-				m_Iter = List<CHook>::iterator();
+				ResetIter();
 
 				// fall-through
 			case State_Recall_PreVP:
@@ -737,17 +1388,9 @@ namespace SourceHook
 				pVPIface = pVfnPtr->FindIface(NULL);
 				if (pVPIface)
 				{
-					if (!m_Iter)
-						m_Iter = pVPIface->GetPreHookList().begin();
-					else
-						++m_Iter;
-					SkipPaused(m_Iter, pVPIface->GetPreHookList());
-
-					if (m_Iter != pVPIface->GetPreHookList())
-					{
-						pIfacePtr = reinterpret_cast<void*>(reinterpret_cast<char*>(pThisPtr) - m_Iter->GetThisPointerOffset());
-						return m_Iter->GetHandler();
-					}
+					handler = NextHook(pVPIface->GetPreHookArray());
+					if (handler)
+						return handler;
 				}
 
 				// end VP hooks -> orig call
@@ -756,46 +1399,30 @@ namespace SourceHook
 				return NULL;
 				
 			case State_OrigCall:
-				m_Iter = List<CHook>::iterator();
+				ResetIter();
 				m_State = State_Post;
 
 				// fall-through
 			case State_Post:
 				if (pIface)
 				{
-					if (!m_Iter)
-						m_Iter = pIface->GetPostHookList().begin();
-					else
-						++m_Iter;
-					SkipPaused(m_Iter, pIface->GetPostHookList());
-
-					if (m_Iter != pIface->GetPostHookList().end())
-					{
-						pIfacePtr = reinterpret_cast<void*>(reinterpret_cast<char*>(pThisPtr) - m_Iter->GetThisPointerOffset());
-						return m_Iter->GetHandler();
-					}
+					handler = NextHook(pIface->GetPostHookArray());
+					if (handler)
+						return handler;
 				}
 				// end of normal hooks -> VP
 
 				m_State = State_PostVP;
-				m_Iter = List<CHook>::iterator();
+				ResetIter();
 
 				// fall-through
 			case State_PostVP:
 				pVPIface = pVfnPtr->FindIface(NULL);
 				if (pVPIface)
 				{
-					if (!m_Iter)
-						m_Iter = pVPIface->GetPostHookList().begin();
-					else
-						++m_Iter;
-					SkipPaused(m_Iter, pVPIface->GetPostHookList());
-
-					if (m_Iter != pVPIface->GetPostHookList())
-					{
-						pIfacePtr = reinterpret_cast<void*>(reinterpret_cast<char*>(pThisPtr) - m_Iter->GetThisPointerOffset());
-						return m_Iter->GetHandler();
-					}
+					handler = NextHook(pVPIface->GetPostHookArray());
+					if (handler)
+						return handler;
 				}
 
 				// end VP hooks -> done
@@ -828,16 +1455,44 @@ namespace SourceHook
 
 		bool CHookContext::ShouldCallOrig()
 		{
+			// Hook funcs of hookman version 3 ask before they look at the status; older ones don't
+			// ask at all on MRES_SUPERCEDE and copy the override ret value to the orig ret value
+			m_Superceded = m_CallOrig && *pStatus == MRES_SUPERCEDE;
 			return m_CallOrig;
 		}
 
-		void CHookContext::HookRemoved(List<CHook>::iterator oldhookiter, List<CHook>::iterator nexthookiter)
+		void CHookContext::SyncPlan()
 		{
-			if (m_Iter == oldhookiter)
+			int pos = *m_pPlanPos;
+			if (pos <= 0)
+				return;
+
+			const HookPlanStep &step = m_pPlan->steps[pos - 1];
+			m_State = step.state;
+			if (step.handler == NULL)
 			{
-				m_Iter = nexthookiter;
-				--m_Iter;
+				// About to call the orig func
+				ResetIter();
+				return;
 			}
+
+			// arrayVersions is in hook loop order: Pre, PreVP, Post, PostVP
+			m_LastSerial = step.serial;
+			m_LastIndex = step.index;
+			m_ArrayVersion = m_pPlan->arrayVersions[step.state - State_Pre];
+			m_LastHookID = step.hookid;
+			m_LastPlug = step.plug;
+			pIfacePtr = reinterpret_cast<void*>(reinterpret_cast<char*>(pThisPtr) - step.thisptr_offs);
+		}
+
+		void CHookContext::LeavePlan()
+		{
+			if (m_pPlan == NULL)
+				return;
+
+			SyncPlan();
+			*m_pPlanPos = -1;
+			m_pPlan = NULL;
 		}
 
 		void CHookContext::IfaceRemoved(CIface *iface)
@@ -851,21 +1506,12 @@ namespace SourceHook
 			if (pVfnPtr == vfnptr)
 			{
 				// Don't set pVfnPtr = NULL here!
-				// It may be used still.
-				// RevertAndRemoveVfnPtr uses it to find the hook context
-				// to which to attach the cleanup task of the vfnptr.
+				// It may be used still; the vfnptr is only retired,
+				// so it stays valid while we are on the stack.
 
 				//pVfnPtr = NULL;
 				m_State = State_Dead;
 			}
 		}
-
-		void CHookContext::DoCleanupTaskAndDeleteIt()
-		{
-			if (m_CleanupTask != NULL)
-			{
-				m_CleanupTask->CleanupAndDeleteThis();
-			}
-		}
 	}
 }
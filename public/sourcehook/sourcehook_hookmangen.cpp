@@ -18,7 +18,9 @@
 #include <stdio.h>
 #include "sourcehook_impl.h"
 #include "sourcehook_hookmangen.h"
+#if !defined(SH_HOOKMANGEN_AMD64)
 #include "sourcehook_hookmangen_x86.h"
+#endif
 #include "sh_memory.h"
 #include <stdarg.h>							// we might need the address of vsnprintf
 
@@ -36,8 +38,9 @@ namespace SourceHook
 {
 	namespace Impl
 	{
-		CPageAlloc GenBuffer::ms_Allocator(16);
+		CPageAlloc GenBuffer::ms_Allocator(16, true);
 
+#if !defined(SH_HOOKMANGEN_AMD64)
 		template <class T>
 		jit_int32_t DownCastPtr(T ptr)
 		{
@@ -48,12 +51,46 @@ namespace SourceHook
 		{
 			return static_cast<jit_uint32_t>(size);
 		}
+#endif
+
+		GenContext::GenContext(const ProtoInfo *proto, int vtbl_offs, int vtbl_idx, ISourceHook *pSHPtr,
+			GenContext *pSharedBody)
+			: m_GeneratedPubFunc(NULL), m_Proto(proto), m_VtblOffs(vtbl_offs), m_VtblIdx(vtbl_idx),
+			  m_SHPtr(pSHPtr), m_pSharedBody(pSharedBody), m_IsSharedBody(false), m_GeneratedBody(NULL),
+			  m_pPlan(NULL), m_pHI(NULL), m_HookfuncVfnptr(NULL)
+		{
+			Init();
+		}
+
+		GenContext::GenContext(const CProto &proto, ISourceHook *pSHPtr, const HookPlan *pPlan)
+			: m_GeneratedPubFunc(NULL), m_Proto(proto), m_VtblOffs(0), m_VtblIdx(0), m_SHPtr(pSHPtr),
+			  m_pSharedBody(NULL), m_IsSharedBody(true), m_GeneratedBody(NULL), m_pPlan(NULL), m_pHI(NULL),
+			  m_HookfuncVfnptr(NULL)
+		{
+			Init();
+
+			if (pPlan)
+			{
+				// Our code refers to it, keep a copy
+				for (int i = 0; i < pPlan->numSteps; ++i)
+					m_PlanSteps.push_back(pPlan->steps[i]);
+				m_Plan = *pPlan;
+				m_Plan.steps = &m_PlanSteps[0];
+				m_pPlan = &m_Plan;
+			}
+		}
 
-		GenContext::GenContext(const ProtoInfo *proto, int vtbl_offs, int vtbl_idx, ISourceHook *pSHPtr)
-			: m_GeneratedPubFunc(NULL), m_OrigProto(proto), m_Proto(proto), m_VtblOffs(vtbl_offs),
-			  m_VtblIdx(vtbl_idx), m_SHPtr(pSHPtr), m_pHI(NULL), m_HookfuncVfnptr(NULL), m_RegCounter(0)
+		void GenContext::Init()
 		{
-			m_pHI = new void*;
+#if !defined(SH_HOOKMANGEN_AMD64)
+			m_RegCounter = 0;
+#endif
+			m_pSite = new HookSite;
+			m_pSite->hi = NULL;
+			m_pSite->vtblOffs = m_VtblOffs;
+			m_pSite->vtblIdxOffs = m_VtblIdx * SIZE_PTR;
+			m_pSite->body = NULL;
+			m_pHI = &m_pSite->hi;
 			m_HookfuncVfnptr = new void*;
 			m_BuiltPI = new ProtoInfo;
 			m_BuiltPI_Params = NULL;
@@ -62,8 +99,10 @@ namespace SourceHook
 
 		GenContext::~GenContext()
 		{
+			for (size_t i = 0; i < m_SpecializedBodies.size(); ++i)
+				delete m_SpecializedBodies[i];
 			Clear();
-			delete m_pHI;
+			delete m_pSite;
 			delete m_HookfuncVfnptr;
 			delete m_BuiltPI;
 		}
@@ -140,6 +179,32 @@ namespace SourceHook
 			return x;
 		}
 		
+		bool GenContext::MemRetWithTempObj()
+		{
+			// Memory return AND (has destructor OR has assign operator)
+			return ((m_Proto.GetRet().flags & PassInfo::PassFlag_RetMem)
+				&& (m_Proto.GetRet().flags & (PassInfo::PassFlag_ODtor | PassInfo::PassFlag_AssignOp)));
+		}
+
+		void GenContext::ResetFrame(jit_int32_t startOffset)
+		{
+			m_HookFunc_FrameOffset = startOffset;
+			m_HookFunc_FrameVarsSize = 0;
+		}
+		
+		jit_int32_t GenContext::AddVarToFrame(jit_int32_t size)
+		{
+			m_HookFunc_FrameOffset -= size;
+			m_HookFunc_FrameVarsSize += size;
+			return m_HookFunc_FrameOffset;
+		}
+
+		jit_int32_t GenContext::ComputeVarsSize()
+		{
+			return m_HookFunc_FrameVarsSize;
+		}
+
+#if !defined(SH_HOOKMANGEN_AMD64)
 		// Computes size on the stack
 		jit_int32_t GenContext::GetParamStackSize(const IntPassInfo &info)
 		{
@@ -676,13 +741,6 @@ namespace SourceHook
 			}
 		}
 
-		bool GenContext::MemRetWithTempObj()
-		{
-			// Memory return AND (has destructor OR has assign operator)
-			return ((m_Proto.GetRet().flags & PassInfo::PassFlag_RetMem)
-				&& (m_Proto.GetRet().flags & (PassInfo::PassFlag_ODtor | PassInfo::PassFlag_AssignOp)));
-		}
-
 		void GenContext::ProcessPluginRetVal(int v_cur_res, int v_pContext, int v_plugin_ret)
 		{
 			// only for non-void functions!
@@ -1336,24 +1394,6 @@ namespace SourceHook
 			GCC_ONLY(IA32_Add_Rm_Imm8(&m_HookFunc, REG_ESP, 2*SIZE_PTR, MOD_REG));
 		}
 
-		void GenContext::ResetFrame(jit_int32_t startOffset)
-		{
-			m_HookFunc_FrameOffset = startOffset;
-			m_HookFunc_FrameVarsSize = 0;
-		}
-		
-		jit_int32_t GenContext::AddVarToFrame(jit_int32_t size)
-		{
-			m_HookFunc_FrameOffset -= size;
-			m_HookFunc_FrameVarsSize += size;
-			return m_HookFunc_FrameOffset;
-		}
-
-		jit_int32_t GenContext::ComputeVarsSize()
-		{
-			return m_HookFunc_FrameVarsSize;
-		}
-		
 		void * GenContext::GenerateHookFunc()
 		{
 			// prologue
@@ -1754,7 +1794,8 @@ namespace SourceHook
 			IA32_Push_Imm32(&m_PubFunc, DownCastPtr(m_BuiltPI));
 			IA32_Push_Imm32(&m_PubFunc, m_VtblIdx);
 			IA32_Push_Imm32(&m_PubFunc, m_VtblOffs);
-			IA32_Push_Imm32(&m_PubFunc, SH_HOOKMAN_VERSION);
+			// Version 1: our hook funcs don't pass their parameters, so they don't support parameter filters
+			IA32_Push_Imm32(&m_PubFunc, 1);
 
 			//  hi == this is in ecx
 			//  on gcc/mingw, ecx is the first parameter
@@ -1792,6 +1833,7 @@ namespace SourceHook
 
 			return m_PubFunc;
 		}
+#endif
 
 		bool GenContext::PassInfoSupported(const IntPassInfo &pi, bool is_ret)
 		{
@@ -1831,9 +1873,47 @@ namespace SourceHook
 			{
 				return false;			 // Neither byval nor byref!
 			}
+
+#if defined(SH_HOOKMANGEN_AMD64)
+			if (pi.flags & PassInfo::PassFlag_ByVal)
+			{
+				// We only know how to move whole registers
+				if (pi.type == PassInfo::PassType_Basic &&
+					pi.size != 1 && pi.size != 2 && pi.size != 4 && pi.size != 8)
+				{
+					return false;
+				}
+
+				if (pi.type == PassInfo::PassType_Float && pi.size != 4 && pi.size != 8)
+				{
+					return false;
+				}
+
+				if (pi.type == PassInfo::PassType_Object)
+				{
+					// Objects are returned in rax:rdx at most
+					if (is_ret && (pi.flags & PassInfo::PassFlag_RetReg) && pi.size > 16)
+					{
+						return false;
+					}
+
+					// Objects of up to 16 bytes which are passed or returned in registers are split into
+					// eightbytes that go to general purpose or SSE registers depending on their member types.
+					// PassInfo doesn't describe those, so we only handle the all-integer case and only if
+					// the user says so.
+					bool inRegs = is_ret ? (pi.flags & PassInfo::PassFlag_RetReg) != 0 :
+						(pi.size <= 16 && !(pi.flags & PassFlag_ForcedByRef));
+					if (inRegs && !(pi.flags & PassInfo::PassFlag_IntClass))
+					{
+						return false;
+					}
+				}
+			}
+#endif
 			return true;
 		}
 
+#if !defined(SH_HOOKMANGEN_AMD64)
 		void GenContext::AutoDetectRetType()
 		{
 			IntPassInfo &pi = m_Proto.GetRet();
@@ -1900,11 +1980,19 @@ namespace SourceHook
 			}
 #endif
 		}
+#endif
 
-		HookManagerPubFunc GenContext::Generate()
+		bool GenContext::Prepare()
 		{
 			Clear();
 
+#if defined(SH_HOOKMANGEN_AMD64) && SH_COMP == SH_COMP_MSVC
+			// The x86-64 backend only emits System V AMD64 code. The Microsoft x64 convention
+			// (rcx/rdx/r8/r9 plus shadow space, odd-sized aggregates by reference) is not supported,
+			// so no hook manager can be generated on Win64.
+			return false;
+#endif
+
 			// Check conditions:
 			// -1) good proto version
 			//  0) we don't support unknown passtypes, convention, ...
@@ -1914,7 +2002,7 @@ namespace SourceHook
 
 			if (m_Proto.GetVersion() < 1)
 			{
-				return NULL;
+				return false;
 			}
 
 			AutoDetectRetType();
@@ -1923,23 +2011,36 @@ namespace SourceHook
 			// Basically, we only support ThisCall/thiscall with varargs
 			if ((m_Proto.GetConvention() & (~ProtoInfo::CallConv_HasVafmt)) != ProtoInfo::CallConv_ThisCall)
 			{
-				return NULL;
+				return false;
 			}
 
 
 			if (m_Proto.GetRet().size != 0 && !PassInfoSupported(m_Proto.GetRet(), true))
 			{
-				return NULL;
+				return false;
 			}
 
 			for (int i = 0; i < m_Proto.GetNumOfParams(); ++i)
 			{
 				if (!PassInfoSupported(m_Proto.GetParam(i), false))
-					return NULL;
+					return false;
 			}
 
 			BuildProtoInfo();
-			GenerateHookFunc();
+			return true;
+		}
+
+		HookManagerPubFunc GenContext::Generate()
+		{
+			if (!Prepare())
+				return NULL;
+
+#if defined(SH_HOOKMANGEN_AMD64)
+			if (m_pSharedBody)
+				GenerateHookFuncStub();
+			else
+#endif
+				GenerateHookFunc();
 			return fastdelegate::detail::horrible_cast<HookManagerPubFunc>(GeneratePubFunc());
 		}
 
@@ -1951,26 +2052,61 @@ namespace SourceHook
 			return m_GeneratedPubFunc;
 		}
 
-		bool GenContext::Equal(const CProto &proto, int vtbl_offs, int vtbl_idx)
+		void *GenContext::GetSharedBody()
+		{
+			if (m_GeneratedBody == NULL && Prepare())
+				m_GeneratedBody = GenerateHookFunc();
+
+			return m_GeneratedBody;
+		}
+
+		void GenContext::SetSpecializedBody(GenContext *pBody)
+		{
+			// Hook funcs which are running on other threads may still be in the old body,
+			// so specialized bodies are only deleted together with us
+			if (pBody)
+			{
+				m_SpecializedBodies.push_back(pBody);
+				m_pSite->body.store(pBody->GetSharedBody(), std::memory_order_release);
+			}
+			else if (m_pSharedBody)
+			{
+				m_pSite->body.store(m_pSharedBody->GetSharedBody(), std::memory_order_release);
+			}
+		}
+
+		size_t GenContext::GetNumSpecializedBodies()
 		{
-			return (m_OrigProto.ExactlyEqual(proto) && m_VtblOffs == vtbl_offs && m_VtblIdx == vtbl_idx);
+			return m_SpecializedBodies.size();
 		}
 
-		bool GenContext::Equal(HookManagerPubFunc other)
+		bool GenContext::CanShareBodies()
 		{
-			return m_GeneratedPubFunc == other;
+			// The 32-bit generator still embeds the vtable index into each hook func
+#if defined(SH_HOOKMANGEN_AMD64)
+			return true;
+#else
+			return false;
+#endif
 		}
 
 		// *********************************** class GenContextContainer
-		CHookManagerAutoGen::CHookManagerAutoGen(ISourceHook *pSHPtr) : m_pSHPtr(pSHPtr)
+		CHookManagerAutoGen::CHookManagerAutoGen(ISourceHook *pSHPtr) : m_pSHPtr(pSHPtr), m_Specialize(false)
 		{
 		}
 
 		CHookManagerAutoGen::~CHookManagerAutoGen()
 		{
-			for (List<StoredContext>::iterator iter = m_Contexts.begin(); iter != m_Contexts.end(); ++iter)
+			DisableSpecialization();
+
+			// Stubs first, they jump into the bodies
+			for (THash<ContextKey, StoredContext>::iterator iter = m_Contexts.begin(); iter != m_Contexts.end(); ++iter)
 			{
-				delete iter->m_GenContext;
+				delete iter->val.m_GenContext;
+			}
+			for (THash<CProtoRef, StoredContext>::iterator iter = m_Bodies.begin(); iter != m_Bodies.end(); ++iter)
+			{
+				delete iter->val.m_GenContext;
 			}
 		}
 
@@ -1984,49 +2120,183 @@ namespace SourceHook
 			return SH_HOOKMANAUTOGEN_IMPL_VERSION;
 		}
 
-		HookManagerPubFunc CHookManagerAutoGen::MakeHookMan(const ProtoInfo *proto, int vtbl_offs, int vtbl_idx)
+		GenContext *CHookManagerAutoGen::AcquireBody(const CProtoRef &key)
 		{
-			CProto mproto(proto);
-			for (List<StoredContext>::iterator iter = m_Contexts.begin(); iter != m_Contexts.end(); ++iter)
+			StoredContext *pStored = m_Bodies.retrieve(key);
+			if (pStored)
 			{
-				if (iter->m_GenContext->Equal(mproto, vtbl_offs, vtbl_idx))
-				{
-					iter->m_RefCnt++;
-					return iter->m_GenContext->GetPubFunc();
-				}
+				pStored->m_RefCnt++;
+				return pStored->m_GenContext;
+			}
+
+			GenContext *body = new GenContext(*key, m_pSHPtr);
+			if (body->GetSharedBody() == NULL)
+			{
+				delete body;
+				return NULL;
 			}
 
-			// Not found yet -> new one
-			StoredContext sctx;
+			StoredContext &sctx = m_Bodies[key];
 			sctx.m_RefCnt = 1;
-			sctx.m_GenContext = new GenContext(proto, vtbl_offs, vtbl_idx, m_pSHPtr);
+			sctx.m_GenContext = body;
+			return body;
+		}
 
-			if (sctx.m_GenContext->GetPubFunc() == NULL)
+		void CHookManagerAutoGen::ReleaseBody(const CProtoRef &key)
+		{
+			StoredContext *pStored = m_Bodies.retrieve(key);
+			if (pStored && --pStored->m_RefCnt == 0)
 			{
-				return NULL;
+				delete pStored->m_GenContext;
+				m_Bodies.remove(key);
 			}
-			else
+		}
+
+		HookManagerPubFunc CHookManagerAutoGen::MakeHookMan(const ProtoInfo *proto, int vtbl_offs, int vtbl_idx)
+		{
+			ContextKey key(CProtoRef(proto), vtbl_offs, vtbl_idx);
+
+			std::lock_guard<std::mutex> lock(m_Lock);
+
+			StoredContext *pStored = m_Contexts.retrieve(key);
+			if (pStored)
 			{
-				m_Contexts.push_back(sctx);
-				return sctx.m_GenContext->GetPubFunc();
+				pStored->m_RefCnt++;
+				return pStored->m_GenContext->GetPubFunc();
+			}
+
+			// Not found yet -> new one; it shares its hook func body with the other vtable indices
+			// of this proto if possible
+			GenContext *body = NULL;
+			if (GenContext::CanShareBodies())
+			{
+				body = AcquireBody(key.proto);
+				if (body == NULL)
+					return NULL;
 			}
+
+			GenContext *context = new GenContext(proto, vtbl_offs, vtbl_idx, m_pSHPtr, body);
+			HookManagerPubFunc pubFunc = context->GetPubFunc();
+			if (pubFunc == NULL)
+			{
+				delete context;
+				if (body)
+					ReleaseBody(key.proto);
+				return NULL;
+			}
+
+			StoredContext &sctx = m_Contexts[key];
+			sctx.m_RefCnt = 1;
+			sctx.m_GenContext = context;
+			m_PubFuncs[fastdelegate::detail::horrible_cast<void*>(pubFunc)] = key;
+			return pubFunc;
 		}
 
 		void CHookManagerAutoGen::ReleaseHookMan(HookManagerPubFunc pubFunc)
 		{
-			for (List<StoredContext>::iterator iter = m_Contexts.begin(); iter != m_Contexts.end(); ++iter)
+			void *pubFuncPtr = fastdelegate::detail::horrible_cast<void*>(pubFunc);
+
+			std::lock_guard<std::mutex> lock(m_Lock);
+			ContextKey *pKey = m_PubFuncs.retrieve(pubFuncPtr);
+			if (pKey == NULL)
+				return;
+
+			ContextKey key = *pKey;
+			StoredContext *pStored = m_Contexts.retrieve(key);
+			if (--pStored->m_RefCnt == 0)
 			{
-				if (iter->m_GenContext->Equal(pubFunc))
-				{
-					iter->m_RefCnt--;
-					if (iter->m_RefCnt == 0)
-					{
-						delete iter->m_GenContext;
-						m_Contexts.erase(iter);
-					}
-					break;
-				}
+				delete pStored->m_GenContext;
+				m_Contexts.remove(key);
+				m_PubFuncs.remove(pubFuncPtr);
+
+				if (GenContext::CanShareBodies())
+					ReleaseBody(key.proto);
+			}
+		}
+
+		void CHookManagerAutoGen::EnableSpecialization()
+		{
+			// Hook funcs can only be swapped behind a stub
+			if (m_Specialize || !GenContext::CanShareBodies() || m_pSHPtr->GetImplVersion() < 8)
+				return;
+
+			m_Specialize = true;
+			m_pSHPtr->AddHookPlanListener(this);
+		}
+
+		void CHookManagerAutoGen::DisableSpecialization()
+		{
+			if (!m_Specialize)
+				return;
+
+			// SourceHook holds its own lock while it calls us, so it has to be left first
+			m_Specialize = false;
+			m_pSHPtr->RemoveHookPlanListener(this);
+
+			std::lock_guard<std::mutex> lock(m_Lock);
+			for (THash<ContextKey, StoredContext>::iterator iter = m_Contexts.begin(); iter != m_Contexts.end(); ++iter)
+			{
+				iter->val.m_GenContext->SetSpecializedBody(NULL);
 			}
 		}
+
+		void CHookManagerAutoGen::HookPlanChanged(HookManagerPubFunc pubFunc, IHookManagerInfo *hi, void *vfnptr)
+		{
+			// The code grows with each step, and a slot whose hooks keep changing isn't worth it
+			const int MaxPlanSteps = 16;
+			const size_t MaxSpecializedBodies = 16;
+
+			std::lock_guard<std::mutex> lock(m_Lock);
+			ContextKey *pKey = m_PubFuncs.retrieve(fastdelegate::detail::horrible_cast<void*>(pubFunc));
+			if (pKey == NULL)
+				return;						// Not one of ours
+			GenContext *context = m_Contexts.retrieve(*pKey)->m_GenContext;
+
+			// The old plan is outdated; hook funcs on it would fall back to the hook loop anyway
+			context->SetSpecializedBody(NULL);
+			if (context->GetNumSpecializedBodies() >= MaxSpecializedBodies)
+				return;
+
+			HookPlanStep steps[MaxPlanSteps];
+			HookPlan plan;
+			plan.steps = steps;
+			if (!m_pSHPtr->GetHookPlan(hi, vfnptr, &plan, MaxPlanSteps) || plan.numSteps <= 1)
+				return;
+
+			GenContext *body = new GenContext(*pKey->proto, m_pSHPtr, &plan);
+			if (body->GetSharedBody() == NULL)
+			{
+				delete body;
+				return;
+			}
+			context->SetSpecializedBody(body);
+		}
+	}
+
+	template<>
+	int HashFunction<Impl::CHookManagerAutoGen::ContextKey>(const Impl::CHookManagerAutoGen::ContextKey & k)
+	{
+		return static_cast<int>(k.proto.Hash()) ^ (k.vtbl_idx * 31 + k.vtbl_offs);
+	}
+	template<>
+	int Compare<Impl::CHookManagerAutoGen::ContextKey>(const Impl::CHookManagerAutoGen::ContextKey & k1,
+		const Impl::CHookManagerAutoGen::ContextKey & k2)
+	{
+		if (k1.proto != k2.proto)
+			return 1;
+		if (k1.vtbl_offs != k2.vtbl_offs)
+			return Compare<int>(k1.vtbl_offs, k2.vtbl_offs);
+		return Compare<int>(k1.vtbl_idx, k2.vtbl_idx);
+	}
+	template<>
+	int HashFunction<Impl::CProtoRef>(const Impl::CProtoRef & k)
+	{
+		return static_cast<int>(k.Hash());
+	}
+	template<>
+	int Compare<Impl::CProtoRef>(const Impl::CProtoRef & k1, const Impl::CProtoRef & k2)
+	{
+		// Interned: equal iff same
+		return k1 == k2 ? 0 : 1;
 	}
 }
@@ -11,8 +11,16 @@
 #ifndef __SOURCEHOOK_HOOKMANGEN_H__
 #define __SOURCEHOOK_HOOKMANGEN_H__
 
+#include <atomic>
+#include <mutex>
 #include "sh_pagealloc.h"
 
+// The code generator emits either 32-bit x86 code (cdecl / thiscall, see sourcehook_hookmangen.cpp)
+// or x86-64 code for the System V AMD64 ABI (see sourcehook_hookmangen_x86_64.cpp)
+#if defined(__x86_64__) || defined(__amd64__) || defined(_M_X64) || defined(_M_AMD64)
+# define SH_HOOKMANGEN_AMD64
+#endif
+
 namespace SourceHook
 {
 	namespace Impl
@@ -44,11 +52,12 @@ namespace SourceHook
 			static CPageAlloc ms_Allocator;
 
 			unsigned char *m_pData;
+			unsigned char *m_pWritable;		// same memory as m_pData, maybe mapped somewhere else
 			jitoffs_t m_Size;
 			jitoffs_t m_AllocatedSize;
 
 		public:
-			GenBuffer() : m_pData(NULL), m_Size(0), m_AllocatedSize(0)
+			GenBuffer() : m_pData(NULL), m_pWritable(NULL), m_Size(0), m_AllocatedSize(0)
 			{
 			}
 			~GenBuffer()
@@ -86,8 +95,9 @@ namespace SourceHook
 						SH_ASSERT(0, ("bad_alloc: couldn't allocate 0x%08X bytes of memory\n", m_AllocatedSize));
 						return;
 					}
-					memset((void*)newBuf, 0xCC, m_AllocatedSize);			// :TODO: remove this !
-					memcpy((void*)newBuf, (const void*)m_pData, m_Size);
+					unsigned char *newWritable = reinterpret_cast<unsigned char*>(ms_Allocator.GetWritable(newBuf));
+					memset((void*)newWritable, 0xCC, m_AllocatedSize);			// :TODO: remove this !
+					memcpy((void*)newWritable, (const void*)m_pWritable, m_Size);
 					if (m_pData)
 					{
 						ms_Allocator.SetRE(reinterpret_cast<void*>(m_pData));
@@ -95,8 +105,9 @@ namespace SourceHook
 						ms_Allocator.Free(reinterpret_cast<void*>(m_pData));
 					}
 					m_pData = newBuf;
+					m_pWritable = newWritable;
 				}
-				memcpy((void*)(m_pData + m_Size), (const void*)data, size);
+				memcpy((void*)(m_pWritable + m_Size), (const void*)data, size);
 				m_Size = newSize;
 			}
 
@@ -109,7 +120,7 @@ namespace SourceHook
 			{
 				SH_ASSERT(offset + size <= m_AllocatedSize, ("rewrite too far"));
 
-				memcpy((void*)(m_pData + offset), (const void*)data, size);
+				memcpy((void*)(m_pWritable + offset), (const void*)data, size);
 			}
 
 			void clear()
@@ -117,6 +128,7 @@ namespace SourceHook
 				if (m_pData)
 					ms_Allocator.Free(reinterpret_cast<void*>(m_pData));
 				m_pData = NULL;
+				m_pWritable = NULL;
 				m_Size = 0;
 				m_AllocatedSize = 0;
 			}
@@ -140,6 +152,9 @@ namespace SourceHook
 			void write_uint32(jit_uint32_t x)		{ push(x); }
 			void write_int32(jit_uint32_t x)		{ push(x); }
 
+			void write_uint64(jit_uint64_t x)		{ push(x); }
+			void write_int64(jit_int64_t x)			{ push(x); }
+
 			jitoffs_t get_outputpos()
 			{
 				return m_Size;
@@ -157,18 +172,37 @@ namespace SourceHook
 
 		class GenContext
 		{
-			const static int SIZE_MWORD = 4;
 			const static int SIZE_PTR = sizeof(void*);
 			const static int PassFlag_ForcedByRef = (1<<30);   // ByVal in source, but actually passed by reference (GCC) -> private pass, destruct
 
 			HookManagerPubFunc m_GeneratedPubFunc;
 
-			CProto m_OrigProto;			// original passed-in prototype
 			CProto m_Proto;
 			int m_VtblOffs;
 			int m_VtblIdx;
 			ISourceHook *m_SHPtr;
 
+			// Hook funcs of contexts with the same proto may share one body (see CanShareBodies).
+			// The body is then generated by a separate context, and our hook func is only a stub
+			// which passes our HookSite to it.
+			struct HookSite
+			{
+				void *hi;					// *m_pHI
+				intptr_t vtblOffs;
+				intptr_t vtblIdxOffs;		// m_VtblIdx * SIZE_PTR
+				std::atomic<void*> body;	// where the stub jumps to
+			};
+			HookSite *m_pSite;
+			GenContext *m_pSharedBody;		// we are a stub into this one's hook func
+			bool m_IsSharedBody;			// we are a body; the stub passes the site
+			void *m_GeneratedBody;
+
+			// Specialized bodies call the handlers of a hook plan directly (see SetSpecializedBody)
+			const HookPlan *m_pPlan;		// NULL or &m_Plan
+			HookPlan m_Plan;
+			CVector<HookPlanStep> m_PlanSteps;
+			CVector<GenContext*> m_SpecializedBodies;
+
 			GenBuffer m_HookFunc;
 			GenBuffer m_PubFunc;
 
@@ -180,6 +214,23 @@ namespace SourceHook
 			void **m_pHI;
 			void **m_HookfuncVfnptr;
 
+			// size info
+			jit_int32_t GetRealSize(const IntPassInfo &info);			// checks for reference
+			jit_int32_t AlignSize(jit_int32_t x, jit_int32_t boundary);	// align a size
+
+			// HookFunc frame
+			jit_int32_t m_HookFunc_FrameOffset;
+			jit_int32_t m_HookFunc_FrameVarsSize;
+
+			void ResetFrame(jit_int32_t startOffset);
+			jit_int32_t AddVarToFrame(jit_int32_t size);
+			jit_int32_t ComputeVarsSize();
+
+			bool MemRetWithTempObj();			// do we do a memory return AND need a temporary place for it?
+
+#if !defined(SH_HOOKMANGEN_AMD64)
+			const static int SIZE_MWORD = 4;
+
 			// Level 3 - Helpers
 			int m_RegCounter;
 			jit_int8_t NextRegEBX_ECX_EDX();
@@ -196,8 +247,6 @@ namespace SourceHook
 			void CheckAlignmentBeforeCall();
 
 			// size info
-			jit_int32_t GetRealSize(const IntPassInfo &info);			// checks for reference
-			jit_int32_t AlignSize(jit_int32_t x, jit_int32_t boundary);	// align a size
 			jit_int32_t GetParamStackSize(const IntPassInfo &info);		// get the size of a param in the param stack
 			short GetParamsTotalStackSize();		// sum(GetParamStackSize(param[i]), 0 <= i < numOfParams)
 
@@ -205,15 +254,6 @@ namespace SourceHook
 			void BitwiseCopy_Setup();
 			void BitwiseCopy_Do(size_t size);
 
-
-			// HookFunc frame
-			jit_int32_t m_HookFunc_FrameOffset;
-			jit_int32_t m_HookFunc_FrameVarsSize;
-
-			void ResetFrame(jit_int32_t startOffset);
-			jit_int32_t AddVarToFrame(jit_int32_t size);
-			jit_int32_t ComputeVarsSize();
-
 			// Param push
 			short GetForcedByRefParamsSize();		// sum(param[i] is forcedbyref ? GetStackSize(param[i]) : 0, 0 <= i < numOfParams)
 			short GetForcedByRefParamOffset(int p);		// sum(param[i] is forcedbyref ? GetStackSize(param[i]) : 0, 0 <= i < p)
@@ -233,8 +273,6 @@ namespace SourceHook
 			void PrepareReturn(jit_int32_t v_status, jit_int32_t v_pContext, jit_int32_t v_retptr);
 			void DoReturn(jit_int32_t v_retptr, jit_int32_t v_memret_outaddr);
 
-			bool MemRetWithTempObj();			// do we do a memory return AND need a temporary place for it?
-
 			// Call hooks
 			void GenerateCallHooks(int v_status, int v_prev_res, int v_cur_res, int v_iter,
 				int v_pContext, int base_param_offset, int v_plugin_ret, int v_place_for_memret, jit_int32_t v_place_fbrr_base, jit_int32_t v_va_buf);
@@ -249,6 +287,86 @@ namespace SourceHook
 				int v_this, int v_pContext);
 
 			void CallEndContext(int v_pContext);
+#else
+			// System V AMD64: where an argument of the hook func lives. The hook func spills
+			// its argument registers to a register save area, so every parameter has an address
+			// in the frame. Callees with the same parameter list (the delegates and the original
+			// function) take each parameter in the very same register or stack slot.
+			struct ArgLoc
+			{
+				enum Kind
+				{
+					Kind_GP,				// index = first GP register, count = number of eightbytes
+					Kind_SSE,				// index = SSE register
+					Kind_Stack				// index = offset in the stack argument area, count = size in bytes
+				};
+				Kind kind;
+				int index;
+				int count;
+			};
+			CVector<ArgLoc> m_ParamLocs;
+			int m_NumGPArgs;				// argument registers used by [memret ptr,] this and the params
+			int m_NumSSEArgs;
+			jit_int32_t m_StackArgsSize;
+
+			void ComputeArgLocs();
+			ArgLoc NextPtrArg(int &num_gp, jit_int32_t &stack_size);	// location of an extra pointer argument
+
+			// Frame variables
+			jit_int32_t m_RegSaveArea;		// rdi, rsi, rdx, rcx, r8, r9, then xmm0-7 (16 bytes each)
+			jit_int32_t m_OutArgsSize;		// outgoing stack arguments, at rsp
+
+			jit_int32_t ArgAddr(const ArgLoc &loc, int eightbyte = 0);	// frame address of an incoming argument
+			jit_int32_t m_SiteVar;			// shared bodies: the HookSite pointer, passed in r11
+			jit_int32_t m_PlanPosVar;		// specialized bodies: the hook plan position (see BeginHookPlan)
+			void LoadThisPtr(jit_uint8_t reg);
+			int GetNumSavedGP();
+			int GetNumSavedSSE();
+			void SaveArgRegs(jit_int32_t v_saved_rax);
+			void RestoreArgRegs(jit_int32_t v_saved_rax);
+
+			// Helpers
+			void CallAbs(const void *func);
+			void BitwiseCopy(size_t size);				// [rdi] <- [rsi]
+			jit_int32_t GetForcedByRefParamsSize();
+			jit_int32_t GetForcedByRefParamOffset(int p);
+
+			// Params
+			void PassParams(jit_int32_t v_place_fbrr_base);
+			void PassPtrArg(const ArgLoc &loc, jit_uint8_t src_reg);
+			void DestroyParams(jit_int32_t v_place_fbrr_base);
+
+			// Ret val processing
+			void SaveRetVal(jit_int32_t v_where, jit_int32_t v_place_for_memret);
+			void ProcessPluginRetVal(jit_int32_t v_cur_res, jit_int32_t v_pContext, jit_int32_t v_plugin_ret);
+			void PrepareReturn(jit_int32_t v_status, jit_int32_t v_pContext, jit_int32_t v_retptr);
+			void DoReturn(jit_int32_t v_retptr);
+			void CallRetCtorDtor(const void *func, jit_int32_t v_obj);
+
+			// Hook loop
+			void GenerateVfnPtrArgs();				// rsi = hi, rdx = our vfnptr, rcx = this
+			void *GenerateHookFuncStub();			// r11 = site, jump to the shared body
+			void GenerateBypass(jit_int32_t v_saved_rax, jit_int32_t v_vfnptr_origentry);
+			void GenerateVafmt(jit_int32_t v_va_list, jit_int32_t v_va_buf);
+			void GenerateCallHook(jit_int32_t v_status, jit_int32_t v_prev_res, jit_int32_t v_cur_res, jit_int32_t v_iter,
+				jit_int32_t v_pContext, jit_int32_t v_plugin_ret, jit_int32_t v_place_for_memret,
+				jit_int32_t v_place_fbrr_base, jit_int32_t v_va_buf);		// handler in rax
+			void GenerateCallHooks(jit_int32_t v_status, jit_int32_t v_prev_res, jit_int32_t v_cur_res, jit_int32_t v_iter,
+				jit_int32_t v_pContext, jit_int32_t v_plugin_ret, jit_int32_t v_place_for_memret,
+				jit_int32_t v_place_fbrr_base, jit_int32_t v_va_buf, bool post);
+			void GeneratePlanSteps(jit_int32_t v_status, jit_int32_t v_prev_res, jit_int32_t v_cur_res, jit_int32_t v_iter,
+				jit_int32_t v_pContext, jit_int32_t v_plugin_ret, jit_int32_t v_place_for_memret,
+				jit_int32_t v_place_fbrr_base, jit_int32_t v_va_buf, bool post,
+				CVector<jitoffs_t> &toLoop, CVector<jitoffs_t> &toExit);
+			void CallBeginHookPlan(jit_int32_t v_pContext);
+			void GenerateCallOrig(jit_int32_t v_status, jit_int32_t v_pContext, jit_int32_t v_vfnptr_origentry,
+				jit_int32_t v_orig_ret, jit_int32_t v_override_ret, jit_int32_t v_place_for_memret,
+				jit_int32_t v_place_fbrr_base, jit_int32_t v_va_buf);
+			void CallSetupHookLoop(jit_int32_t v_orig_ret, jit_int32_t v_override_ret,
+				jit_int32_t v_cur_res, jit_int32_t v_prev_res, jit_int32_t v_status, jit_int32_t v_vfnptr_origentry,
+				jit_int32_t v_pContext);
+			void CallEndContext(jit_int32_t v_pContext);
+#endif
 
 			// Level 2 -> called from Generate()
 			void AutoDetectRetType();
@@ -258,29 +376,66 @@ namespace SourceHook
 			void BuildProtoInfo();
 			void *GenerateHookFunc();
 			void *GeneratePubFunc();
-			
+
+			void Init();
+			bool Prepare();
 			HookManagerPubFunc Generate();
 		public:
 			// Level 1 -> Public interface
-			GenContext(const ProtoInfo *proto, int vtbl_offs, int vtbl_idx, ISourceHook *pSHPtr);
+			GenContext(const ProtoInfo *proto, int vtbl_offs, int vtbl_idx, ISourceHook *pSHPtr,
+				GenContext *pSharedBody = NULL);
+
+			// A shared hook func body for the proto; with a plan, one that calls the plan's handlers
+			GenContext(const CProto &proto, ISourceHook *pSHPtr, const HookPlan *pPlan = NULL);
 			~GenContext();
 
-			bool Equal(const CProto &proto, int vtbl_offs, int vtbl_idx);
-			bool Equal(HookManagerPubFunc other);
+			// Whether this code generator supports shared bodies
+			static bool CanShareBodies();
 
 			HookManagerPubFunc GetPubFunc();
+			void *GetSharedBody();
+
+			// Stubs only: makes the stub jump to a specialized body (which we delete later on),
+			// or back to the shared body if pBody is NULL
+			void SetSpecializedBody(GenContext *pBody);
+			size_t GetNumSpecializedBodies();
 		};
 
-		class CHookManagerAutoGen : public IHookManagerAutoGen 
+		class CHookManagerAutoGen : public IHookManagerAutoGen, public IHookPlanListener
 		{
+		public:
+			struct ContextKey
+			{
+				CProtoRef proto;
+				int vtbl_offs;
+				int vtbl_idx;
+
+				ContextKey() : vtbl_offs(0), vtbl_idx(0)
+				{
+				}
+				ContextKey(const CProtoRef &pproto, int pvo, int pvi) : proto(pproto), vtbl_offs(pvo),
+					vtbl_idx(pvi)
+				{
+				}
+			};
+		private:
 			struct StoredContext
 			{
 				int m_RefCnt;
 				GenContext *m_GenContext;
 			};
-			List<StoredContext> m_Contexts;
+			THash<ContextKey, StoredContext> m_Contexts;	// (proto, vtbl_offs, vtbl_idx) -> hook manager
+			THash<void*, ContextKey> m_PubFuncs;			// pubfunc -> key of its hook manager
+			THash<CProtoRef, StoredContext> m_Bodies;		// proto -> shared hook func body
 			ISourceHook *m_pSHPtr;
 
+			// HookPlanChanged comes from whichever thread changes hooks
+			std::mutex m_Lock;
+			bool m_Specialize;
+
+			GenContext *AcquireBody(const CProtoRef &key);
+			void ReleaseBody(const CProtoRef &key);
+
 		public:
 			CHookManagerAutoGen(ISourceHook *pSHPtr);
 			~CHookManagerAutoGen();
@@ -290,9 +445,30 @@ namespace SourceHook
 
 			HookManagerPubFunc MakeHookMan(const ProtoInfo *proto, int vtbl_offs, int vtbl_idx);
 			void ReleaseHookMan(HookManagerPubFunc pubFunc);
+
+			/**
+			*	@brief Regenerate hook funcs whenever their hooks change, so that they call the
+			*	handlers directly instead of asking SourceHook for each one.
+			*
+			*	Only has an effect with shared bodies (see GenContext::CanShareBodies).
+			*/
+			void EnableSpecialization();
+
+			/**
+			*	@brief Go back to the shared hook func bodies. Has to be called before the
+			*	ISourceHook instance goes away if specialization was enabled.
+			*/
+			void DisableSpecialization();
+			void HookPlanChanged(HookManagerPubFunc pubFunc, IHookManagerInfo *hi, void *vfnptr);
 		};
 
 	}
+
+	template<> int HashFunction<Impl::CHookManagerAutoGen::ContextKey>(const Impl::CHookManagerAutoGen::ContextKey & k);
+	template<> int Compare<Impl::CHookManagerAutoGen::ContextKey>(const Impl::CHookManagerAutoGen::ContextKey & k1,
+		const Impl::CHookManagerAutoGen::ContextKey & k2);
+	template<> int HashFunction<Impl::CProtoRef>(const Impl::CProtoRef & k);
+	template<> int Compare<Impl::CProtoRef>(const Impl::CProtoRef & k1, const Impl::CProtoRef & k2);
 }
 
 
@@ -0,0 +1,1375 @@
+/* ======== SourceHook ========
+* Copyright (C) 2004-2010 Metamod:Source Development Team
+* No warranties of any kind
+*
+* License: zlib/libpng
+*
+* ============================
+*/
+
+// x86-64 code generator for the System V AMD64 ABI (Linux, Mac OS X).
+//
+// recommended literature:
+// System V Application Binary Interface, AMD64 Architecture Processor Supplement
+//   3.2 Function Calling Sequence
+//
+// Overview:
+//  - integer class arguments (pointers, integers, references, small PODs)
+//    are passed in rdi, rsi, rdx, rcx, r8, r9; floats and doubles in xmm0-7;
+//    everything else on the stack in 8 byte slots.
+//  - this is the first integer argument. If the return value is passed in memory,
+//    the address to store it at comes before this.
+//  - objects with a non-trivial copy constructor or destructor are passed by invisible
+//    reference: the caller makes a copy, passes its address and destructs it afterwards.
+//  - the hook func spills the argument registers to a register save area (like a varargs
+//    function would). The delegates and the original function take the same parameter
+//    list, so every parameter can be passed on in exactly the register / stack slot it
+//    came in.
+//
+// Objects which are passed or returned in registers are assumed to consist of integer
+// class eightbytes (PassInfo can't tell us whether a struct only contains floats).
+
+#include <stdio.h>
+#include "sourcehook_impl.h"
+#include "sourcehook_hookmangen.h"
+
+#if defined(SH_HOOKMANGEN_AMD64)
+
+#include "sourcehook_hookmangen_x86_64.h"
+#include "sh_memory.h"
+#include <stdarg.h>							// we need the address of vsnprintf
+
+namespace SourceHook
+{
+	namespace Impl
+	{
+		namespace
+		{
+			// Integer argument registers, in order
+			const jit_uint8_t GPArgRegs[] = { REG_RDI, REG_RSI, REG_RDX, REG_RCX, REG_R8, REG_R9 };
+			const int NumGPArgRegs = 6;
+			const int NumSSEArgRegs = 8;
+
+			// The register save area: the integer registers, then 16 bytes per SSE register
+			const jit_int32_t RegSaveAreaSize = NumGPArgRegs * 8 + NumSSEArgRegs * 16;
+
+			// Stack arguments begin after the saved rbp and the return address
+			const jit_int32_t IncomingArgsOffs = 16;
+
+			// vtable indices
+			const int ISourceHook_SetupHookLoop = 19;
+			const int ISourceHook_EndContext = 20;
+			const int ISourceHook_BeginHookPlan = 26;
+			const int ISourceHook_SetupHookLoopParams = 28;
+			const int IHookContext_GetNext = 0;
+			const int IHookContext_GetOverrideRetPtr = 1;
+			const int IHookContext_GetOrigRetPtr = 2;
+			const int IHookContext_ShouldCallOrig = 3;
+			const int ISHDelegate_Call = 2;
+
+			// Points a jump emitted earlier (at the returned position of its disp32) to target
+			void RewriteJumpTo(JitWriter *jit, jitoffs_t where, jitoffs_t target)
+			{
+				jit->rewrite(where, static_cast<jit_int32_t>(target - (where + 4)));
+			}
+
+			template <class T>
+			jit_int64_t PtrToImm(T ptr)
+			{
+				return reinterpret_cast<jit_int64_t>(ptr);
+			}
+
+			// We know the ISourceHook pointer at jit time -> dereference the vtable here
+			jit_int64_t SHVfunc(ISourceHook *shptr, int idx)
+			{
+				return PtrToImm((*reinterpret_cast<void***>(shptr))[idx]);
+			}
+		}
+
+		void GenContext::ComputeArgLocs()
+		{
+			m_ParamLocs.clear();
+
+			// [memret ptr,] this
+			m_NumGPArgs = (m_Proto.GetRet().flags & PassInfo::PassFlag_RetMem) ? 2 : 1;
+			m_NumSSEArgs = 0;
+			m_StackArgsSize = 0;
+
+			for (int i = 0; i < m_Proto.GetNumOfParams(); ++i)
+			{
+				const IntPassInfo &pi = m_Proto.GetParam(i);
+				ArgLoc loc;
+
+				if (pi.type == PassInfo::PassType_Float && (pi.flags & PassInfo::PassFlag_ByVal))
+				{
+					if (m_NumSSEArgs < NumSSEArgRegs)
+					{
+						loc.kind = ArgLoc::Kind_SSE;
+						loc.index = m_NumSSEArgs++;
+						loc.count = 1;
+					}
+					else
+					{
+						loc.kind = ArgLoc::Kind_Stack;
+						loc.index = m_StackArgsSize;
+						loc.count = 8;
+						m_StackArgsSize += 8;
+					}
+				}
+				else if (pi.type == PassInfo::PassType_Object && (pi.flags & PassInfo::PassFlag_ByVal) &&
+					!(pi.flags & PassFlag_ForcedByRef) && pi.size > 16)
+				{
+					// MEMORY class: copied onto the stack
+					loc.kind = ArgLoc::Kind_Stack;
+					loc.index = m_StackArgsSize;
+					loc.count = AlignSize(static_cast<jit_int32_t>(pi.size), 8);
+					m_StackArgsSize += loc.count;
+				}
+				else
+				{
+					// INTEGER class: one eightbyte, or up to two for small objects
+					// (PassInfoSupported makes sure that these are PassFlag_IntClass)
+					int eightbytes = AlignSize(GetRealSize(pi), 8) / 8;
+					if (m_NumGPArgs + eightbytes <= NumGPArgRegs)
+					{
+						loc.kind = ArgLoc::Kind_GP;
+						loc.index = m_NumGPArgs;
+						loc.count = eightbytes;
+						m_NumGPArgs += eightbytes;
+					}
+					else
+					{
+						// Doesn't fit -> the whole argument goes onto the stack
+						loc.kind = ArgLoc::Kind_Stack;
+						loc.index = m_StackArgsSize;
+						loc.count = eightbytes * 8;
+						m_StackArgsSize += loc.count;
+					}
+				}
+
+				m_ParamLocs.push_back(loc);
+			}
+		}
+
+		GenContext::ArgLoc GenContext::NextPtrArg(int &num_gp, jit_int32_t &stack_size)
+		{
+			ArgLoc loc;
+			if (num_gp < NumGPArgRegs)
+			{
+				loc.kind = ArgLoc::Kind_GP;
+				loc.index = num_gp++;
+				loc.count = 1;
+			}
+			else
+			{
+				loc.kind = ArgLoc::Kind_Stack;
+				loc.index = stack_size;
+				loc.count = 8;
+				stack_size += 8;
+			}
+			return loc;
+		}
+
+		jit_int32_t GenContext::ArgAddr(const ArgLoc &loc, int eightbyte)
+		{
+			switch (loc.kind)
+			{
+			case ArgLoc::Kind_GP:
+				return m_RegSaveArea + (loc.index + eightbyte) * 8;
+			case ArgLoc::Kind_SSE:
+				return m_RegSaveArea + NumGPArgRegs * 8 + loc.index * 16;
+			case ArgLoc::Kind_Stack:
+			default:
+				return IncomingArgsOffs + loc.index + eightbyte * 8;
+			}
+		}
+
+		void GenContext::LoadThisPtr(jit_uint8_t reg)
+		{
+			ArgLoc loc;
+			loc.kind = ArgLoc::Kind_GP;
+			loc.index = (m_Proto.GetRet().flags & PassInfo::PassFlag_RetMem) ? 1 : 0;
+			loc.count = 1;
+
+			// mov reg, [rbp + this]
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, reg, REG_RBP, ArgAddr(loc));
+		}
+
+		void GenContext::CallAbs(const void *func)
+		{
+			// mov rax, func
+			// call rax
+			X64_Mov_Reg_Imm64(&m_HookFunc, REG_RAX, PtrToImm(func));
+			X64_Call_Reg(&m_HookFunc, REG_RAX);
+		}
+
+		void GenContext::BitwiseCopy(size_t size)
+		{
+			jit_int32_t qwords = static_cast<jit_int32_t>(size / 8);
+			jit_int32_t bytes = static_cast<jit_int32_t>(size % 8);
+
+			//if qwords
+			// mov ecx, <qwords>
+			// rep movsq
+			//if bytes
+			// mov ecx, <bytes>
+			// rep movsb
+
+			if (qwords)
+			{
+				X64_Mov_Reg32_Imm32(&m_HookFunc, REG_RCX, qwords);
+				X64_Rep_Movsq(&m_HookFunc);
+			}
+			if (bytes)
+			{
+				X64_Mov_Reg32_Imm32(&m_HookFunc, REG_RCX, bytes);
+				X64_Rep_Movsb(&m_HookFunc);
+			}
+		}
+
+		jit_int32_t GenContext::GetForcedByRefParamOffset(int p)
+		{
+			jit_int32_t off = 0;
+			for (int i = 0; i < p; ++i)
+			{
+				if (m_Proto.GetParam(i).flags & PassFlag_ForcedByRef)
+					off += AlignSize(static_cast<jit_int32_t>(m_Proto.GetParam(i).size), 16);
+			}
+			return off;
+		}
+
+		jit_int32_t GenContext::GetForcedByRefParamsSize()
+		{
+			return GetForcedByRefParamOffset(m_Proto.GetNumOfParams());
+		}
+
+		void GenContext::PassParams(jit_int32_t v_place_fbrr_base)
+		{
+			// 1) Forced byref params: every callee gets its own copy
+			for (int i = 0; i < m_Proto.GetNumOfParams(); ++i)
+			{
+				const IntPassInfo &pi = m_Proto.GetParam(i);
+				if (!(pi.flags & PassFlag_ForcedByRef))
+					continue;
+
+				// lea rdi, [rbp + place_fbrr]		<-- dest
+				// mov rsi, [rbp + param]			<-- src: the caller passed us the address of its copy
+				X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RDI, REG_RBP, v_place_fbrr_base + GetForcedByRefParamOffset(i));
+				X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RSI, REG_RBP, ArgAddr(m_ParamLocs[i]));
+
+				if (pi.pCopyCtor)
+					CallAbs(pi.pCopyCtor);
+				else
+					BitwiseCopy(pi.size);
+			}
+
+			// 2) Stack params
+			for (int i = 0; i < m_Proto.GetNumOfParams(); ++i)
+			{
+				const IntPassInfo &pi = m_Proto.GetParam(i);
+				const ArgLoc &loc = m_ParamLocs[i];
+				if (loc.kind != ArgLoc::Kind_Stack)
+					continue;
+
+				if (pi.flags & PassFlag_ForcedByRef)
+				{
+					// lea rax, [rbp + place_fbrr]
+					// mov [rsp + offs], rax
+					X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RBP, v_place_fbrr_base + GetForcedByRefParamOffset(i));
+					X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RSP, REG_RAX, loc.index);
+					continue;
+				}
+
+				// copy the stack slot(s)
+				//  mov rax, [rbp + param + x]
+				//  mov [rsp + offs + x], rax
+				for (jit_int32_t x = 0; x < loc.count; x += 8)
+				{
+					X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RBP, ArgAddr(loc) + x);
+					X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RSP, REG_RAX, loc.index + x);
+				}
+			}
+
+			// 3) Register params
+			for (int i = 0; i < m_Proto.GetNumOfParams(); ++i)
+			{
+				const IntPassInfo &pi = m_Proto.GetParam(i);
+				const ArgLoc &loc = m_ParamLocs[i];
+
+				if (loc.kind == ArgLoc::Kind_GP)
+				{
+					if (pi.flags & PassFlag_ForcedByRef)
+					{
+						X64_Lea_Reg_Rm_Disp(&m_HookFunc, GPArgRegs[loc.index], REG_RBP,
+							v_place_fbrr_base + GetForcedByRefParamOffset(i));
+					}
+					else
+					{
+						for (int x = 0; x < loc.count; ++x)
+							X64_Mov_Reg_Rm_Disp(&m_HookFunc, GPArgRegs[loc.index + x], REG_RBP, ArgAddr(loc, x));
+					}
+				}
+				else if (loc.kind == ArgLoc::Kind_SSE)
+				{
+					X64_Movaps_Xmm_Rm_Disp(&m_HookFunc, static_cast<jit_uint8_t>(loc.index), REG_RBP, ArgAddr(loc));
+				}
+			}
+		}
+
+		void GenContext::PassPtrArg(const ArgLoc &loc, jit_uint8_t src_reg)
+		{
+			if (loc.kind == ArgLoc::Kind_GP)
+				X64_Mov_Reg_Reg(&m_HookFunc, GPArgRegs[loc.index], src_reg);
+			else
+				X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RSP, src_reg, loc.index);
+		}
+
+		void GenContext::DestroyParams(jit_int32_t v_place_fbrr_base)
+		{
+			for (int i = m_Proto.GetNumOfParams() - 1; i >= 0; --i)
+			{
+				const IntPassInfo &pi = m_Proto.GetParam(i);
+				if (pi.type == PassInfo::PassType_Object && (pi.flags & PassInfo::PassFlag_ODtor) &&
+					(pi.flags & PassInfo::PassFlag_ByVal) && (pi.flags & PassFlag_ForcedByRef))
+				{
+					X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RDI, REG_RBP, v_place_fbrr_base + GetForcedByRefParamOffset(i));
+					CallAbs(pi.pDtor);
+				}
+			}
+		}
+
+		void GenContext::SaveRetVal(jit_int32_t v_where, jit_int32_t v_place_for_memret)
+		{
+			const IntPassInfo &ret = m_Proto.GetRet();
+			size_t size = GetRealSize(ret);
+			if (size == 0)
+			{
+				// No return value -> nothing
+				return;
+			}
+
+			if (ret.flags & PassInfo::PassFlag_ByRef)
+			{
+				// mov [rbp + v_where], rax
+				X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RBP, REG_RAX, v_where);
+				return;
+			}
+			// else: ByVal
+
+			// Memory return:
+			if (ret.flags & PassInfo::PassFlag_RetMem)
+			{
+				if (MemRetWithTempObj())
+				{
+					// *v_where = *v_place_for_memret
+					//  lea rdi, [rbp + v_where]
+					//  lea rsi, [rbp + v_place_for_memret]
+					X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RDI, REG_RBP, v_where);
+					X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RSI, REG_RBP, v_place_for_memret);
+					if (ret.pAssignOperator)
+						CallAbs(ret.pAssignOperator);
+					else
+						BitwiseCopy(ret.size);
+
+					// Then: destruct *v_place_for_memret if required
+					if (ret.pDtor)
+						CallRetCtorDtor(ret.pDtor, v_place_for_memret);
+				}
+
+				// else: already constructed at the correct address -> we're done
+				return;
+			}
+
+			if (ret.type == PassInfo::PassType_Float)
+			{
+				if (size == 4)
+					X64_Movss_Rm_Xmm_Disp(&m_HookFunc, REG_RBP, 0, v_where);
+				else if (size == 8)
+					X64_Movsd_Rm_Xmm_Disp(&m_HookFunc, REG_RBP, 0, v_where);
+			}
+			else if (ret.type == PassInfo::PassType_Basic)
+			{
+				switch (size)
+				{
+				case 1:
+					X64_Mov_Rm_Reg8_Disp(&m_HookFunc, REG_RBP, REG_RAX, v_where);
+					break;
+				case 2:
+					X64_Mov_Rm_Reg16_Disp(&m_HookFunc, REG_RBP, REG_RAX, v_where);
+					break;
+				case 4:
+					X64_Mov_Rm_Reg32_Disp(&m_HookFunc, REG_RBP, REG_RAX, v_where);
+					break;
+				case 8:
+					X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RBP, REG_RAX, v_where);
+					break;
+				}
+			}
+			else if (ret.type == PassInfo::PassType_Object)
+			{
+				// RetReg: rax(:rdx). The return variables are padded to 16 bytes,
+				// so we can always store whole eightbytes.
+				X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RBP, REG_RAX, v_where);
+				if (size > 8)
+					X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RBP, REG_RDX, v_where + 8);
+			}
+		}
+
+		void GenContext::ProcessPluginRetVal(jit_int32_t v_cur_res, jit_int32_t v_pContext, jit_int32_t v_plugin_ret)
+		{
+			// only for non-void functions!
+			if (m_Proto.GetRet().size == 0)
+				return;
+
+			// if (cur_res >= MRES_OVERRIDE)
+			//   *reinterpret_cast<my_rettype*>(pContext->GetOverrideRetPtr()) = plugin_ret;
+
+			jitoffs_t tmppos, counter;
+
+			//  cmp DWORD PTR [rbp + v_cur_res], MRES_OVERRIDE
+			//  jl thelabel
+			X64_Cmp_Rm32_Imm_Disp(&m_HookFunc, REG_RBP, MRES_OVERRIDE, v_cur_res);
+			tmppos = X64_Jump_Cond_Imm32(&m_HookFunc, CC_L, 0);
+			m_HookFunc.start_count(counter);
+
+			// rax = pContext->GetOverrideRetPtr()
+			//  mov rdi, [rbp + v_pContext]
+			//  mov rax, [rdi]
+			//  call [rax + 1*SIZE_PTR]
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RDI, REG_RBP, v_pContext);
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RDI, 0);
+			X64_Call_Rm_Disp(&m_HookFunc, REG_RAX, IHookContext_GetOverrideRetPtr * SIZE_PTR);
+
+			// *rax = plugin_ret
+			if (m_Proto.GetRet().flags & PassInfo::PassFlag_ByRef)
+			{
+				// mov rcx, [rbp + v_plugin_ret]
+				// mov [rax], rcx
+				X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RCX, REG_RBP, v_plugin_ret);
+				X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RAX, REG_RCX, 0);
+			}
+			else
+			{
+				// mov rdi, rax						<-- dest
+				// lea rsi, [rbp + v_plugin_ret]	<-- src
+				X64_Mov_Reg_Reg(&m_HookFunc, REG_RDI, REG_RAX);
+				X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RSI, REG_RBP, v_plugin_ret);
+
+				if (m_Proto.GetRet().pAssignOperator)
+					CallAbs(m_Proto.GetRet().pAssignOperator);
+				else
+					BitwiseCopy(m_Proto.GetRet().size);
+			}
+
+			m_HookFunc.end_count(counter);
+			m_HookFunc.rewrite(tmppos, static_cast<jit_int32_t>(counter));
+		}
+
+		void GenContext::PrepareReturn(jit_int32_t v_status, jit_int32_t v_pContext, jit_int32_t v_retptr)
+		{
+			// only for non-void functions!
+			if (m_Proto.GetRet().size == 0)
+				return;
+
+			// retptr = status >= MRES_OVERRIDE ? pContext->GetOverrideRetPtr() : pContext->GetOrigRetPtr()
+
+			jitoffs_t counter, tmppos;
+			jitoffs_t counter2, tmppos2;
+
+			//  mov rdi, [rbp + v_pContext]
+			//  mov rax, [rdi]
+			//  cmp DWORD PTR [rbp + v_status], MRES_OVERRIDE
+			//  jl orig
+			//  call [rax + 1*SIZE_PTR]
+			//  jmp done
+			// orig:
+			//  call [rax + 2*SIZE_PTR]
+			// done:
+			//  mov [rbp + v_retptr], rax
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RDI, REG_RBP, v_pContext);
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RDI, 0);
+			X64_Cmp_Rm32_Imm_Disp(&m_HookFunc, REG_RBP, MRES_OVERRIDE, v_status);
+			tmppos = X64_Jump_Cond_Imm8(&m_HookFunc, CC_L, 0);
+			m_HookFunc.start_count(counter);
+
+			X64_Call_Rm_Disp(&m_HookFunc, REG_RAX, IHookContext_GetOverrideRetPtr * SIZE_PTR);
+			tmppos2 = X64_Jump_Imm8(&m_HookFunc, 0);
+			m_HookFunc.start_count(counter2);
+
+			m_HookFunc.end_count(counter);
+			m_HookFunc.rewrite(tmppos, static_cast<jit_uint8_t>(counter));
+
+			X64_Call_Rm_Disp(&m_HookFunc, REG_RAX, IHookContext_GetOrigRetPtr * SIZE_PTR);
+
+			m_HookFunc.end_count(counter2);
+			m_HookFunc.rewrite(tmppos2, static_cast<jit_uint8_t>(counter2));
+
+			X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RBP, REG_RAX, v_retptr);
+		}
+
+		void GenContext::DoReturn(jit_int32_t v_retptr)
+		{
+			const IntPassInfo &ret = m_Proto.GetRet();
+			size_t size = ret.size;
+			if (!size)
+				return;
+
+			// Get real ret pointer into rcx
+			// mov rcx, [rbp + v_ret_ptr]
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RCX, REG_RBP, v_retptr);
+
+			if (ret.flags & PassInfo::PassFlag_ByRef)
+			{
+				// mov rax, [rcx]
+				X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RCX, 0);
+				return;
+			}
+			// else: byval
+
+			if (ret.type == PassInfo::PassType_Float)
+			{
+				if (size == 4)
+					X64_Movss_Xmm_Rm_Disp(&m_HookFunc, 0, REG_RCX, 0);
+				else if (size == 8)
+					X64_Movsd_Xmm_Rm_Disp(&m_HookFunc, 0, REG_RCX, 0);
+			}
+			else if (ret.type == PassInfo::PassType_Basic)
+			{
+				switch (size)
+				{
+				case 1:
+					X64_Movzx_Reg32_Rm8_Disp(&m_HookFunc, REG_RAX, REG_RCX, 0);
+					break;
+				case 2:
+					X64_Movzx_Reg32_Rm16_Disp(&m_HookFunc, REG_RAX, REG_RCX, 0);
+					break;
+				case 4:
+					X64_Mov_Reg32_Rm_Disp(&m_HookFunc, REG_RAX, REG_RCX, 0);
+					break;
+				case 8:
+					X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RCX, 0);
+					break;
+				}
+			}
+			else if (ret.flags & PassInfo::PassFlag_RetReg)
+			{
+				// object in rax(:rdx); the return variables are padded to 16 bytes
+				X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RCX, 0);
+				if (size > 8)
+					X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RDX, REG_RCX, 8);
+			}
+			else if (ret.flags & PassInfo::PassFlag_RetMem)
+			{
+				// *memret_outaddr = *retptr
+				//  mov rdi, [rbp + memret_outaddr]	<-- dest
+				//  mov rsi, rcx					<-- src
+				ArgLoc memret;
+				memret.kind = ArgLoc::Kind_GP;
+				memret.index = 0;
+				memret.count = 1;
+
+				X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RDI, REG_RBP, ArgAddr(memret));
+				X64_Mov_Reg_Reg(&m_HookFunc, REG_RSI, REG_RCX);
+
+				if (ret.pCopyCtor)
+					CallAbs(ret.pCopyCtor);
+				else
+					BitwiseCopy(size);
+
+				// In both cases: return the address in rax
+				X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RBP, ArgAddr(memret));
+			}
+		}
+
+		void GenContext::CallRetCtorDtor(const void *func, jit_int32_t v_obj)
+		{
+			// lea rdi, [rbp + v_obj]
+			// call func
+			X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RDI, REG_RBP, v_obj);
+			CallAbs(func);
+		}
+
+		void GenContext::GenerateBypass(jit_int32_t v_saved_rax, jit_int32_t v_vfnptr_origentry)
+		{
+			// Right after SetupHookLoopParams:
+			// if (!pContext)
+			//   restore the argument registers, tear down the frame and jump to vfnptr_origentry
+			// The original function then returns to our caller directly.
+
+			jitoffs_t counter, tmppos;
+
+			//  test rax, rax
+			//  jnz normal
+			X64_Test_Reg_Reg(&m_HookFunc, REG_RAX, REG_RAX);
+			tmppos = X64_Jump_Cond_Imm32(&m_HookFunc, CC_NZ, 0);
+			m_HookFunc.start_count(counter);
+
+			//  mov r11, [rbp + vfnptr_origentry]
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_R11, REG_RBP, v_vfnptr_origentry);
+			RestoreArgRegs(v_saved_rax);
+			X64_Leave(&m_HookFunc);
+			X64_Jump_Reg(&m_HookFunc, REG_R11);
+
+			// normal:
+			m_HookFunc.end_count(counter);
+			m_HookFunc.rewrite(tmppos, static_cast<jit_int32_t>(counter));
+		}
+
+		void GenContext::GenerateVfnPtrArgs()
+		{
+			// rsi = *m_pHI
+			// rcx = this
+			// rdx = our vfn ptr = *(this + vtbloffs) + SIZE_PTR*vtblidx
+			if (m_IsSharedBody)
+			{
+				// Same thing, but from the site of the stub we were entered through
+				//  mov rax, [rbp + site]
+				//  mov rsi, [rax + hi]
+				//  mov rdx, rcx
+				//  add rdx, [rax + vtblOffs]
+				//  mov rdx, [rdx]
+				//  add rdx, [rax + vtblIdxOffs]
+				X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RBP, m_SiteVar);
+				X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RSI, REG_RAX, offsetof(HookSite, hi));
+				LoadThisPtr(REG_RCX);
+				X64_Mov_Reg_Reg(&m_HookFunc, REG_RDX, REG_RCX);
+				X64_Add_Reg_Rm_Disp(&m_HookFunc, REG_RDX, REG_RAX, offsetof(HookSite, vtblOffs));
+				X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RDX, REG_RDX, 0);
+				X64_Add_Reg_Rm_Disp(&m_HookFunc, REG_RDX, REG_RAX, offsetof(HookSite, vtblIdxOffs));
+				return;
+			}
+
+			X64_Mov_Reg_Imm64(&m_HookFunc, REG_RAX, PtrToImm(m_pHI));
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RSI, REG_RAX, 0);
+			LoadThisPtr(REG_RCX);
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RCX, m_VtblOffs);
+			X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RDX, REG_RAX, m_VtblIdx * SIZE_PTR);
+		}
+
+		void *GenContext::GenerateHookFuncStub()
+		{
+			// The shared body takes its site in r11 (not an argument register)
+			// rax has to stay intact: al is the number of SSE registers used by varargs callers
+			// The site says which body: the shared one or one specialized for our hooks.
+			//  mov r11, site
+			//  jmp [r11 + body]
+			m_pSite->body.store(m_pSharedBody->GetSharedBody());
+			X64_Mov_Reg_Imm64(&m_HookFunc, REG_R11, PtrToImm(m_pSite));
+			X64_Jump_Rm_Disp(&m_HookFunc, REG_R11, offsetof(HookSite, body));
+
+			*m_HookfuncVfnptr = reinterpret_cast<void*>(m_HookFunc.GetData());
+
+			m_HookFunc.SetRE();
+
+			return m_HookFunc.GetData();
+		}
+
+		int GenContext::GetNumSavedGP()
+		{
+			// varargs functions may get anything in any register
+			return (m_Proto.GetConvention() & ProtoInfo::CallConv_HasVarArgs) ? NumGPArgRegs : m_NumGPArgs;
+		}
+
+		int GenContext::GetNumSavedSSE()
+		{
+			return (m_Proto.GetConvention() & ProtoInfo::CallConv_HasVarArgs) ? NumSSEArgRegs : m_NumSSEArgs;
+		}
+
+		void GenContext::SaveArgRegs(jit_int32_t v_saved_rax)
+		{
+			for (int i = 0; i < GetNumSavedGP(); ++i)
+				X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RBP, GPArgRegs[i], m_RegSaveArea + i * 8);
+			for (int i = 0; i < GetNumSavedSSE(); ++i)
+				X64_Movaps_Rm_Xmm_Disp(&m_HookFunc, REG_RBP, static_cast<jit_uint8_t>(i), m_RegSaveArea + NumGPArgRegs * 8 + i * 16);
+
+			// varargs: al is an upper bound of the number of SSE registers used
+			if (m_Proto.GetConvention() & ProtoInfo::CallConv_HasVarArgs)
+				X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RBP, REG_RAX, v_saved_rax);
+		}
+
+		void GenContext::RestoreArgRegs(jit_int32_t v_saved_rax)
+		{
+			for (int i = 0; i < GetNumSavedGP(); ++i)
+				X64_Mov_Reg_Rm_Disp(&m_HookFunc, GPArgRegs[i], REG_RBP, m_RegSaveArea + i * 8);
+			for (int i = 0; i < GetNumSavedSSE(); ++i)
+				X64_Movaps_Xmm_Rm_Disp(&m_HookFunc, static_cast<jit_uint8_t>(i), REG_RBP, m_RegSaveArea + NumGPArgRegs * 8 + i * 16);
+
+			if (m_Proto.GetConvention() & ProtoInfo::CallConv_HasVarArgs)
+				X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RBP, v_saved_rax);
+		}
+
+		void GenContext::GenerateVafmt(jit_int32_t v_va_list, jit_int32_t v_va_buf)
+		{
+			// The format string is the last named argument
+			int num_gp = m_NumGPArgs;
+			jit_int32_t stack_size = m_StackArgsSize;
+			ArgLoc fmt = NextPtrArg(num_gp, stack_size);
+
+			// Set up a va_list which continues after the named arguments:
+			//  struct { unsigned int gp_offset, fp_offset; void *overflow_arg_area, *reg_save_area; }
+			X64_Mov_Rm32_Imm32_Disp(&m_HookFunc, REG_RBP, num_gp * 8, v_va_list);
+			X64_Mov_Rm32_Imm32_Disp(&m_HookFunc, REG_RBP, NumGPArgRegs * 8 + m_NumSSEArgs * 16, v_va_list + 4);
+			X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RBP, IncomingArgsOffs + stack_size);
+			X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RBP, REG_RAX, v_va_list + 8);
+			X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RBP, m_RegSaveArea);
+			X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RBP, REG_RAX, v_va_list + 16);
+
+			// vsnprintf(va_buf, STRBUF_LEN - 1, fmt, va_list)
+			X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RDI, REG_RBP, v_va_buf);
+			X64_Mov_Reg32_Imm32(&m_HookFunc, REG_RSI, SourceHook::STRBUF_LEN - 1);
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RDX, REG_RBP, ArgAddr(fmt));
+			X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RCX, REG_RBP, v_va_list);
+			CallAbs(reinterpret_cast<const void*>(&vsnprintf));
+
+			// Set trailing zero
+			X64_Mov_Rm8_Imm8_Disp(&m_HookFunc, REG_RBP, 0, v_va_buf + SourceHook::STRBUF_LEN - 1);
+		}
+
+		void GenContext::GenerateCallHook(jit_int32_t v_status, jit_int32_t v_prev_res, jit_int32_t v_cur_res,
+			jit_int32_t v_iter, jit_int32_t v_pContext, jit_int32_t v_plugin_ret, jit_int32_t v_place_for_memret,
+			jit_int32_t v_place_fbrr_base, jit_int32_t v_va_buf)
+		{
+			jitoffs_t counter2, tmppos2;
+
+			// iter = rax; cur_res = MRES_IGNORED
+			X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RBP, REG_RAX, v_iter);
+			X64_Mov_Rm32_Imm32_Disp(&m_HookFunc, REG_RBP, MRES_IGNORED, v_cur_res);
+
+			// iter->Call(params [, va_buf])
+			PassParams(v_place_fbrr_base);
+
+			if ((m_Proto.GetConvention() & ProtoInfo::CallConv_HasVafmt) == ProtoInfo::CallConv_HasVafmt)
+			{
+				int num_gp = m_NumGPArgs;
+				jit_int32_t stack_size = m_StackArgsSize;
+				X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RBP, v_va_buf);
+				PassPtrArg(NextPtrArg(num_gp, stack_size), REG_RAX);
+			}
+
+			// [rdi = memret ptr,] this = iter
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RBP, v_iter);
+			if (m_Proto.GetRet().flags & PassInfo::PassFlag_RetMem)
+			{
+				X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RDI, REG_RBP, MemRetWithTempObj() ? v_place_for_memret : v_plugin_ret);
+				X64_Mov_Reg_Reg(&m_HookFunc, REG_RSI, REG_RAX);
+			}
+			else
+			{
+				X64_Mov_Reg_Reg(&m_HookFunc, REG_RDI, REG_RAX);
+			}
+
+			//  mov r11, [rax]
+			//  call [r11 + 2*SIZE_PTR]
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_R11, REG_RAX, 0);
+			X64_Call_Rm_Disp(&m_HookFunc, REG_R11, ISHDelegate_Call * SIZE_PTR);
+
+			SaveRetVal(v_plugin_ret, v_place_for_memret);
+
+			DestroyParams(v_place_fbrr_base);
+
+			// process meta return:
+			//  prev_res = cur_res
+			//  if (cur_res > status) status = cur_res;
+			//
+			//  mov eax, [rbp + v_cur_res]
+			//  mov edx, [rbp + v_status]
+			//  mov [rbp + v_prev_res], eax
+			//  cmp eax, edx
+			//  jng thelabel
+			//  mov [rbp + v_status], eax
+			//  thelabel:
+			X64_Mov_Reg32_Rm_Disp(&m_HookFunc, REG_RAX, REG_RBP, v_cur_res);
+			X64_Mov_Reg32_Rm_Disp(&m_HookFunc, REG_RDX, REG_RBP, v_status);
+			X64_Mov_Rm_Reg32_Disp(&m_HookFunc, REG_RBP, REG_RAX, v_prev_res);
+
+			X64_Cmp_Reg32_Reg32(&m_HookFunc, REG_RAX, REG_RDX);
+			tmppos2 = X64_Jump_Cond_Imm8(&m_HookFunc, CC_NG, 0);
+			m_HookFunc.start_count(counter2);
+
+			X64_Mov_Rm_Reg32_Disp(&m_HookFunc, REG_RBP, REG_RAX, v_status);
+
+			m_HookFunc.end_count(counter2);
+			m_HookFunc.rewrite(tmppos2, static_cast<jit_uint8_t>(counter2));
+
+			// process retval for non-void functions
+			ProcessPluginRetVal(v_cur_res, v_pContext, v_plugin_ret);
+		}
+
+		void GenContext::GeneratePlanSteps(jit_int32_t v_status, jit_int32_t v_prev_res, jit_int32_t v_cur_res,
+			jit_int32_t v_iter, jit_int32_t v_pContext, jit_int32_t v_plugin_ret, jit_int32_t v_place_for_memret,
+			jit_int32_t v_place_fbrr_base, jit_int32_t v_va_buf, bool post,
+			CVector<jitoffs_t> &toLoop, CVector<jitoffs_t> &toExit)
+		{
+			// The pre hooks end with the step without a handler
+			int endStep = 0;
+			while (m_pPlan->steps[endStep].handler != NULL)
+				++endStep;
+			int first = post ? endStep + 1 : 0;
+			int last = post ? m_pPlan->numSteps : endStep;
+
+			// Still on the plan? (-1 if BeginHookPlan has refused it or SourceHook has taken it back)
+			//  cmp dword [rbp + pos], first
+			//  jne loop_begin
+			X64_Cmp_Rm32_Imm_Disp(&m_HookFunc, REG_RBP, first, m_PlanPosVar);
+			toLoop.push_back(X64_Jump_Cond_Imm32(&m_HookFunc, CC_NE, 0));
+
+			for (int i = first; i < last; ++i)
+			{
+				//  mov dword [rbp + pos], i + 1
+				//  mov rax, handler
+				//  <call it>
+				//  cmp dword [rbp + pos], i + 1
+				//  jne loop_begin
+				X64_Mov_Rm32_Imm32_Disp(&m_HookFunc, REG_RBP, i + 1, m_PlanPosVar);
+				X64_Mov_Reg_Imm64(&m_HookFunc, REG_RAX, PtrToImm(m_pPlan->steps[i].handler));
+				GenerateCallHook(v_status, v_prev_res, v_cur_res, v_iter, v_pContext, v_plugin_ret,
+					v_place_for_memret, v_place_fbrr_base, v_va_buf);
+				X64_Cmp_Rm32_Imm_Disp(&m_HookFunc, REG_RBP, i + 1, m_PlanPosVar);
+				toLoop.push_back(X64_Jump_Cond_Imm32(&m_HookFunc, CC_NE, 0));
+			}
+
+			// On to the orig call
+			if (!post)
+				X64_Mov_Rm32_Imm32_Disp(&m_HookFunc, REG_RBP, endStep + 1, m_PlanPosVar);
+
+			toExit.push_back(X64_Jump_Imm32(&m_HookFunc, 0));
+		}
+
+		void GenContext::GenerateCallHooks(jit_int32_t v_status, jit_int32_t v_prev_res, jit_int32_t v_cur_res,
+			jit_int32_t v_iter, jit_int32_t v_pContext, jit_int32_t v_plugin_ret, jit_int32_t v_place_for_memret,
+			jit_int32_t v_place_fbrr_base, jit_int32_t v_va_buf, bool post)
+		{
+			jitoffs_t tmppos;
+			jitoffs_t loop_begin;
+			CVector<jitoffs_t> toLoop;
+			CVector<jitoffs_t> toExit;
+
+			// prev_res = MRES_IGNORED
+			X64_Mov_Rm32_Imm32_Disp(&m_HookFunc, REG_RBP, MRES_IGNORED, v_prev_res);
+
+			// Specialized body: call the plan's handlers; the loop takes over if it doesn't work out
+			if (m_pPlan)
+			{
+				GeneratePlanSteps(v_status, v_prev_res, v_cur_res, v_iter, v_pContext, v_plugin_ret,
+					v_place_for_memret, v_place_fbrr_base, v_va_buf, post, toLoop, toExit);
+			}
+
+			loop_begin = m_HookFunc.get_outputpos();
+
+			// rax = pContext->GetNext()
+			//  mov rdi, [rbp + v_pContext]
+			//  mov rax, [rdi]
+			//  call [rax]
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RDI, REG_RBP, v_pContext);
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RDI, 0);
+			X64_Call_Rm_Disp(&m_HookFunc, REG_RAX, IHookContext_GetNext * SIZE_PTR);
+
+			// quit on zero
+			//  test rax, rax
+			//  jz exit
+			X64_Test_Reg_Reg(&m_HookFunc, REG_RAX, REG_RAX);
+			toExit.push_back(X64_Jump_Cond_Imm32(&m_HookFunc, CC_Z, 0));
+
+			GenerateCallHook(v_status, v_prev_res, v_cur_res, v_iter, v_pContext, v_plugin_ret,
+				v_place_for_memret, v_place_fbrr_base, v_va_buf);
+
+			// jump back to loop begin
+			tmppos = X64_Jump_Imm32(&m_HookFunc, 0);
+			RewriteJumpTo(&m_HookFunc, tmppos, loop_begin);
+
+			// exit:
+			for (size_t i = 0; i < toLoop.size(); ++i)
+				RewriteJumpTo(&m_HookFunc, toLoop[i], loop_begin);
+			for (size_t i = 0; i < toExit.size(); ++i)
+				RewriteJumpTo(&m_HookFunc, toExit[i], m_HookFunc.get_outputpos());
+		}
+
+		void GenContext::GenerateCallOrig(jit_int32_t v_status, jit_int32_t v_pContext, jit_int32_t v_vfnptr_origentry,
+			jit_int32_t v_orig_ret, jit_int32_t v_override_ret, jit_int32_t v_place_for_memret,
+			jit_int32_t v_place_fbrr_base, jit_int32_t v_va_buf)
+		{
+			jitoffs_t counter, tmppos;
+			jitoffs_t counter2, tmppos2;
+			jitoffs_t counter3, tmppos3;
+
+			// if (status != MRES_SUPERCEDE && pContext->ShouldCallOrig())
+			//   *v_orig_ret = orig_call()
+			// else
+			//   *v_orig_ret = *v_override_ret
+
+			X64_Cmp_Rm32_Imm_Disp(&m_HookFunc, REG_RBP, MRES_SUPERCEDE, v_status);
+			tmppos = X64_Jump_Cond_Imm32(&m_HookFunc, CC_E, 0);
+			m_HookFunc.start_count(counter);
+
+			// al = pContext->ShouldCallOrig()
+			//  mov rdi, [rbp + v_pContext]
+			//  mov rax, [rdi]
+			//  call [rax + 3*SIZE_PTR]
+			//  test al, al				!! important: al, not eax! bool is only stored in the LSbyte
+			//  jz dont_call
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RDI, REG_RBP, v_pContext);
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RDI, 0);
+			X64_Call_Rm_Disp(&m_HookFunc, REG_RAX, IHookContext_ShouldCallOrig * SIZE_PTR);
+			X64_Test_Reg8_Reg8(&m_HookFunc, REG_RAX, REG_RAX);
+			tmppos2 = X64_Jump_Cond_Imm32(&m_HookFunc, CC_Z, 0);
+			m_HookFunc.start_count(counter2);
+
+			// orig_call(params [, "%s", va_buf])
+			PassParams(v_place_fbrr_base);
+
+			if ((m_Proto.GetConvention() & ProtoInfo::CallConv_HasVafmt) == ProtoInfo::CallConv_HasVafmt)
+			{
+				int num_gp = m_NumGPArgs;
+				jit_int32_t stack_size = m_StackArgsSize;
+				X64_Mov_Reg_Imm64(&m_HookFunc, REG_RAX, PtrToImm("%s"));
+				PassPtrArg(NextPtrArg(num_gp, stack_size), REG_RAX);
+				X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RBP, v_va_buf);
+				PassPtrArg(NextPtrArg(num_gp, stack_size), REG_RAX);
+			}
+
+			// [rdi = memret ptr,] this
+			if (m_Proto.GetRet().flags & PassInfo::PassFlag_RetMem)
+			{
+				X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RDI, REG_RBP, MemRetWithTempObj() ? v_place_for_memret : v_orig_ret);
+				LoadThisPtr(REG_RSI);
+			}
+			else
+			{
+				LoadThisPtr(REG_RDI);
+			}
+
+			// call
+			//  mov r11, [rbp + v_vfnptr_origentry]
+			//  varargs: mov al, <number of SSE registers used>
+			//  call r11
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_R11, REG_RBP, v_vfnptr_origentry);
+			if (m_Proto.GetConvention() & ProtoInfo::CallConv_HasVarArgs)
+				X64_Mov_Reg8_Imm8(&m_HookFunc, REG_RAX, static_cast<jit_int8_t>(m_NumSSEArgs));
+			X64_Call_Reg(&m_HookFunc, REG_R11);
+
+			// save retval
+			SaveRetVal(v_orig_ret, v_place_for_memret);
+
+			DestroyParams(v_place_fbrr_base);
+
+			// Skip don't call variant
+			tmppos3 = X64_Jump_Imm32(&m_HookFunc, 0);
+			m_HookFunc.start_count(counter3);
+
+			// don't call:
+			m_HookFunc.end_count(counter);
+			m_HookFunc.rewrite(tmppos, static_cast<jit_int32_t>(counter));
+
+			m_HookFunc.end_count(counter2);
+			m_HookFunc.rewrite(tmppos2, static_cast<jit_int32_t>(counter2));
+
+			// *v_orig_ret = *v_override_ret
+			if (m_Proto.GetRet().size != 0)
+			{
+				if (m_Proto.GetRet().flags & PassInfo::PassFlag_ByRef)
+				{
+					// mov rcx, [rbp + v_override_ret]
+					// mov [rbp + v_orig_ret], rcx
+					X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RCX, REG_RBP, v_override_ret);
+					X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RBP, REG_RCX, v_orig_ret);
+				}
+				else
+				{
+					// lea rdi, [rbp + v_orig_ret]			<-- dest
+					// lea rsi, [rbp + v_override_ret]		<-- src
+					X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RDI, REG_RBP, v_orig_ret);
+					X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RSI, REG_RBP, v_override_ret);
+
+					if (m_Proto.GetRet().pAssignOperator)
+						CallAbs(m_Proto.GetRet().pAssignOperator);
+					else
+						BitwiseCopy(m_Proto.GetRet().size);
+				}
+			}
+
+			// skip don't call label target:
+			m_HookFunc.end_count(counter3);
+			m_HookFunc.rewrite(tmppos3, static_cast<jit_int32_t>(counter3));
+		}
+
+		// Sets *v_pContext to return value
+		void GenContext::CallSetupHookLoop(jit_int32_t v_orig_ret, jit_int32_t v_override_ret,
+			jit_int32_t v_cur_res, jit_int32_t v_prev_res, jit_int32_t v_status, jit_int32_t v_vfnptr_origentry,
+			jit_int32_t v_pContext)
+		{
+			// call shptr->SetupHookLoopParams(ms_HI, ourvfnptr, reinterpret_cast<void*>(this),
+			//  &vfnptr_origentry, &status, &prev_res, &cur_res, &orig_ret, &override_ret, NULL);
+			// orig_ret and override_ret are null for void funcs. We don't pass the params, so
+			// filtered hooks can't be added through us.
+			//
+			// rdi = shptr, rsi = hi, rdx = vfnptr, rcx = this, r8 = &vfnptr_origentry, r9 = &status
+			// on the stack: &prev_res, &cur_res, &orig_ret, &override_ret, params
+
+			if (m_Proto.GetRet().size == 0)
+			{
+				X64_Mov_Rm_Imm32_Disp(&m_HookFunc, REG_RSP, 0, 2 * SIZE_PTR);
+				X64_Mov_Rm_Imm32_Disp(&m_HookFunc, REG_RSP, 0, 3 * SIZE_PTR);
+			}
+			else
+			{
+				X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RBP, v_orig_ret);
+				X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RSP, REG_RAX, 2 * SIZE_PTR);
+				X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RBP, v_override_ret);
+				X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RSP, REG_RAX, 3 * SIZE_PTR);
+			}
+
+			X64_Mov_Rm_Imm32_Disp(&m_HookFunc, REG_RSP, 0, 4 * SIZE_PTR);
+
+			X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RBP, v_prev_res);
+			X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RSP, REG_RAX, 0);
+			X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RBP, v_cur_res);
+			X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RSP, REG_RAX, SIZE_PTR);
+
+			X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_R9, REG_RBP, v_status);
+			X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_R8, REG_RBP, v_vfnptr_origentry);
+
+			GenerateVfnPtrArgs();
+			X64_Mov_Reg_Imm64(&m_HookFunc, REG_RDI, PtrToImm(m_SHPtr));
+			X64_Mov_Reg_Imm64(&m_HookFunc, REG_RAX, SHVfunc(m_SHPtr, ISourceHook_SetupHookLoopParams));
+			X64_Call_Reg(&m_HookFunc, REG_RAX);
+
+			// store return value
+			X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RBP, REG_RAX, v_pContext);
+		}
+
+		void GenContext::CallBeginHookPlan(jit_int32_t v_pContext)
+		{
+			// pos = -1; shptr->BeginHookPlan(pContext, plan, &pos)
+			X64_Mov_Rm32_Imm32_Disp(&m_HookFunc, REG_RBP, -1, m_PlanPosVar);
+			X64_Mov_Reg_Imm64(&m_HookFunc, REG_RDI, PtrToImm(m_SHPtr));
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RSI, REG_RBP, v_pContext);
+			X64_Mov_Reg_Imm64(&m_HookFunc, REG_RDX, PtrToImm(m_pPlan));
+			X64_Lea_Reg_Rm_Disp(&m_HookFunc, REG_RCX, REG_RBP, m_PlanPosVar);
+			X64_Mov_Reg_Imm64(&m_HookFunc, REG_RAX, SHVfunc(m_SHPtr, ISourceHook_BeginHookPlan));
+			X64_Call_Reg(&m_HookFunc, REG_RAX);
+		}
+
+		void GenContext::CallEndContext(jit_int32_t v_pContext)
+		{
+			// shptr->EndContext(pContext)
+			X64_Mov_Reg_Imm64(&m_HookFunc, REG_RDI, PtrToImm(m_SHPtr));
+			X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RSI, REG_RBP, v_pContext);
+			X64_Mov_Reg_Imm64(&m_HookFunc, REG_RAX, SHVfunc(m_SHPtr, ISourceHook_EndContext));
+			X64_Call_Reg(&m_HookFunc, REG_RAX);
+		}
+
+		void * GenContext::GenerateHookFunc()
+		{
+			ComputeArgLocs();
+
+			const IntPassInfo &ret = m_Proto.GetRet();
+
+			// ********************** stack frame **********************
+			//   stack params							rbp + 16
+			//   ret address							rbp + 8
+			//   caller's rbp							rbp
+			//   register save area						rbp - 176		(16 byte aligned)
+			//
+			// non-void: add:
+			//   my_rettype orig_ret					(16 byte aligned)
+			//   my_rettype override_ret
+			//   my_rettype plugin_ret
+			//
+			// if required:
+			//   my_rettype place_for_memret
+			//   place forced byref params
+			//
+			// vafmt:
+			//   va_list va
+			//   char va_buf[STRBUF_LEN]
+			//
+			//   return value while destructing the ret vars: rax, rdx
+			//   void *vfnptr_origentry
+			//   IHookContext *pContext
+			//   IMyDelegate *iter
+			//   my_rettype *ret_ptr
+			//   varargs: saved rax (al = number of SSE registers used)
+			//   shared body: HookSite *site
+			//   META_RES status = MRES_IGNORED
+			//   META_RES prev_res
+			//   META_RES cur_res
+			//   specialized body: int plan_pos
+			//
+			//   outgoing stack params					rsp
+
+			// Big variables first, so everything stays aligned
+			ResetFrame(0);
+			m_RegSaveArea = AddVarToFrame(RegSaveAreaSize);
+
+			jit_int32_t v_orig_ret = 0;
+			jit_int32_t v_override_ret = 0;
+			jit_int32_t v_plugin_ret = 0;
+			if (ret.size != 0)
+			{
+				v_orig_ret =		AddVarToFrame(AlignSize(GetRealSize(ret), 16));
+				v_override_ret =	AddVarToFrame(AlignSize(GetRealSize(ret), 16));
+				v_plugin_ret =		AddVarToFrame(AlignSize(GetRealSize(ret), 16));
+			}
+
+			jit_int32_t v_place_for_memret = 0;
+			if (MemRetWithTempObj())
+				v_place_for_memret = AddVarToFrame(AlignSize(GetRealSize(ret), 16));
+
+			jit_int32_t v_place_fbrr_base = 0;
+			if (GetForcedByRefParamsSize())
+				v_place_fbrr_base = AddVarToFrame(GetForcedByRefParamsSize());
+
+			jit_int32_t v_va_list = 0;
+			jit_int32_t v_va_buf = 0;
+			if ((m_Proto.GetConvention() & ProtoInfo::CallConv_HasVafmt) == ProtoInfo::CallConv_HasVafmt)
+			{
+				v_va_list = AddVarToFrame(32);
+				v_va_buf = AddVarToFrame(AlignSize(SourceHook::STRBUF_LEN, 16));
+			}
+
+			const jit_int32_t v_ret_save =			AddVarToFrame(16);
+			const jit_int32_t v_vfnptr_origentry =	AddVarToFrame(SIZE_PTR);
+			const jit_int32_t v_pContext =			AddVarToFrame(SIZE_PTR);
+			const jit_int32_t v_iter =				AddVarToFrame(SIZE_PTR);
+			const jit_int32_t v_ret_ptr =			AddVarToFrame(SIZE_PTR);
+			const jit_int32_t v_saved_rax =			AddVarToFrame(SIZE_PTR);
+			m_SiteVar = m_IsSharedBody ? AddVarToFrame(SIZE_PTR) : 0;
+			const jit_int32_t v_status =			AddVarToFrame(sizeof(META_RES));
+			const jit_int32_t v_prev_res =			AddVarToFrame(sizeof(META_RES));
+			const jit_int32_t v_cur_res =			AddVarToFrame(sizeof(META_RES));
+			m_PlanPosVar = m_pPlan ? AddVarToFrame(sizeof(int)) : 0;
+
+			// Outgoing stack params: params + two extra pointers for vafmt; SetupHookLoopParams needs five slots
+			m_OutArgsSize = m_StackArgsSize + 2 * SIZE_PTR;
+			if (m_OutArgsSize < 5 * SIZE_PTR)
+				m_OutArgsSize = 5 * SIZE_PTR;
+			m_OutArgsSize = AlignSize(m_OutArgsSize, 16);
+
+			// prologue
+			//  push rbp
+			//  mov rbp, rsp
+			//  sub rsp, <frame size>		-- rsp stays 16 byte aligned
+			X64_Push_Reg(&m_HookFunc, REG_RBP);
+			X64_Mov_Reg_Reg(&m_HookFunc, REG_RBP, REG_RSP);
+			X64_Sub_Reg_Imm(&m_HookFunc, REG_RSP, AlignSize(ComputeVarsSize(), 16) + m_OutArgsSize);
+
+			// Shared body: keep the site the stub passed
+			//  mov [rbp + site], r11
+			if (m_IsSharedBody)
+				X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RBP, REG_R11, m_SiteVar);
+
+			SaveArgRegs(v_saved_rax);
+
+			// init status localvar
+			X64_Mov_Rm32_Imm32_Disp(&m_HookFunc, REG_RBP, MRES_IGNORED, v_status);
+
+			// ********************** SetupHookLoop **********************
+			// Before anything else: if there is nothing to do, the original function gets the call
+			// right away. Only the pointers to the ret vars are stored; they are constructed below.
+			CallSetupHookLoop(v_orig_ret, v_override_ret, v_cur_res, v_prev_res, v_status, v_vfnptr_origentry,
+				v_pContext);
+			GenerateBypass(v_saved_rax, v_vfnptr_origentry);
+
+			if ((m_Proto.GetConvention() & ProtoInfo::CallConv_HasVafmt) == ProtoInfo::CallConv_HasVafmt)
+				GenerateVafmt(v_va_list, v_va_buf);
+
+			// Call constructors for ret vars if required
+			if ((ret.flags & PassInfo::PassFlag_ByVal) && ret.pNormalCtor)
+			{
+				CallRetCtorDtor(ret.pNormalCtor, v_orig_ret);
+				CallRetCtorDtor(ret.pNormalCtor, v_override_ret);
+				CallRetCtorDtor(ret.pNormalCtor, v_plugin_ret);
+
+				// _don't_ call a constructor for v_place_for_memret !
+			}
+
+			if (m_pPlan)
+				CallBeginHookPlan(v_pContext);
+
+			// ********************** call pre hooks **********************
+			GenerateCallHooks(v_status, v_prev_res, v_cur_res, v_iter, v_pContext,
+				v_plugin_ret, v_place_for_memret, v_place_fbrr_base, v_va_buf, false);
+
+			// ********************** call orig func **********************
+			GenerateCallOrig(v_status, v_pContext, v_vfnptr_origentry, v_orig_ret,
+				v_override_ret, v_place_for_memret, v_place_fbrr_base, v_va_buf);
+
+			// ********************** call post hooks **********************
+			GenerateCallHooks(v_status, v_prev_res, v_cur_res, v_iter, v_pContext,
+				v_plugin_ret, v_place_for_memret, v_place_fbrr_base, v_va_buf, true);
+
+			// ********************** end context and return **********************
+
+			PrepareReturn(v_status, v_pContext, v_ret_ptr);
+
+			CallEndContext(v_pContext);
+
+			// Byval object params with a destructor are always forced byref here:
+			// the caller destructs them, not us.
+
+			DoReturn(v_ret_ptr);
+
+			// Call destructors of orig_ret/ ...
+			if ((ret.flags & PassInfo::PassFlag_ByVal) && ret.pDtor)
+			{
+				// Preserve return value in rax(:rdx)
+				X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RBP, REG_RAX, v_ret_save);
+				X64_Mov_Rm_Reg_Disp(&m_HookFunc, REG_RBP, REG_RDX, v_ret_save + 8);
+
+				CallRetCtorDtor(ret.pDtor, v_plugin_ret);
+				CallRetCtorDtor(ret.pDtor, v_override_ret);
+				CallRetCtorDtor(ret.pDtor, v_orig_ret);
+
+				X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RAX, REG_RBP, v_ret_save);
+				X64_Mov_Reg_Rm_Disp(&m_HookFunc, REG_RDX, REG_RBP, v_ret_save + 8);
+			}
+
+			// epilogue
+			//  leave
+			//  ret
+			X64_Leave(&m_HookFunc);
+			X64_Return(&m_HookFunc);
+
+			// Store pointer for later use
+			// m_HookfuncVfnPtr is a pointer to a void* because SH expects a pointer
+			// into the hookman's vtable
+			*m_HookfuncVfnptr = reinterpret_cast<void*>(m_HookFunc.GetData());
+
+			m_HookFunc.SetRE();
+
+			return m_HookFunc.GetData();
+		}
+
+		// Pre-condition: GenerateHookFunc() has been called!
+		void * GenContext::GeneratePubFunc()
+		{
+			jitoffs_t counter, tmppos;
+
+			// C Code:
+			//  int HookManPubFunc(
+			//     bool store,				dil
+			//     IHookManagerInfo *hi		rsi
+			//     )
+			//  {
+			//    if (store)
+			//      *m_pHI = hi;
+			//    if (hi)
+			//      hi->SetInfo(HOOKMAN_VERSION, m_VtblOffs, m_VtblIdx, m_Proto.GetProto(), m_HookfuncVfnptr)
+			//  }
+
+			// prologue (also aligns the stack for the call)
+			X64_Push_Reg(&m_PubFunc, REG_RBP);
+			X64_Mov_Reg_Reg(&m_PubFunc, REG_RBP, REG_RSP);
+
+			// Check for store == 0
+			X64_Test_Reg8_Reg8(&m_PubFunc, REG_RDI, REG_RDI);
+			tmppos = X64_Jump_Cond_Imm8(&m_PubFunc, CC_Z, 0);
+			m_PubFunc.start_count(counter);
+
+			// nonzero -> store hi
+			X64_Mov_Reg_Imm64(&m_PubFunc, REG_RAX, PtrToImm(m_pHI));
+			X64_Mov_Rm_Reg_Disp(&m_PubFunc, REG_RAX, REG_RSI, 0);
+
+			// zero
+			m_PubFunc.end_count(counter);
+			m_PubFunc.rewrite(tmppos, static_cast<jit_uint8_t>(counter));
+
+			// check for hi == 0
+			X64_Test_Reg_Reg(&m_PubFunc, REG_RSI, REG_RSI);
+			tmppos = X64_Jump_Cond_Imm8(&m_PubFunc, CC_Z, 0);
+			m_PubFunc.start_count(counter);
+
+			// nonzero -> call vfunc
+			X64_Mov_Reg_Reg(&m_PubFunc, REG_RDI, REG_RSI);
+			// Version 1: our hook funcs don't pass their parameters, so they don't support parameter filters
+			X64_Mov_Reg32_Imm32(&m_PubFunc, REG_RSI, 1);
+			X64_Mov_Reg32_Imm32(&m_PubFunc, REG_RDX, m_VtblOffs);
+			X64_Mov_Reg32_Imm32(&m_PubFunc, REG_RCX, m_VtblIdx);
+			X64_Mov_Reg_Imm64(&m_PubFunc, REG_R8, PtrToImm(m_BuiltPI));
+			X64_Mov_Reg_Imm64(&m_PubFunc, REG_R9, PtrToImm(m_HookfuncVfnptr));
+
+			// call the function. vtbloffs = 0, vtblidx = 0
+			X64_Mov_Reg_Rm_Disp(&m_PubFunc, REG_RAX, REG_RDI, 0);
+			X64_Call_Rm_Disp(&m_PubFunc, REG_RAX, 0);
+
+			// zero
+			m_PubFunc.end_count(counter);
+			m_PubFunc.rewrite(tmppos, static_cast<jit_uint8_t>(counter));
+
+			// return value
+			X64_Xor_Reg32_Reg32(&m_PubFunc, REG_RAX, REG_RAX);
+
+			// epilogue
+			X64_Leave(&m_PubFunc);
+			X64_Return(&m_PubFunc);
+
+			m_PubFunc.SetRE();
+
+			return m_PubFunc;
+		}
+
+		void GenContext::AutoDetectRetType()
+		{
+			IntPassInfo &pi = m_Proto.GetRet();
+
+			// Only relevant for byval types
+			if (pi.flags & PassInfo::PassFlag_ByVal)
+			{
+				// Basic + float:
+				if (pi.type == PassInfo::PassType_Basic ||
+					pi.type == PassInfo::PassType_Float)
+				{
+					// <= 8 bytes:
+					//    _always_ in registers, no matter what the user says
+					if (pi.size <= 8)
+					{
+						pi.flags &= ~PassInfo::PassFlag_RetMem;
+						pi.flags |= PassInfo::PassFlag_RetReg;
+					}
+					else
+					{
+						pi.flags &= ~PassInfo::PassFlag_RetReg;
+						pi.flags |= PassInfo::PassFlag_RetMem;
+					}
+				}
+				// Object:
+				else if (pi.type == PassInfo::PassType_Object)
+				{
+					// If the user says nothing, auto-detect
+					if ((pi.flags & (PassInfo::PassFlag_RetMem | PassInfo::PassFlag_RetReg)) == 0)
+					{
+						// Up to 16 bytes are returned in registers, unless the object
+						// has a non-trivial copy constructor or destructor.
+						// PassInfoSupported only accepts that for PassFlag_IntClass (rax:rdx).
+						if (pi.size > 16 || (pi.flags & (PassInfo::PassFlag_ODtor | PassInfo::PassFlag_CCtor)))
+							pi.flags |= PassInfo::PassFlag_RetMem;
+						else
+							pi.flags |= PassInfo::PassFlag_RetReg;
+					}
+				}
+			}
+			else
+			{
+				// byref: make sure that the flag is _not_ set
+				pi.flags &= ~PassInfo::PassFlag_RetMem;
+				pi.flags |= PassInfo::PassFlag_RetReg;
+			}
+		}
+
+		void GenContext::AutoDetectParamFlags()
+		{
+			// Objects with a non-trivial copy constructor or destructor are passed by invisible reference
+			for (int i = 0; i < m_Proto.GetNumOfParams(); ++i)
+			{
+				IntPassInfo &pi = m_Proto.GetParam(i);
+				if (pi.type == PassInfo::PassType_Object && (pi.flags & PassInfo::PassFlag_ByVal) &&
+					(pi.flags & (PassInfo::PassFlag_ODtor | PassInfo::PassFlag_CCtor)))
+				{
+					pi.flags |= PassFlag_ForcedByRef;
+				}
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,583 @@
+/* ======== SourceHook ========
+* vim: set ts=4 :
+* Copyright (C) 2004-2010 Metamod:Source Development Team
+* No warranties of any kind
+*
+* License: zlib/libpng
+*
+* x86-64 code emitters for the hook manager generator,
+* modeled after sourcehook_hookmangen_x86.h
+* ============================
+*/
+
+#ifndef __SOURCEHOOK_HOOKMANGEN_X86_64_H__
+#define __SOURCEHOOK_HOOKMANGEN_X86_64_H__
+
+#include <limits.h>
+
+//MOD R/M
+#define MOD_MEM_REG	0
+#define MOD_DISP8	1
+#define MOD_DISP32	2
+#define MOD_REG		3
+
+//SIB
+#define NOSCALE		0
+#define	SCALE2		1
+#define	SCALE4		2
+#define SCALE8		3
+
+
+//condition codes (for example, Jcc opcodes)
+#define CC_B	0x2
+#define CC_NB	0x3
+#define CC_E	0x4
+#define CC_Z	CC_E
+#define CC_NE	0x5
+#define CC_NZ	CC_NE
+#define CC_L	0xC
+#define CC_NGE	CC_L
+#define CC_NL	0xD
+#define CC_GE	CC_NL
+#define CC_NG	0xE
+#define CC_LE	CC_NG
+#define CC_G	0xF
+
+//Prefixes
+#define X64_REX				0x40	// 0100WRXB
+#define X64_REX_W			0x08
+#define X64_REX_R			0x04
+#define X64_REX_X			0x02
+#define X64_REX_B			0x01
+#define X64_16BIT_PREFIX	0x66
+#define X64_REP				0xF3
+#define X64_SSE_SS			0xF3	// scalar single precision
+#define X64_SSE_SD			0xF2	// scalar double precision
+
+//Opcodes with encoding information
+#define X64_ADD_REG_RM			0x03	// encoding is /r
+#define X64_ADD_RM_IMM32		0x81	// encoding is /0
+#define X64_ADD_RM_IMM8			0x83	// encoding is /0
+#define X64_SUB_RM_IMM32		0x81	// encoding is /5
+#define X64_SUB_RM_IMM8			0x83	// encoding is /5
+#define X64_CMP_RM_IMM32		0x81	// encoding is /7
+#define X64_CMP_RM_IMM8			0x83	// encoding is /7
+#define X64_XOR_RM_REG			0x31	// encoding is /r
+#define X64_CMP_RM_REG			0x39	// encoding is /r
+#define X64_TEST_RM_REG8		0x84	// encoding is /r
+#define X64_TEST_RM_REG			0x85	// encoding is /r
+#define X64_MOV_RM8_REG8		0x88	// encoding is /r
+#define X64_MOV_RM_REG			0x89	// encoding is /r
+#define X64_MOV_REG_RM			0x8B	// encoding is /r
+#define X64_LEA_REG_MEM			0x8D	// encoding is /r
+#define X64_MOV_REG8_IMM8		0xB0	// encoding is +r <imm8>
+#define X64_MOV_REG_IMM			0xB8	// encoding is +r <imm32/imm64>
+#define X64_MOV_RM8_IMM8		0xC6	// encoding is /0 <imm8>
+#define X64_MOV_RM_IMM32		0xC7	// encoding is /0 <imm32>
+#define X64_MOVZX_R32_RM8_1		0x0F	// opcode part 1
+#define X64_MOVZX_R32_RM8_2		0xB6	// encoding is /r
+#define X64_MOVZX_R32_RM16_1	0x0F	// opcode part 1
+#define X64_MOVZX_R32_RM16_2	0xB7	// encoding is /r
+#define X64_PUSH_REG			0x50	// encoding is +r
+#define X64_POP_REG				0x58	// encoding is +r
+#define X64_CALL_RM				0xFF	// encoding is /2
+#define X64_JMP_RM				0xFF	// encoding is /4
+#define X64_JMP_IMM32			0xE9	// encoding is imm32
+#define X64_JMP_IMM8			0xEB	// encoding is imm8
+#define X64_JCC_IMM				0x70	// encoding is +cc <imm8>
+#define X64_JCC_IMM32_1			0x0F	// opcode part 1
+#define X64_JCC_IMM32_2			0x80	// encoding is +cc <imm32>
+#define X64_RET					0xC3	// no extra encoding
+#define X64_LEAVE				0xC9	// no extra encoding
+#define X64_MOVSB				0xA4	// no extra encoding
+#define X64_MOVSQ				0xA5	// REX.W, no extra encoding
+#define X64_INT3				0xCC	// no extra encoding
+#define X64_SSE_MOV_1			0x0F	// opcode part 1 (movss/movsd/movaps)
+#define X64_SSE_MOV_XMM_RM		0x10	// movss/movsd xmm, m; encoding is /r
+#define X64_SSE_MOV_RM_XMM		0x11	// movss/movsd m, xmm; encoding is /r
+#define X64_MOVAPS_XMM_RM		0x28	// encoding is /r
+#define X64_MOVAPS_RM_XMM		0x29	// encoding is /r
+
+
+namespace SourceHook
+{
+	namespace Impl
+	{
+		typedef GenBuffer JitWriter;
+
+		// Register codes; r8-r15 need a REX prefix.
+		// Not macros: glibc's <sys/ucontext.h> already uses these names.
+		enum
+		{
+			REG_RAX = 0,
+			REG_RCX = 1,
+			REG_RDX = 2,
+			REG_RBX = 3,
+			REG_RSP = 4,
+			REG_SIB = 4,
+			REG_NOIDX = 4,
+			REG_RBP = 5,
+			REG_RSI = 6,
+			REG_RDI = 7,
+			REG_R8 = 8,
+			REG_R9 = 9,
+			REG_R10 = 10,
+			REG_R11 = 11,
+			REG_R12 = 12,
+			REG_R13 = 13,
+			REG_R14 = 14,
+			REG_R15 = 15
+		};
+
+
+		inline jit_uint8_t x64_modrm(jit_uint8_t mode, jit_uint8_t reg, jit_uint8_t rm)
+		{
+			return static_cast<jit_uint8_t>((mode << 6) | ((reg & 7) << 3) | (rm & 7));
+		}
+
+		inline jit_uint8_t x64_sib(jit_uint8_t mode, jit_uint8_t index, jit_uint8_t base)
+		{
+			return static_cast<jit_uint8_t>((mode << 6) | ((index & 7) << 3) | (base & 7));
+		}
+
+		// Writes a REX prefix if one is required.
+		//  wide: 64 bit operand size
+		//  reg: register in the reg field of ModRM, rm: register in the rm field (or SIB base)
+		//  force: also write it if no bit is set (spl/bpl/sil/dil as byte registers)
+		inline void x64_rex(JitWriter *jit, bool wide, jit_uint8_t reg, jit_uint8_t rm, bool force = false)
+		{
+			jit_uint8_t rex = 0;
+			if (wide)
+				rex |= X64_REX_W;
+			if (reg & 8)
+				rex |= X64_REX_R;
+			if (rm & 8)
+				rex |= X64_REX_B;
+			if (rex || force)
+				jit->write_ubyte(X64_REX | rex);
+		}
+
+		// Writes ModRM (+SIB) (+displacement) for [base + disp]
+		inline void x64_mem(JitWriter *jit, jit_uint8_t reg, jit_uint8_t base, jit_int32_t disp)
+		{
+			jit_uint8_t mode;
+			if (disp == 0 && (base & 7) != REG_RBP)
+				mode = MOD_MEM_REG;
+			else if (disp >= SCHAR_MIN && disp <= SCHAR_MAX)
+				mode = MOD_DISP8;
+			else
+				mode = MOD_DISP32;
+
+			jit->write_ubyte(x64_modrm(mode, reg, base));
+
+			// rsp and r12 as base need a SIB byte
+			if ((base & 7) == REG_SIB)
+				jit->write_ubyte(x64_sib(NOSCALE, REG_NOIDX, base));
+
+			if (mode == MOD_DISP8)
+				jit->write_byte(static_cast<jit_int8_t>(disp));
+			else if (mode == MOD_DISP32)
+				jit->write_int32(disp);
+		}
+
+		inline void X64_Int3(JitWriter *jit)
+		{
+			jit->write_ubyte(X64_INT3);
+		}
+
+		/**
+		* Stack Instructions
+		*/
+
+		inline void X64_Push_Reg(JitWriter *jit, jit_uint8_t reg)
+		{
+			x64_rex(jit, false, 0, reg);
+			jit->write_ubyte(X64_PUSH_REG + (reg & 7));
+		}
+
+		inline void X64_Pop_Reg(JitWriter *jit, jit_uint8_t reg)
+		{
+			x64_rex(jit, false, 0, reg);
+			jit->write_ubyte(X64_POP_REG + (reg & 7));
+		}
+
+		inline void X64_Leave(JitWriter *jit)
+		{
+			jit->write_ubyte(X64_LEAVE);
+		}
+
+		/**
+		* Moving
+		*/
+
+		// mov dest, src (64 bit)
+		inline void X64_Mov_Reg_Reg(JitWriter *jit, jit_uint8_t dest, jit_uint8_t src)
+		{
+			x64_rex(jit, true, src, dest);
+			jit->write_ubyte(X64_MOV_RM_REG);
+			jit->write_ubyte(x64_modrm(MOD_REG, src, dest));
+		}
+
+		// mov dest, QWORD PTR [src + disp]
+		inline void X64_Mov_Reg_Rm_Disp(JitWriter *jit, jit_uint8_t dest, jit_uint8_t src, jit_int32_t disp)
+		{
+			x64_rex(jit, true, dest, src);
+			jit->write_ubyte(X64_MOV_REG_RM);
+			x64_mem(jit, dest, src, disp);
+		}
+
+		// mov dest32, DWORD PTR [src + disp]
+		inline void X64_Mov_Reg32_Rm_Disp(JitWriter *jit, jit_uint8_t dest, jit_uint8_t src, jit_int32_t disp)
+		{
+			x64_rex(jit, false, dest, src);
+			jit->write_ubyte(X64_MOV_REG_RM);
+			x64_mem(jit, dest, src, disp);
+		}
+
+		// movzx dest32, BYTE PTR [src + disp]
+		inline void X64_Movzx_Reg32_Rm8_Disp(JitWriter *jit, jit_uint8_t dest, jit_uint8_t src, jit_int32_t disp)
+		{
+			x64_rex(jit, false, dest, src);
+			jit->write_ubyte(X64_MOVZX_R32_RM8_1);
+			jit->write_ubyte(X64_MOVZX_R32_RM8_2);
+			x64_mem(jit, dest, src, disp);
+		}
+
+		// movzx dest32, WORD PTR [src + disp]
+		inline void X64_Movzx_Reg32_Rm16_Disp(JitWriter *jit, jit_uint8_t dest, jit_uint8_t src, jit_int32_t disp)
+		{
+			x64_rex(jit, false, dest, src);
+			jit->write_ubyte(X64_MOVZX_R32_RM16_1);
+			jit->write_ubyte(X64_MOVZX_R32_RM16_2);
+			x64_mem(jit, dest, src, disp);
+		}
+
+		// mov QWORD PTR [dest + disp], src
+		inline void X64_Mov_Rm_Reg_Disp(JitWriter *jit, jit_uint8_t dest, jit_uint8_t src, jit_int32_t disp)
+		{
+			x64_rex(jit, true, src, dest);
+			jit->write_ubyte(X64_MOV_RM_REG);
+			x64_mem(jit, src, dest, disp);
+		}
+
+		// mov DWORD PTR [dest + disp], src32
+		inline void X64_Mov_Rm_Reg32_Disp(JitWriter *jit, jit_uint8_t dest, jit_uint8_t src, jit_int32_t disp)
+		{
+			x64_rex(jit, false, src, dest);
+			jit->write_ubyte(X64_MOV_RM_REG);
+			x64_mem(jit, src, dest, disp);
+		}
+
+		// mov WORD PTR [dest + disp], src16
+		inline void X64_Mov_Rm_Reg16_Disp(JitWriter *jit, jit_uint8_t dest, jit_uint8_t src, jit_int32_t disp)
+		{
+			jit->write_ubyte(X64_16BIT_PREFIX);
+			x64_rex(jit, false, src, dest);
+			jit->write_ubyte(X64_MOV_RM_REG);
+			x64_mem(jit, src, dest, disp);
+		}
+
+		// mov BYTE PTR [dest + disp], src8
+		inline void X64_Mov_Rm_Reg8_Disp(JitWriter *jit, jit_uint8_t dest, jit_uint8_t src, jit_int32_t disp)
+		{
+			x64_rex(jit, false, src, dest, src >= REG_RSP);
+			jit->write_ubyte(X64_MOV_RM8_REG8);
+			x64_mem(jit, src, dest, disp);
+		}
+
+		// mov DWORD PTR [dest + disp], imm32
+		inline void X64_Mov_Rm32_Imm32_Disp(JitWriter *jit, jit_uint8_t dest, jit_int32_t val, jit_int32_t disp)
+		{
+			x64_rex(jit, false, 0, dest);
+			jit->write_ubyte(X64_MOV_RM_IMM32);
+			x64_mem(jit, 0, dest, disp);
+			jit->write_int32(val);
+		}
+
+		// mov QWORD PTR [dest + disp], imm32 (sign extended)
+		inline void X64_Mov_Rm_Imm32_Disp(JitWriter *jit, jit_uint8_t dest, jit_int32_t val, jit_int32_t disp)
+		{
+			x64_rex(jit, true, 0, dest);
+			jit->write_ubyte(X64_MOV_RM_IMM32);
+			x64_mem(jit, 0, dest, disp);
+			jit->write_int32(val);
+		}
+
+		// mov BYTE PTR [dest + disp], imm8
+		inline void X64_Mov_Rm8_Imm8_Disp(JitWriter *jit, jit_uint8_t dest, jit_int8_t val, jit_int32_t disp)
+		{
+			x64_rex(jit, false, 0, dest);
+			jit->write_ubyte(X64_MOV_RM8_IMM8);
+			x64_mem(jit, 0, dest, disp);
+			jit->write_byte(val);
+		}
+
+		// mov dest32, imm32 (zero extends into dest)
+		inline void X64_Mov_Reg32_Imm32(JitWriter *jit, jit_uint8_t dest, jit_int32_t num)
+		{
+			x64_rex(jit, false, 0, dest);
+			jit->write_ubyte(X64_MOV_REG_IMM + (dest & 7));
+			jit->write_int32(num);
+		}
+
+		// mov dest8, imm8 (al, cl, dl, bl only)
+		inline void X64_Mov_Reg8_Imm8(JitWriter *jit, jit_uint8_t dest, jit_int8_t num)
+		{
+			jit->write_ubyte(X64_MOV_REG8_IMM8 + dest);
+			jit->write_byte(num);
+		}
+
+		// mov dest, imm64 ("movabs")
+		inline void X64_Mov_Reg_Imm64(JitWriter *jit, jit_uint8_t dest, jit_int64_t num)
+		{
+			x64_rex(jit, true, 0, dest);
+			jit->write_ubyte(X64_MOV_REG_IMM + (dest & 7));
+			jit->write_int64(num);
+		}
+
+		// lea dest, [src + disp]
+		inline void X64_Lea_Reg_Rm_Disp(JitWriter *jit, jit_uint8_t dest, jit_uint8_t src, jit_int32_t disp)
+		{
+			x64_rex(jit, true, dest, src);
+			jit->write_ubyte(X64_LEA_REG_MEM);
+			x64_mem(jit, dest, src, disp);
+		}
+
+		/**
+		* SSE moves (scalar float/double and whole registers)
+		*/
+
+		inline void x64_sse_mov(JitWriter *jit, jit_uint8_t prefix, jit_uint8_t opcode,
+			jit_uint8_t xmm, jit_uint8_t base, jit_int32_t disp)
+		{
+			if (prefix)
+				jit->write_ubyte(prefix);
+			x64_rex(jit, false, xmm, base);
+			jit->write_ubyte(X64_SSE_MOV_1);
+			jit->write_ubyte(opcode);
+			x64_mem(jit, xmm, base, disp);
+		}
+
+		// movss xmm, DWORD PTR [src + disp]
+		inline void X64_Movss_Xmm_Rm_Disp(JitWriter *jit, jit_uint8_t xmm, jit_uint8_t src, jit_int32_t disp)
+		{
+			x64_sse_mov(jit, X64_SSE_SS, X64_SSE_MOV_XMM_RM, xmm, src, disp);
+		}
+
+		// movss DWORD PTR [dest + disp], xmm
+		inline void X64_Movss_Rm_Xmm_Disp(JitWriter *jit, jit_uint8_t dest, jit_uint8_t xmm, jit_int32_t disp)
+		{
+			x64_sse_mov(jit, X64_SSE_SS, X64_SSE_MOV_RM_XMM, xmm, dest, disp);
+		}
+
+		// movsd xmm, QWORD PTR [src + disp]
+		inline void X64_Movsd_Xmm_Rm_Disp(JitWriter *jit, jit_uint8_t xmm, jit_uint8_t src, jit_int32_t disp)
+		{
+			x64_sse_mov(jit, X64_SSE_SD, X64_SSE_MOV_XMM_RM, xmm, src, disp);
+		}
+
+		// movsd QWORD PTR [dest + disp], xmm
+		inline void X64_Movsd_Rm_Xmm_Disp(JitWriter *jit, jit_uint8_t dest, jit_uint8_t xmm, jit_int32_t disp)
+		{
+			x64_sse_mov(jit, X64_SSE_SD, X64_SSE_MOV_RM_XMM, xmm, dest, disp);
+		}
+
+		// movaps xmm, XMMWORD PTR [src + disp]		- 16 byte aligned!
+		inline void X64_Movaps_Xmm_Rm_Disp(JitWriter *jit, jit_uint8_t xmm, jit_uint8_t src, jit_int32_t disp)
+		{
+			x64_sse_mov(jit, 0, X64_MOVAPS_XMM_RM, xmm, src, disp);
+		}
+
+		// movaps XMMWORD PTR [dest + disp], xmm	- 16 byte aligned!
+		inline void X64_Movaps_Rm_Xmm_Disp(JitWriter *jit, jit_uint8_t dest, jit_uint8_t xmm, jit_int32_t disp)
+		{
+			x64_sse_mov(jit, 0, X64_MOVAPS_RM_XMM, xmm, dest, disp);
+		}
+
+		/**
+		* Arithmetic / logic
+		*/
+
+		inline void x64_alu_reg_imm(JitWriter *jit, jit_uint8_t ext, jit_uint8_t reg, jit_int32_t val)
+		{
+			x64_rex(jit, true, 0, reg);
+			if (val >= SCHAR_MIN && val <= SCHAR_MAX)
+			{
+				jit->write_ubyte(X64_ADD_RM_IMM8);
+				jit->write_ubyte(x64_modrm(MOD_REG, ext, reg));
+				jit->write_byte(static_cast<jit_int8_t>(val));
+			}
+			else
+			{
+				jit->write_ubyte(X64_ADD_RM_IMM32);
+				jit->write_ubyte(x64_modrm(MOD_REG, ext, reg));
+				jit->write_int32(val);
+			}
+		}
+
+		// add reg, imm (64 bit)
+		inline void X64_Add_Reg_Imm(JitWriter *jit, jit_uint8_t reg, jit_int32_t val)
+		{
+			x64_alu_reg_imm(jit, 0, reg, val);
+		}
+
+		// add dest, QWORD PTR [src + disp]
+		inline void X64_Add_Reg_Rm_Disp(JitWriter *jit, jit_uint8_t dest, jit_uint8_t src, jit_int32_t disp)
+		{
+			x64_rex(jit, true, dest, src);
+			jit->write_ubyte(X64_ADD_REG_RM);
+			x64_mem(jit, dest, src, disp);
+		}
+
+		// sub reg, imm (64 bit)
+		inline void X64_Sub_Reg_Imm(JitWriter *jit, jit_uint8_t reg, jit_int32_t val)
+		{
+			x64_alu_reg_imm(jit, 5, reg, val);
+		}
+
+		// cmp DWORD PTR [reg + disp], imm
+		inline void X64_Cmp_Rm32_Imm_Disp(JitWriter *jit, jit_uint8_t reg, jit_int32_t val, jit_int32_t disp)
+		{
+			x64_rex(jit, false, 0, reg);
+			if (val >= SCHAR_MIN && val <= SCHAR_MAX)
+			{
+				jit->write_ubyte(X64_CMP_RM_IMM8);
+				x64_mem(jit, 7, reg, disp);
+				jit->write_byte(static_cast<jit_int8_t>(val));
+			}
+			else
+			{
+				jit->write_ubyte(X64_CMP_RM_IMM32);
+				x64_mem(jit, 7, reg, disp);
+				jit->write_int32(val);
+			}
+		}
+
+		// cmp reg1_32, reg2_32
+		inline void X64_Cmp_Reg32_Reg32(JitWriter *jit, jit_uint8_t reg1, jit_uint8_t reg2)
+		{
+			x64_rex(jit, false, reg2, reg1);
+			jit->write_ubyte(X64_CMP_RM_REG);
+			jit->write_ubyte(x64_modrm(MOD_REG, reg2, reg1));
+		}
+
+		// xor reg32, reg32
+		inline void X64_Xor_Reg32_Reg32(JitWriter *jit, jit_uint8_t dest, jit_uint8_t src)
+		{
+			x64_rex(jit, false, src, dest);
+			jit->write_ubyte(X64_XOR_RM_REG);
+			jit->write_ubyte(x64_modrm(MOD_REG, src, dest));
+		}
+
+		// test reg1, reg2 (64 bit)
+		inline void X64_Test_Reg_Reg(JitWriter *jit, jit_uint8_t reg1, jit_uint8_t reg2)
+		{
+			x64_rex(jit, true, reg2, reg1);
+			jit->write_ubyte(X64_TEST_RM_REG);
+			jit->write_ubyte(x64_modrm(MOD_REG, reg2, reg1));
+		}
+
+		// test reg1_8, reg2_8
+		inline void X64_Test_Reg8_Reg8(JitWriter *jit, jit_uint8_t reg1, jit_uint8_t reg2)
+		{
+			x64_rex(jit, false, reg2, reg1, reg1 >= REG_RSP || reg2 >= REG_RSP);
+			jit->write_ubyte(X64_TEST_RM_REG8);
+			jit->write_ubyte(x64_modrm(MOD_REG, reg2, reg1));
+		}
+
+		/**
+		* String operations (rdi <- rsi, count in rcx)
+		*/
+
+		inline void X64_Rep_Movsb(JitWriter *jit)
+		{
+			jit->write_ubyte(X64_REP);
+			jit->write_ubyte(X64_MOVSB);
+		}
+
+		inline void X64_Rep_Movsq(JitWriter *jit)
+		{
+			jit->write_ubyte(X64_REP);
+			jit->write_ubyte(X64_REX | X64_REX_W);
+			jit->write_ubyte(X64_MOVSQ);
+		}
+
+		/**
+		* Branching/Jumping
+		*/
+
+		inline jitoffs_t X64_Jump_Cond_Imm8(JitWriter *jit, jit_uint8_t cond, jit_int8_t disp)
+		{
+			jitoffs_t ptr;
+			jit->write_ubyte(X64_JCC_IMM + cond);
+			ptr = jit->get_outputpos();
+			jit->write_byte(disp);
+			return ptr;
+		}
+
+		inline jitoffs_t X64_Jump_Cond_Imm32(JitWriter *jit, jit_uint8_t cond, jit_int32_t disp)
+		{
+			jitoffs_t ptr;
+			jit->write_ubyte(X64_JCC_IMM32_1);
+			jit->write_ubyte(X64_JCC_IMM32_2 + cond);
+			ptr = jit->get_outputpos();
+			jit->write_int32(disp);
+			return ptr;
+		}
+
+		inline jitoffs_t X64_Jump_Imm8(JitWriter *jit, jit_int8_t disp)
+		{
+			jitoffs_t ptr;
+			jit->write_ubyte(X64_JMP_IMM8);
+			ptr = jit->get_outputpos();
+			jit->write_byte(disp);
+			return ptr;
+		}
+
+		inline jitoffs_t X64_Jump_Imm32(JitWriter *jit, jit_int32_t disp)
+		{
+			jitoffs_t ptr;
+			jit->write_ubyte(X64_JMP_IMM32);
+			ptr = jit->get_outputpos();
+			jit->write_int32(disp);
+			return ptr;
+		}
+
+		inline void X64_Jump_Reg(JitWriter *jit, jit_uint8_t reg)
+		{
+			x64_rex(jit, false, 0, reg);
+			jit->write_ubyte(X64_JMP_RM);
+			jit->write_ubyte(x64_modrm(MOD_REG, 4, reg));
+		}
+
+		// jmp QWORD PTR [reg + disp]
+		inline void X64_Jump_Rm_Disp(JitWriter *jit, jit_uint8_t reg, jit_int32_t disp)
+		{
+			x64_rex(jit, false, 0, reg);
+			jit->write_ubyte(X64_JMP_RM);
+			x64_mem(jit, 4, reg, disp);
+		}
+
+		inline void X64_Call_Reg(JitWriter *jit, jit_uint8_t reg)
+		{
+			x64_rex(jit, false, 0, reg);
+			jit->write_ubyte(X64_CALL_RM);
+			jit->write_ubyte(x64_modrm(MOD_REG, 2, reg));
+		}
+
+		// call QWORD PTR [reg + disp]
+		inline void X64_Call_Rm_Disp(JitWriter *jit, jit_uint8_t reg, jit_int32_t disp)
+		{
+			x64_rex(jit, false, 0, reg);
+			jit->write_ubyte(X64_CALL_RM);
+			x64_mem(jit, 2, reg, disp);
+		}
+
+		inline void X64_Return(JitWriter *jit)
+		{
+			jit->write_ubyte(X64_RET);
+		}
+	}
+}
+
+#endif
@@ -12,12 +12,15 @@
 #ifndef __SOURCEHOOK_IMPL_H__
 #define __SOURCEHOOK_IMPL_H__
 
+#include <atomic>
+#include <mutex>
 #include "sourcehook.h"
 #include "sh_memory.h"
 #include "sh_list.h"
 #include "sh_vector.h"
 #include "sh_tinyhash.h"
 #include "sh_stack.h"
+#include "sh_slaballoc.h"
 
 /*
 
@@ -56,7 +59,9 @@ Protos ("Prototypes")
 
 	Old protos begin with a non-zero byte, new protos begin with a zero byte.
 
-	Protos are usually stored in a CProto instance.
+	Protos are usually stored in a CProto instance. Hook managers and hook entries refer to
+	interned, immutable CProto instances through CProtoRef so that equal protos are shared
+	and can be compared by pointer.
 
 ---------------------------------------
 Hook managers and hook manager containers
@@ -88,9 +93,35 @@ Hooks
 	Hooks can be paused - they remain in memory but they are not called. In SH, the hook iterator
 	classes handle pausing transparently.
 
+	The hook loop doesn't walk the hook lists themselves: every CIface keeps a CHookArray per list,
+	a contiguous copy of its unpaused hooks which is rebuilt when a hook is added, removed, paused
+	or unpaused. A hook context remembers the serial number of the last hook it called; if the
+	array changed under it, it continues with the first hook which was added after that one.
+	This way, removing the current hook from inside a handler still continues with the next one.
+
+	Hooks can have a parameter filter (AddHookFiltered). Hook funcs of hook managers with version 2
+	or higher pass the addresses of their parameters to SetupHookLoopParams; the context then skips
+	the entries whose filter doesn't match, so their handlers are never called. Hook plans can't
+	skip handlers, so there are no plans for vfnptrs with filtered hooks.
+
+	Hook funcs of hook managers with version 3 or higher pass their override ret value as a LazyRet:
+	it's only constructed when it's first set (PrepareOverrideRet). They also call ShouldCallOrig
+	before they look at MRES_SUPERCEDE, so the context knows that the orig ret value is the
+	override ret value then and they don't have to copy it.
+
 	The hook loop is supposed to call ShouldContinue before each iteration. This makes hook handlers
 	able to remove themselves.
 
+Hook plans
+	A hook plan is the list of handlers the hook loop of a vfnptr would call right now, together with
+	the versions of the hook arrays it was made from. A hook func which has a plan baked in calls
+	BeginHookPlan; if the context is fresh and the arrays still have these versions, it calls the
+	handlers itself and only stores the number of the current step in one of its stack variables.
+	The context turns that into its usual position when someone asks (GetIfacePtr), and gives the
+	loop back to GetNext by writing -1 to the variable when the position has to move under it:
+	recalls, and hooks being changed on the same thread. Plan listeners are told about every change
+	so that they can make new plans.
+
 ---------------------------------------
 Call classes
 
@@ -143,7 +174,7 @@ Return Values in Post Recalls
 	However, what happens if we don't? ie. the status register is on MRES_IGNORED? In this case we'd have to transfer the
 	orig ret value. But we can't: There's no way to tell the hookfunc: "Use this as orig ret pointer". It uses its own.
 	So, we emulate it. GetOrigRet will return the orig ret pointer from the old hook loop. If still no one overrides it,
-	we'd have to return it. BUT! HOW TO DO THIS? Check out SH_RETURN(). First calls HookLoopEnd(), then decides whether
+	we'd have to return it. BUT! HOW TO DO THIS? Check out the end of HookLoop::Run. It first calls EndContext(), then decides whether
 	to return the override retval or the orig retval. But it doesn't ask for a new override return. So we give the function
 	the last orig return value as its new override return value; but leave status where it is so everything works, and in
 	HookLoopEnd we make sure that status is high enough so that the override return will be returned. crazy.
@@ -171,14 +202,43 @@ New SH_CALL
 	SourceHook stroes the "ignored vfnptr" and makes CVfnPtr::FindIface return NULL if the CVfnPtr instance
 	corresponds to the ignored vfnptr. This way the hook manager thinks that the instance isn't hooked, and calls
 	the original function. Everything works fine. This works even for VP hooks.
+
+---------------------------------------
+Threads
+	Hooked functions may be called on any thread. Every thread has its own context stack (kept by the
+	CEpochManager), so SH_CALL, recalls and the META_ macros only ever see the hook loops of their thread.
+
+	The hook loop takes no locks. Everything it reads - the hook manager's vfnptr index, the CVfnPtr's
+	iface index and VP iface, the CIface's hook arrays - is published with a single atomic store and never
+	changed in place afterwards. Removed CVfnPtrs, CIfaces, hook arrays, index tables and hook handlers are
+	retired and only deleted once no thread that could have seen them is inside of SourceHook anymore.
+	Contexts only learn about removed ifaces / vfnptrs on their own thread; on other threads they see
+	empty hook arrays instead.
+
+	Adding, removing and pausing hooks and unloading plugins are serialized by a lock. Hook managers and
+	plugins are still released right away though: unloading them is only safe when no other thread runs
+	their code. Pending plugin unloads are resolved on the thread which created CSourceHookImpl.
 */
 
+namespace SourceHook
+{
+	// Pointer and integer keys for the THash indices (see sourcehook.cpp)
+	template<> int HashFunction<int>(const int & k);
+	template<> int Compare<int>(const int & k1, const int & k2);
+	template<> int HashFunction<void*>(void * const & k);
+	template<> int Compare<void*>(void * const & k1, void * const & k2);
+}
+
 #include "sourcehook_impl_cproto.h"
+#include "sourcehook_impl_cpagemap.h"
+#include "sourcehook_impl_cepochman.h"
+#include "sourcehook_impl_cptrmap.h"
 #include "sourcehook_impl_chookmaninfo.h"
 #include "sourcehook_impl_chook.h"
 #include "sourcehook_impl_ciface.h"
 #include "sourcehook_impl_cvfnptr.h"
 #include "sourcehook_impl_chookidman.h"
+#include "sourcehook_impl_chookprofiler.h"
 
 namespace SourceHook
 {
@@ -190,7 +250,7 @@ namespace SourceHook
 	{
 		struct CHookContext : IHookContext
 		{
-			CHookContext() : m_CleanupTask(NULL)
+			CHookContext() : m_pParams(NULL), m_pProfiler(NULL), m_ProfHookID(0), m_pPlan(NULL), m_pPlanPos(NULL)
 			{
 			}
 
@@ -213,7 +273,16 @@ namespace SourceHook
 			};
 
 			int m_State;
-			List<CHook>::iterator m_Iter;
+
+			// Position in the current hook array: the last hook we returned.
+			// m_LastSerial == 0 means that we haven't returned a hook from the array yet.
+			// m_LastIndex is only valid while the array's version is still m_ArrayVersion (never 0).
+			HookSerial m_LastSerial;
+			size_t m_LastIndex;
+			HookSerial m_ArrayVersion;
+			int m_LastHookID;
+			Plugin m_LastPlug;
+			int m_VtblIdx;
 
 			CVfnPtr *pVfnPtr;
 			CIface *pIface;
@@ -227,17 +296,44 @@ namespace SourceHook
 			void *pOverrideRet;
 			void *pIfacePtr;
 
+			// Whether *pOverrideRet is an object yet (see LazyRet). NULL if it always is.
+			bool *pOverrideConstructed;
+
+			// The hook func didn't call the original function because of MRES_SUPERCEDE
+			// (only known for hookman version 3 or higher, see ShouldCallOrig)
+			bool m_Superceded;
+
+			// Addresses of the parameters, for the hook filters. NULL if the hook func doesn't pass them.
+			const void * const *m_pParams;
+
 			bool m_CallOrig;
 
-			ICleanupTask *m_CleanupTask;
+			// Only set while profiling: the hook whose handler is running and since when
+			CHookProfiler *m_pProfiler;
+			int m_ProfHookID;
+			HookSerial m_ProfSerial;
+			Plugin m_ProfPlug;
+			bool m_ProfPost;
+			CHookProfiler::Timestamp m_ProfStart;
 
-			void SkipPaused(List<CHook>::iterator &iter, List<CHook> &list)
+			// Only set while the hook func walks a hook plan (see BeginHookPlan). It only keeps
+			// *m_pPlanPos up to date; the members above are brought in line on demand.
+			const HookPlan *m_pPlan;
+			int *m_pPlanPos;
+
+			void ResetIter()
 			{
-				while (iter != list.end() && iter->IsPaused())
-					++iter;
+				m_LastSerial = 0;
+				m_LastIndex = 0;
+				m_ArrayVersion = 0;
 			}
+
+			ISHDelegate *NextHook(const CHookArray &hooks);
+			ISHDelegate *NextHandler();
 		public:
-			void HookRemoved(List<CHook>::iterator oldhookiter, List<CHook>::iterator nexthookiter);
+			void SyncPlan();
+			void LeavePlan();
+
 			void IfaceRemoved(CIface *iface);
 			void VfnPtrRemoved(CVfnPtr *vfnptr);
 
@@ -245,13 +341,19 @@ namespace SourceHook
 			void *GetOverrideRetPtr();
 			const void *GetOrigRetPtr();
 			bool ShouldCallOrig();
-			void DoCleanupTaskAndDeleteIt();
 		};
 
-		class CVfnPtrList : public List<CVfnPtr>
+		// Only used by writers; the hook loop gets to its CVfnPtr through the hook manager
+		class CVfnPtrList : public PooledList<CVfnPtr*>
 		{
+			// vfnptr -> list node. List nodes never move.
+			THash<void*, iterator> m_Index;
 		public:
-			CVfnPtr *GetVfnPtr(void *p);
+			CVfnPtr *GetVfnPtr(void *p, CEpochManager *pEpochs, CPatchBatch *pBatch);
+
+			// Indexed replacements for List::find / List::erase
+			iterator find(void *vfnptr);
+			iterator erase(iterator where);
 		};
 
 		typedef CStack<CHookContext> HookContextStack;
@@ -262,7 +364,7 @@ namespace SourceHook
 			virtual void ReadyToUnload(Plugin plug) = 0;
 		};
 
-		class PendingUnload
+		class PendingUnload : public CSlabAllocated<PendingUnload>
 		{
 			UnloadListener *listener_;
 			Plugin plug_;
@@ -296,15 +398,58 @@ namespace SourceHook
 		class CSourceHookImpl : public ISourceHook
 		{
 		private:
+			// Declared first: retired objects are deleted last, when everything else is gone
+			CEpochManager m_Epochs;
+
+			// Serializes everything that changes hooks, hook managers or pending unloads
+			std::recursive_mutex m_WriteLock;
+
 			CHookManList m_HookManList;
 			CVfnPtrList m_VfnPtrs;
 			CHookIDManager m_HookIDMan;
-			HookContextStack m_ContextStack;
-			List<PendingUnload *> m_PendingUnloads;
+			HookSerial m_LastHookSerial;
+			PooledList<PendingUnload *> m_PendingUnloads;
+			std::atomic<bool> m_HasPendingUnloads;
+
+			CHookProfiler m_Profiler;
+			std::atomic<CHookProfiler *> m_pActiveProfiler;			// NULL unless profiling
 
+			// Hook batches (see BeginHookBatch): the hook manager which was resolved last
+			int m_BatchDepth;
+			Plugin m_BatchHookManPlug;
+			HookManagerPubFunc m_BatchHookManPubFunc;
+			CHookManager *m_BatchHookMan;
+			CPatchBatch m_PatchBatch;					// vtable patches queued by the running hook batch
+
+			CVector<IHookPlanListener*> m_PlanListeners;
+			CVector<void*> m_BatchPlanChanges;			// vfnptrs changed by the running hook batch
+			CVector<void*> m_IdleVfnPtrs;				// vfnptrs which went idle on the last change
+
+			CHookManager *ResolveHookManager(Plugin plug, HookManagerPubFunc pubFunc);
 			bool SetHookPaused(int hookid, bool paused);
 			CHookManList::iterator RemoveHookManager(CHookManList::iterator iter);
-			List<CVfnPtr>::iterator RevertAndRemoveVfnPtr(List<CVfnPtr>::iterator vfnptr_iter);
+			CVfnPtrList::iterator RevertAndRemoveVfnPtr(CVfnPtrList::iterator vfnptr_iter);
+
+			// The hooks of the vfnptr have changed: update its idle state, take this thread's hook loops
+			// off their plans and tell the plan listeners
+			void HookSetChanged(CVfnPtr *pVfnPtr);
+
+			// mayBypass: the hook func can handle a NULL return (see SetupHookLoopParams)
+			IHookContext *SetupContext(IHookManagerInfo *hi, void *vfnptr, void *thisptr, void **origCallAddr,
+				META_RES *statusPtr, META_RES *prevResPtr, META_RES *curResPtr, const void *origRetPtr, void *overrideRetPtr,
+				const void * const *params, bool mayBypass);
+
+			// The address a hook func can call directly instead of running the hook loop, or NULL
+			void *GetBypassCallAddr(CVfnPtr *pVfnPtr, CIface *pIface, void *vfnptr);
+
+			// Unpatches the slots which are still idle since the last change (see HookSetChanged)
+			void UnpatchIdle();
+
+			// The context stack of the calling thread
+			inline HookContextStack &GetContextStack();
+
+			static CVfnPtr *FindVfnPtr(IHookManagerInfo *hi, void *vfnptr);
+			static void *GetCurrentVfnPtrEntry(void *vfnptr);
 		public:
 			CSourceHookImpl();
 			virtual ~CSourceHookImpl();
@@ -322,6 +467,9 @@ namespace SourceHook
 			int AddHook(Plugin plug, AddHookMode mode, void *iface, int thisptr_offs, HookManagerPubFunc myHookMan,
 				ISHDelegate *handler, bool post);
 
+			int AddHookFiltered(Plugin plug, AddHookMode mode, void *iface, int thisptr_offs, HookManagerPubFunc myHookMan,
+				ISHDelegate *handler, bool post, const HookFilter *filter);
+
 			bool RemoveHook(Plugin plug, void *iface, int thisptr_offs, HookManagerPubFunc myHookMan,
 				ISHDelegate *handler, bool post);
 
@@ -362,11 +510,37 @@ namespace SourceHook
 
 			IHookContext *SetupHookLoop(IHookManagerInfo *hi, void *vfnptr, void *thisptr, void **origCallAddr, META_RES *statusPtr,
 				META_RES *prevResPtr, META_RES *curResPtr, const void *origRetPtr, void *overrideRetPtr);
+			IHookContext *SetupHookLoopParams(IHookManagerInfo *hi, void *vfnptr, void *thisptr, void **origCallAddr,
+				META_RES *statusPtr, META_RES *prevResPtr, META_RES *curResPtr, const void *origRetPtr, void *overrideRetPtr,
+				const void * const *params);
+
+			void *PrepareOverrideRet(bool *construct);
 
 			void EndContext(IHookContext *pCtx);
 
+			void BeginHookBatch();
+			void CommitHookBatch();
+
+			void AddHookPlanListener(IHookPlanListener *listener);
+			void RemoveHookPlanListener(IHookPlanListener *listener);
+			bool GetHookPlan(IHookManagerInfo *hi, void *vfnptr, HookPlan *plan, int maxSteps);
+			bool BeginHookPlan(IHookContext *pCtx, const HookPlan *plan, int *pPos);
+
 			void *GetOrigVfnPtrEntry(void *vfnptr);
 
+			/**
+			*	@brief Starts collecting per-hook call counts and handler times, discarding old ones
+			*/
+			void StartProfiling();
+
+			/**
+			*	@brief Stops collecting; the stats stay available until the next StartProfiling
+			*/
+			void StopProfiling();
+
+			bool IsProfiling() const;
+			const CHookProfiler &GetProfiler() const;
+
 			/**
 			*	@brief Shut down the whole system, unregister all hook managers
 			*/
@@ -386,6 +560,11 @@ namespace SourceHook
 			*/
 			void UnpausePlugin(Plugin plug);
 		};
+
+		inline HookContextStack &CSourceHookImpl::GetContextStack()
+		{
+			return m_Epochs.GetThreadState().m_Contexts;
+		}
 	}
 }
 
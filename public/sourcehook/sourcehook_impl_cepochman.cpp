@@ -0,0 +1,136 @@
+/* ======== SourceHook ========
+* Copyright (C) 2004-2010 Metamod:Source Development Team
+* No warranties of any kind
+*
+* License: zlib/libpng
+*
+* Author(s): Pavol "PM OnoTo" Marko
+* ============================
+*/
+
+#include "sourcehook_impl.h"
+
+namespace SourceHook
+{
+	namespace Impl
+	{
+		std::atomic<unsigned int> CEpochManager::ms_LastInstance(0);
+		thread_local CEpochManager::ThreadCache CEpochManager::ms_ThreadCache = { 0, NULL };
+		thread_local char CEpochManager::ms_ThreadKey;
+
+		CEpochManager::CEpochManager() : m_Instance(++ms_LastInstance), m_Epoch(1), m_Threads(NULL),
+			m_NumRetired(0)
+		{
+			m_pOwnerThread = &LookupThreadState();
+		}
+
+		CEpochManager::~CEpochManager()
+		{
+			Reclaim(true);
+
+			ThreadState *state = m_Threads.load();
+			while (state)
+			{
+				ThreadState *next = state->m_pNext;
+				delete state;
+				state = next;
+			}
+
+			if (ms_ThreadCache.instance == m_Instance)
+				ms_ThreadCache.instance = 0;
+		}
+
+		CEpochManager::ThreadState &CEpochManager::LookupThreadState()
+		{
+			// A thread's key is the address of its copy of ms_ThreadKey. Threads which have exited
+			// were outside of SourceHook, so a new thread that gets the same address may take over.
+			ThreadState *state;
+			for (state = m_Threads.load(std::memory_order_acquire); state; state = state->m_pNext)
+			{
+				if (state->m_ThreadKey == &ms_ThreadKey)
+					break;
+			}
+
+			if (state == NULL)
+			{
+				state = new ThreadState;
+				state->m_Depth = 0;
+				state->m_ActiveEpoch.store(0, std::memory_order_relaxed);
+				state->m_ThreadKey = &ms_ThreadKey;
+
+				ThreadState *head = m_Threads.load(std::memory_order_relaxed);
+				do
+				{
+					state->m_pNext = head;
+				} while (!m_Threads.compare_exchange_weak(head, state, std::memory_order_release,
+					std::memory_order_relaxed));
+			}
+
+			ms_ThreadCache.instance = m_Instance;
+			ms_ThreadCache.state = state;
+			return *state;
+		}
+
+		CEpochManager::Epoch CEpochManager::GetOldestActiveEpoch() const
+		{
+			// Pairs with the fence in Enter
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			Epoch oldest = 0;
+			for (ThreadState *state = m_Threads.load(std::memory_order_acquire); state; state = state->m_pNext)
+			{
+				// Acquire: what the thread did before it left happens before we free anything
+				Epoch active = state->m_ActiveEpoch.load(std::memory_order_acquire);
+				if (active != 0 && (oldest == 0 || active < oldest))
+					oldest = active;
+			}
+			return oldest;
+		}
+
+		bool CEpochManager::IsAnyThreadActive() const
+		{
+			return GetOldestActiveEpoch() != 0;
+		}
+
+		void CEpochManager::Retire(ReclaimFunc func, void *ptr)
+		{
+			Retired retired;
+			retired.func = func;
+			retired.ptr = ptr;
+
+			// Whoever enters from now on won't find the object anymore
+			retired.epoch = m_Epoch.fetch_add(1) + 1;
+
+			m_Retired.push_back(retired);
+			m_NumRetired.store(m_Retired.size(), std::memory_order_relaxed);
+		}
+
+		void CEpochManager::Reclaim(bool force)
+		{
+			if (m_Retired.empty())
+				return;
+
+			Epoch oldest = force ? 0 : GetOldestActiveEpoch();
+
+			// Retired objects may retire others when they are freed; don't iterate over m_Retired then
+			CVector<Retired> ready;
+			size_t kept = 0;
+			for (size_t i = 0; i < m_Retired.size(); ++i)
+			{
+				if (oldest == 0 || m_Retired[i].epoch <= oldest)
+					ready.push_back(m_Retired[i]);
+				else
+					m_Retired[kept++] = m_Retired[i];
+			}
+			m_Retired.resize(kept);
+
+			for (size_t i = 0; i < ready.size(); ++i)
+				ready[i].func(ready[i].ptr);
+
+			if (force && !m_Retired.empty())
+				Reclaim(true);
+
+			m_NumRetired.store(m_Retired.size(), std::memory_order_relaxed);
+		}
+	}
+}
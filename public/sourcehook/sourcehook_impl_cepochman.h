@@ -0,0 +1,181 @@
+/* ======== SourceHook ========
+* Copyright (C) 2004-2010 Metamod:Source Development Team
+* No warranties of any kind
+*
+* License: zlib/libpng
+*
+* Author(s): Pavol "PM OnoTo" Marko
+* ============================
+*/
+
+#ifndef __SOURCEHOOK_IMPL_CEPOCHMAN_H__
+#define __SOURCEHOOK_IMPL_CEPOCHMAN_H__
+
+#include <atomic>
+#include "sh_stack.h"
+#include "sh_vector.h"
+
+namespace SourceHook
+{
+	namespace Impl
+	{
+		struct CHookContext;
+
+		/*
+		Per-thread hook context stacks and epoch based reclamation.
+
+		Hook loops may run on any thread. Each thread gets its own context stack, and while a
+		thread is inside of SourceHook (it has a context on its stack or is in SetupHookLoopParams)
+		it announces the epoch it entered in. The structures the hook loop reads (hook arrays,
+		iface and vfnptr indices, CIface and CVfnPtr objects, handlers) are never changed in
+		place by writers: they publish a replacement and Retire() the old one. A retired object
+		is only freed by Reclaim() once every thread which could still see it has left.
+
+		Writers (adding, removing, pausing hooks...) are serialized by CSourceHookImpl; Retire
+		and Reclaim may only be called by the writer.
+		*/
+		class CEpochManager
+		{
+		public:
+			typedef unsigned long long Epoch;
+
+			struct ThreadState
+			{
+				CStack<CHookContext> m_Contexts;
+
+				// Only touched by the owning thread
+				int m_Depth;
+
+				// The epoch in which the thread has entered; 0 while it's outside
+				std::atomic<Epoch> m_ActiveEpoch;
+
+				const void *m_ThreadKey;
+				ThreadState *m_pNext;
+			};
+
+			typedef void (*ReclaimFunc)(void *ptr);
+		private:
+			struct Retired
+			{
+				ReclaimFunc func;
+				void *ptr;
+				Epoch epoch;
+			};
+
+			struct ThreadCache
+			{
+				unsigned int instance;
+				ThreadState *state;
+			};
+
+			static std::atomic<unsigned int> ms_LastInstance;
+			static thread_local ThreadCache ms_ThreadCache;
+			static thread_local char ms_ThreadKey;
+
+			unsigned int m_Instance;
+			std::atomic<Epoch> m_Epoch;
+			std::atomic<ThreadState *> m_Threads;
+			ThreadState *m_pOwnerThread;
+
+			CVector<Retired> m_Retired;
+			std::atomic<size_t> m_NumRetired;
+
+			ThreadState &LookupThreadState();
+			Epoch GetOldestActiveEpoch() const;
+
+			template <class T> static void DeleteObject(void *ptr)
+			{
+				delete reinterpret_cast<T*>(ptr);
+			}
+
+			CEpochManager(const CEpochManager &other);
+			CEpochManager &operator =(const CEpochManager &other);
+		public:
+			CEpochManager();
+
+			// Runs everything that is still retired
+			~CEpochManager();
+
+			// The state of the calling thread, created on first use
+			inline ThreadState &GetThreadState();
+
+			// The thread which created us; pending plugin unloads are only resolved on it
+			inline bool IsOwnerThread(const ThreadState &state) const;
+
+			// Nestable; objects retired after the outermost Enter stay alive until the matching Leave
+			inline void Enter(ThreadState &state);
+			inline void Leave(ThreadState &state);
+
+			// Returns whether any thread is inside of SourceHook
+			bool IsAnyThreadActive() const;
+
+			// The object has to be unreachable for threads entering from now on
+			void Retire(ReclaimFunc func, void *ptr);
+			template <class T> void RetireObject(T *ptr)
+			{
+				Retire(&DeleteObject<T>, ptr);
+			}
+
+			inline bool HasRetired() const;
+
+			// Frees what no thread can see anymore. With force, frees everything.
+			void Reclaim(bool force = false);
+
+			class Guard
+			{
+				CEpochManager &m_Epochs;
+				ThreadState &m_State;
+			public:
+				Guard(CEpochManager &epochs, ThreadState &state) : m_Epochs(epochs), m_State(state)
+				{
+					m_Epochs.Enter(m_State);
+				}
+				~Guard()
+				{
+					m_Epochs.Leave(m_State);
+				}
+			};
+		};
+
+		// *** Implementation ***
+
+		inline CEpochManager::ThreadState &CEpochManager::GetThreadState()
+		{
+			if (ms_ThreadCache.instance == m_Instance)
+				return *ms_ThreadCache.state;
+			return LookupThreadState();
+		}
+
+		inline bool CEpochManager::IsOwnerThread(const ThreadState &state) const
+		{
+			return &state == m_pOwnerThread;
+		}
+
+		inline void CEpochManager::Enter(ThreadState &state)
+		{
+			if (state.m_Depth++ != 0)
+				return;
+
+			state.m_ActiveEpoch.store(m_Epoch.load(std::memory_order_relaxed), std::memory_order_release);
+
+			// The announcement has to be visible before we read anything published;
+			// pairs with the fence in Reclaim
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+		}
+
+		inline void CEpochManager::Leave(ThreadState &state)
+		{
+			if (--state.m_Depth != 0)
+				return;
+
+			state.m_ActiveEpoch.store(0, std::memory_order_release);
+		}
+
+		inline bool CEpochManager::HasRetired() const
+		{
+			return m_NumRetired.load(std::memory_order_relaxed) != 0;
+		}
+	}
+}
+
+#endif
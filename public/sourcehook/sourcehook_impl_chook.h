@@ -11,10 +11,27 @@
 #ifndef __SOURCEHOOK_IMPL_CHOOK_H__
 #define __SOURCEHOOK_IMPL_CHOOK_H__
 
+#include <string.h>
+
 namespace SourceHook
 {
 	namespace Impl
 	{
+		// Hooks get a serial number from an ever increasing counter when they are added.
+		// Hooks are always appended to their hook list, so serials are sorted in list order.
+		typedef unsigned long long HookSerial;
+
+		// A HookFilter, checked against the proto of the hook manager
+		struct CHookFilter
+		{
+			int m_Param;
+			size_t m_Size;				// 1, 2, 4 or 8
+			int m_NumValues;
+			unsigned long long m_Values[HookFilter::MaxValues];	// Truncated to m_Size bytes
+
+			inline bool Matches(const void * const *params) const;
+		};
+
 		class CHook
 		{
 			// *** Data ***
@@ -22,6 +39,8 @@ namespace SourceHook
 			int m_ThisPointerOffset;
 			ISHDelegate *m_pHandler;
 			int m_HookID;
+			HookSerial m_Serial;
+			const CHookFilter *m_pFilter;
 			bool m_Paused;
 		public:
 
@@ -40,7 +59,8 @@ namespace SourceHook
 			};
 
 			// *** Interface ***
-			inline CHook(Plugin ownerPlugin, int thisPtrOffset, ISHDelegate *pHandler, int hookid, bool paused=false);
+			inline CHook(Plugin ownerPlugin, int thisPtrOffset, ISHDelegate *pHandler, int hookid, HookSerial serial,
+				const CHookFilter *pFilter, bool paused=false);
 			inline bool operator==(const Descriptor &other) const;
 			inline bool operator==(int hookid) const;
 			inline Plugin GetOwnerPlugin() const;
@@ -49,12 +69,55 @@ namespace SourceHook
 			inline void SetPaused(bool value);
 			inline bool IsPaused() const;
 			inline int GetID() const;
+			inline HookSerial GetSerial() const;
+			inline const CHookFilter *GetFilter() const;
 		};
 
 		// *** Implementation ***
-		inline CHook::CHook(Plugin ownerPlugin, int thisPtrOffset, ISHDelegate *pHandler, int hookid, bool paused)
+		inline bool CHookFilter::Matches(const void * const *params) const
+		{
+			unsigned long long value;
+			const void *param = params[m_Param];
+			switch (m_Size)
+			{
+			case 1:
+				{
+					unsigned char tmp;
+					memcpy(&tmp, param, sizeof(tmp));
+					value = tmp;
+					break;
+				}
+			case 2:
+				{
+					unsigned short tmp;
+					memcpy(&tmp, param, sizeof(tmp));
+					value = tmp;
+					break;
+				}
+			case 4:
+				{
+					unsigned int tmp;
+					memcpy(&tmp, param, sizeof(tmp));
+					value = tmp;
+					break;
+				}
+			default:
+				memcpy(&value, param, sizeof(value));
+				break;
+			}
+
+			for (int i = 0; i < m_NumValues; ++i)
+			{
+				if (m_Values[i] == value)
+					return true;
+			}
+			return false;
+		}
+
+		inline CHook::CHook(Plugin ownerPlugin, int thisPtrOffset, ISHDelegate *pHandler, int hookid, HookSerial serial,
+			const CHookFilter *pFilter, bool paused)
 			: m_OwnerPlugin(ownerPlugin), m_ThisPointerOffset(thisPtrOffset),
-			m_pHandler(pHandler), m_HookID(hookid), m_Paused(paused)
+			m_pHandler(pHandler), m_HookID(hookid), m_Serial(serial), m_pFilter(pFilter), m_Paused(paused)
 		{
 		}
 
@@ -99,6 +162,16 @@ namespace SourceHook
 		{
 			return m_HookID;
 		}
+
+		inline HookSerial CHook::GetSerial() const
+		{
+			return m_Serial;
+		}
+
+		inline const CHookFilter *CHook::GetFilter() const
+		{
+			return m_pFilter;
+		}
 	}
 }
 
@@ -13,29 +13,133 @@
 
 namespace SourceHook
 {
+	template<>
+	int HashFunction<Impl::CHookIDManager::IndexKey>(const Impl::CHookIDManager::IndexKey & k)
+	{
+		return HashFunction<void*>(k.adjustediface) ^ (k.vtbl_idx * 31 + k.vtbl_offs);
+	}
+	template<>
+	int Compare<Impl::CHookIDManager::IndexKey>(const Impl::CHookIDManager::IndexKey & k1,
+		const Impl::CHookIDManager::IndexKey & k2)
+	{
+		if (k1.adjustediface != k2.adjustediface)
+			return Compare<void*>(k1.adjustediface, k2.adjustediface);
+		if (k1.vtbl_offs != k2.vtbl_offs)
+			return Compare<int>(k1.vtbl_offs, k2.vtbl_offs);
+		return Compare<int>(k1.vtbl_idx, k2.vtbl_idx);
+	}
+
 	namespace Impl
 	{
-		CHookIDManager::CHookIDManager()
+		CHookIDManager::CHookIDManager() : m_FirstFree(0)
+		{
+		}
+
+		void CHookIDManager::Link(int hookid)
+		{
+			Entry &entry = GetEntry(hookid);
+
+			int &plughead = m_PlugIndex[entry.plug];
+			entry.plug_prev = 0;
+			entry.plug_next = plughead;
+			if (plughead)
+				GetEntry(plughead).plug_prev = hookid;
+			plughead = hookid;
+
+			int &keyhead = m_KeyIndex[IndexKey(entry.adjustediface, entry.vtbl_offs, entry.vtbl_idx)];
+			entry.key_prev = 0;
+			entry.key_next = keyhead;
+			if (keyhead)
+				GetEntry(keyhead).key_prev = hookid;
+			keyhead = hookid;
+		}
+
+		void CHookIDManager::Unlink(int hookid)
+		{
+			Entry &entry = GetEntry(hookid);
+
+			if (entry.plug_next)
+				GetEntry(entry.plug_next).plug_prev = entry.plug_prev;
+			if (entry.plug_prev)
+				GetEntry(entry.plug_prev).plug_next = entry.plug_next;
+			else if (entry.plug_next)
+				*m_PlugIndex.retrieve(entry.plug) = entry.plug_next;
+			else
+				m_PlugIndex.remove(entry.plug);
+
+			IndexKey key(entry.adjustediface, entry.vtbl_offs, entry.vtbl_idx);
+			if (entry.key_next)
+				GetEntry(entry.key_next).key_prev = entry.key_prev;
+			if (entry.key_prev)
+				GetEntry(entry.key_prev).key_next = entry.key_next;
+			else if (entry.key_next)
+				*m_KeyIndex.retrieve(key) = entry.key_next;
+			else
+				m_KeyIndex.remove(key);
+		}
+
+		void CHookIDManager::LinkFree(int hookid)
+		{
+			Entry &entry = GetEntry(hookid);
+			entry.plug_prev = 0;
+			entry.plug_next = m_FirstFree;
+			if (m_FirstFree)
+				GetEntry(m_FirstFree).plug_prev = hookid;
+			m_FirstFree = hookid;
+		}
+
+		void CHookIDManager::UnlinkFree(int hookid)
+		{
+			Entry &entry = GetEntry(hookid);
+			if (entry.plug_next)
+				GetEntry(entry.plug_next).plug_prev = entry.plug_prev;
+			if (entry.plug_prev)
+				GetEntry(entry.plug_prev).plug_next = entry.plug_next;
+			else
+				m_FirstFree = entry.plug_next;
+		}
+
+		void CHookIDManager::Free(int hookid)
 		{
+			Unlink(hookid);
+			GetEntry(hookid).isfree = true;
+			GetEntry(hookid).proto = CProtoRef();
+
+			if (hookid != static_cast<int>(m_Entries.size()))
+			{
+				LinkFree(hookid);
+				return;
+			}
+
+			// Freed the last id -> shrink, together with the free ids before it
+			m_Entries.pop_back();
+			while (!m_Entries.empty() && m_Entries.back().isfree)
+			{
+				UnlinkFree(static_cast<int>(m_Entries.size()));
+				m_Entries.pop_back();
+			}
 		}
 
-		int CHookIDManager::New(const CProto &proto, int vtbl_offs, int vtbl_idx, void *vfnptr,
+		int CHookIDManager::New(const CProtoRef &proto, int vtbl_offs, int vtbl_idx, void *vfnptr,
 			void *adjustediface, Plugin plug, int thisptr_offs, ISHDelegate *handler, bool post)
 		{
 			Entry tmp(proto, vtbl_offs, vtbl_idx, vfnptr, adjustediface, plug, thisptr_offs, handler, post);
 
-			size_t cursize = m_Entries.size();
-			for (size_t i = 0; i < cursize; ++i)
+			int hookid;
+			if (m_FirstFree)
 			{
-				if (m_Entries[i].isfree)
-				{
-					m_Entries[i] = tmp;
-					return static_cast<int>(i) + 1;
-				}
+				hookid = m_FirstFree;
+				UnlinkFree(hookid);
+				GetEntry(hookid) = tmp;
+			}
+			else
+			{
+				m_Entries.push_back(tmp);
+				hookid = static_cast<int>(m_Entries.size());		// hookid = id+1
 			}
 
-			m_Entries.push_back(tmp);
-			return static_cast<int>(m_Entries.size());		// return size() because hookid = id+1 anyway
+			Link(hookid);
+			return hookid;
 		}
 
 		bool CHookIDManager::Remove(int hookid)
@@ -44,10 +148,7 @@ namespace SourceHook
 			if (realid < 0 || realid >= static_cast<int>(m_Entries.size()) || m_Entries[realid].isfree)
 				return false;
 
-			m_Entries[realid].isfree = true;
-
-			// :TODO: remove free ids from back sometimes ??
-
+			Free(hookid);
 			return true;
 		}
 
@@ -60,18 +161,25 @@ namespace SourceHook
 			return &m_Entries[realid];
 		}
 
-		void CHookIDManager::FindAllHooks(CVector<int> &output, const CProto &proto, int vtbl_offs,
+		void CHookIDManager::FindAllHooks(CVector<int> &output, const CProtoRef &proto, int vtbl_offs,
 			int vtbl_idx, void *adjustediface, Plugin plug, int thisptr_offs, ISHDelegate *handler, bool post)
 		{
-			// oh my god, a lot of parameters...
-			size_t cursize = m_Entries.size();
-			for (size_t i = 0; i < cursize; ++i)
+			// An invalid proto doesn't match anything, not even another invalid one
+			if (!proto.IsValid())
+				return;
+
+			int *head = m_KeyIndex.retrieve(IndexKey(adjustediface, vtbl_offs, vtbl_idx));
+			if (!head)
+				return;
+
+			// The index already matched adjustediface, vtbl_offs and vtbl_idx
+			for (int hookid = *head; hookid; hookid = GetEntry(hookid).key_next)
 			{
-				if (!m_Entries[i].isfree && m_Entries[i].proto == proto && m_Entries[i].vtbl_offs == vtbl_offs &&
-					m_Entries[i].vtbl_idx == vtbl_idx && m_Entries[i].adjustediface == adjustediface && m_Entries[i].plug == plug &&
-					m_Entries[i].thisptr_offs == thisptr_offs && m_Entries[i].handler->IsEqual(handler) && m_Entries[i].post == post)
+				const Entry &entry = GetEntry(hookid);
+				if (entry.plug == plug && entry.thisptr_offs == thisptr_offs && entry.post == post &&
+					entry.proto == proto && entry.handler->IsEqual(handler))
 				{
-					output.push_back(static_cast<int>(i) + 1);
+					output.push_back(hookid);
 				}
 			}
 		}
@@ -88,24 +196,25 @@ namespace SourceHook
 
 		void CHookIDManager::FindAllHooks(CVector<int> &output, Plugin plug)
 		{
-			size_t cursize = m_Entries.size();
-			for (size_t i = 0; i < cursize; ++i)
-			{
-				if (!m_Entries[i].isfree && m_Entries[i].plug == plug)
-					output.push_back(static_cast<int>(i) + 1);
-			}
-		}
+			int *head = m_PlugIndex.retrieve(plug);
+			if (!head)
+				return;
 
+			for (int hookid = *head; hookid; hookid = GetEntry(hookid).plug_next)
+				output.push_back(hookid);
+		}
 
 		void CHookIDManager::RemoveAll(void *vfnptr)
 		{
-			size_t cursize = m_Entries.size();
-			for (size_t i = 0; i < cursize; ++i)
+			// Walk backwards: Free may shrink m_Entries
+			for (int hookid = static_cast<int>(m_Entries.size()); hookid > 0; --hookid)
 			{
-				if (!m_Entries[i].isfree && m_Entries[i].vfnptr == vfnptr)
-					m_Entries[i].isfree = true;
+				if (hookid <= static_cast<int>(m_Entries.size()) && !GetEntry(hookid).isfree &&
+					GetEntry(hookid).vfnptr == vfnptr)
+				{
+					Free(hookid);
+				}
 			}
 		}
-
 	}
 }
@@ -12,6 +12,7 @@
 #define __SOURCEHOOK_IMPL_CHOOKIDMAN_H__
 
 #include "sh_vector.h"
+#include "sh_tinyhash.h"
 
 namespace SourceHook
 {
@@ -19,6 +20,11 @@ namespace SourceHook
 	{
 		// Associates hook ids with info about the hooks
 		// Also used to keep track of used hook ids
+		//
+		// Free ids are kept in a free list, so New is O(1). Used entries are additionally
+		// chained per plugin and per (adjustediface, vtbl_offs, vtbl_idx), so looking up
+		// the hooks of a plugin or of a hooked function on an instance doesn't have to
+		// walk every entry. All links are hookids, 0 terminates a chain.
 		class CHookIDManager
 		{
 		public:
@@ -26,8 +32,8 @@ namespace SourceHook
 			{
 				bool isfree;
 
-				// hookman info
-				CProto proto;
+				// hookman info; protos are interned, so this is just a reference
+				CProtoRef proto;
 				int vtbl_offs;
 				int vtbl_idx;
 
@@ -43,29 +49,62 @@ namespace SourceHook
 				ISHDelegate *handler;
 				bool post;
 
-				Entry(const CProto &pprt, int pvo, int pvi, void *pvp, void *pai, Plugin pplug, int pto,
+				// chains; a free entry is linked into the free list through plug_prev/plug_next
+				int plug_prev, plug_next;
+				int key_prev, key_next;
+
+				Entry(const CProtoRef &pprt, int pvo, int pvi, void *pvp, void *pai, Plugin pplug, int pto,
 					ISHDelegate *ph, bool ppost)
 					: isfree(false), proto(pprt), vtbl_offs(pvo), vtbl_idx(pvi), vfnptr(pvp), 
-					adjustediface(pai), plug(pplug), thisptr_offs(pto), handler(ph), post(ppost)
+					adjustediface(pai), plug(pplug), thisptr_offs(pto), handler(ph), post(ppost),
+					plug_prev(0), plug_next(0), key_prev(0), key_next(0)
 				{
 				}
 				Entry()
 				{
 				}
 			};
+
+			// Key of the per-function index
+			struct IndexKey
+			{
+				void *adjustediface;
+				int vtbl_offs;
+				int vtbl_idx;
+
+				IndexKey()
+				{
+				}
+				IndexKey(void *pai, int pvo, int pvi) : adjustediface(pai), vtbl_offs(pvo), vtbl_idx(pvi)
+				{
+				}
+			};
 		private:
 			// Internally, hookid 1 is stored as m_Entries[0]
 
 			CVector<Entry> m_Entries;
+			int m_FirstFree;
+			THash<Plugin, int> m_PlugIndex;			// plugin -> first hookid
+			THash<IndexKey, int> m_KeyIndex;		// (adjustediface, vtbl_offs, vtbl_idx) -> first hookid
+
+			Entry &GetEntry(int hookid)
+			{
+				return m_Entries[hookid - 1];
+			}
+			void Link(int hookid);
+			void Unlink(int hookid);
+			void LinkFree(int hookid);
+			void UnlinkFree(int hookid);
+			void Free(int hookid);
 		public:
 			CHookIDManager();
-			int New(const CProto &proto, int vtbl_offs, int vtbl_idx, void *vfnptr, void *adjustediface,
+			int New(const CProtoRef &proto, int vtbl_offs, int vtbl_idx, void *vfnptr, void *adjustediface,
 				Plugin plug, int thisptr_offs, ISHDelegate *handler, bool post);
 			bool Remove(int hookid);
 			const Entry * QueryHook(int hookid);
 
 			// Finds all hooks with the given info, and fills the hookids into output.
-			void FindAllHooks(CVector<int> &output, const CProto &proto, int vtbl_offs, int vtbl_idx,
+			void FindAllHooks(CVector<int> &output, const CProtoRef &proto, int vtbl_offs, int vtbl_idx,
 				void *adjustediface, Plugin plug, int thisptr_offs, ISHDelegate *handler, bool post);
 
 			// Removes all hooks with a specified vfnptr
@@ -75,6 +114,11 @@ namespace SourceHook
 			void FindAllHooks(CVector<int> &output, Plugin plug);
 		};
 	}
+
+	// Key of the CHookIDManager function index (see sourcehook_impl_chookidman.cpp)
+	template<> int HashFunction<Impl::CHookIDManager::IndexKey>(const Impl::CHookIDManager::IndexKey & k);
+	template<> int Compare<Impl::CHookIDManager::IndexKey>(const Impl::CHookIDManager::IndexKey & k1,
+		const Impl::CHookIDManager::IndexKey & k2);
 }
 
 #endif
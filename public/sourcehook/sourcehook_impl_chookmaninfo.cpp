@@ -16,7 +16,8 @@ namespace SourceHook
 	namespace Impl
 	{
 		CHookManager::CHookManager(Plugin ownerPlugin, HookManagerPubFunc pubFunc)
-			: m_OwnerPlugin(ownerPlugin), m_PubFunc(pubFunc), m_Version(-1)
+			: m_OwnerPlugin(ownerPlugin), m_PubFunc(pubFunc), m_VtblOffs(0), m_VtblIdx(0), m_Version(-1),
+			m_HookfuncVfnptr(NULL)
 		{
 			// Query pubfunc
 			//  -> Should call SetInfo and set all the other variables!
@@ -30,11 +31,19 @@ namespace SourceHook
 		void CHookManager::SetInfo(int hookman_version, int vtbloffs, int vtblidx,
 			ProtoInfo *proto, void *hookfunc_vfnptr)
 		{
-			m_Version = hookman_version;
-			m_VtblOffs = vtbloffs;
-			m_VtblIdx = vtblidx;
-			m_Proto = proto;
-			m_HookfuncVfnptr = hookfunc_vfnptr;
+			// Register() and Unregister() query the pub func again, which usually reports the same info.
+			// Hook funcs may be reading it on other threads by then, so only write what changed.
+			if (m_Version != hookman_version)
+				m_Version = hookman_version;
+			if (m_VtblOffs != vtbloffs)
+				m_VtblOffs = vtbloffs;
+			if (m_VtblIdx != vtblidx)
+				m_VtblIdx = vtblidx;
+			CProtoRef newProto(proto);
+			if (m_Proto != newProto)
+				m_Proto = newProto;
+			if (m_HookfuncVfnptr != hookfunc_vfnptr)
+				m_HookfuncVfnptr = hookfunc_vfnptr;
 		}
 
 		void CHookManager::Register()
@@ -47,17 +56,22 @@ namespace SourceHook
 			m_PubFunc(true, NULL);
 		}
 
-		void CHookManager::IncrRef(CVfnPtr *pVfnPtr)
+		void CHookManager::IncrRef(CVfnPtr *pVfnPtr, CEpochManager *pEpochs)
 		{
 			m_VfnPtrs.push_back(pVfnPtr);
+			m_VfnPtrIndex.Insert(pVfnPtr->GetPtr(), pVfnPtr, pEpochs);
 			if (m_VfnPtrs.size() == 1)
 				Register();
 		}
 
-		void CHookManager::DecrRef(CVfnPtr *pVfnPtr)
+		void CHookManager::DecrRef(CVfnPtr *pVfnPtr, CHookManager *pSuccessor)
 		{
 			m_VfnPtrs.remove(pVfnPtr);
-			if (m_VfnPtrs.empty())
+			m_VfnPtrIndex.Remove(pVfnPtr->GetPtr());
+
+			// Hook managers of different plugins can share the pub func. The successor has
+			// registered itself in it already; unregistering would take that back.
+			if (m_VfnPtrs.empty() && (pSuccessor == NULL || pSuccessor->m_PubFunc != m_PubFunc))
 				Unregister();
 		}
 
@@ -11,7 +11,9 @@
 #ifndef __SOURCEHOOK_IMPL_CHOOKMANINFO_H__
 #define __SOURCEHOOK_IMPL_CHOOKMANINFO_H__
 
-#include "sh_list.h"
+#include "sh_slaballoc.h"
+#include "sh_tinyhash.h"
+#include "sourcehook_impl_cptrmap.h"
 #include "sourcehook_impl_cproto.h"
 
 namespace SourceHook
@@ -27,12 +29,16 @@ namespace SourceHook
 			HookManagerPubFunc m_PubFunc;
 			int m_VtblOffs;
 			int m_VtblIdx;
-			CProto m_Proto;
+			CProtoRef m_Proto;
 			int m_Version;
 
 			void *m_HookfuncVfnptr;
 
-			List<CVfnPtr*> m_VfnPtrs;
+			PooledList<CVfnPtr*> m_VfnPtrs;
+
+			// The hook function has to find its CVfnPtr on every call, on any thread; a hook
+			// manager can be shared by many vtables, so don't walk m_VfnPtrs for that.
+			CPtrMap<CVfnPtr> m_VfnPtrIndex;
 		public:
 			// *** Descriptor ***
 			struct Descriptor
@@ -55,7 +61,7 @@ namespace SourceHook
 			inline Plugin GetOwnerPlugin()  const;
 			inline int GetVtblOffs()  const;
 			inline int GetVtblIdx()  const;
-			inline const CProto &GetProto()  const;
+			inline const CProtoRef &GetProto()  const;
 			inline int GetVersion()  const;
 			inline void *GetHookFunc() const;
 			inline HookManagerPubFunc GetPubFunc() const;
@@ -63,20 +69,23 @@ namespace SourceHook
 			void Register();
 			void Unregister();
 
-			void IncrRef(CVfnPtr *pVfnPtr);
-			void DecrRef(CVfnPtr *pVfnPtr);
+			void IncrRef(CVfnPtr *pVfnPtr, CEpochManager *pEpochs);
+			// pSuccessor is the hook manager which has taken over pVfnPtr from us, if any
+			void DecrRef(CVfnPtr *pVfnPtr, CHookManager *pSuccessor = NULL);
 
-			List<CVfnPtr*> &GetVfnPtrList()
+			PooledList<CVfnPtr*> &GetVfnPtrList()
 			{
 				return m_VfnPtrs;
 			}
 
+			inline CVfnPtr *FindVfnPtr(void *vfnptr);
+
 			// *** IHookManagerInfo interface ***
 			void SetInfo(int hookman_version, int vtbloffs, int vtblidx,
 				ProtoInfo *proto, void *hookfunc_vfnptr);
 		};
 
-		class CHookManList : public List<CHookManager>
+		class CHookManList : public PooledList<CHookManager>
 		{
 		public:
 			CHookManager *GetHookMan(Plugin plug, HookManagerPubFunc pubFunc);
@@ -117,7 +126,7 @@ namespace SourceHook
 			return m_VtblIdx;
 		}
 
-		inline const CProto &CHookManager::GetProto() const
+		inline const CProtoRef &CHookManager::GetProto() const
 		{
 			return m_Proto;
 		}
@@ -136,6 +145,11 @@ namespace SourceHook
 		{
 			return m_PubFunc;
 		}
+
+		inline CVfnPtr *CHookManager::FindVfnPtr(void *vfnptr)
+		{
+			return m_VfnPtrIndex.Find(vfnptr);
+		}
 	}
 }
 
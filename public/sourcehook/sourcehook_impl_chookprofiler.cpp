@@ -0,0 +1,169 @@
+/* ======== SourceHook ========
+* Copyright (C) 2004-2010 Metamod:Source Development Team
+* No warranties of any kind
+*
+* License: zlib/libpng
+*
+* Author(s): Pavol "PM OnoTo" Marko
+* ============================
+*/
+
+#include <string.h>
+#include "sourcehook_impl.h"
+
+#if SH_XP == SH_XP_WINAPI
+#	include <windows.h>
+#else
+#	include <time.h>
+#endif
+
+namespace SourceHook
+{
+	namespace Impl
+	{
+		CHookProfiler::CHookProfiler() : m_Running(false), m_StartTime(0), m_StopTime(0)
+		{
+		}
+
+		CHookProfiler::Timestamp CHookProfiler::Now()
+		{
+#if SH_XP == SH_XP_WINAPI
+			static LARGE_INTEGER freq;
+			if (freq.QuadPart == 0)
+				QueryPerformanceFrequency(&freq);
+
+			LARGE_INTEGER now;
+			QueryPerformanceCounter(&now);
+
+			// Split up so the multiplication doesn't overflow
+			Timestamp secs = now.QuadPart / freq.QuadPart;
+			Timestamp rest = now.QuadPart % freq.QuadPart;
+			return secs * 1000000000ULL + rest * 1000000000ULL / freq.QuadPart;
+#else
+			timespec ts;
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			return static_cast<Timestamp>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+#endif
+		}
+
+		void CHookProfiler::Start()
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			m_Stats.clear();
+			m_Index.clear();
+			m_StartTime = Now();
+			m_Running = true;
+		}
+
+		void CHookProfiler::Stop()
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			if (!m_Running)
+				return;
+
+			m_StopTime = Now();
+			m_Running = false;
+		}
+
+		bool CHookProfiler::IsRunning() const
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			return m_Running;
+		}
+
+		CHookProfiler::Timestamp CHookProfiler::GetDuration() const
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			return (m_Running ? Now() : m_StopTime) - m_StartTime;
+		}
+
+		void CHookProfiler::Record(int hookid, HookSerial serial, Plugin plug, int vtbl_idx, bool post,
+			Timestamp time)
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+
+			// Hook loops which were running when we got stopped still report in
+			if (!m_Running)
+				return;
+
+			size_t *pIndex = m_Index.retrieve(hookid);
+			if (pIndex == NULL || m_Stats[*pIndex].serial != serial)
+			{
+				// First call of this hook
+				Stats stats;
+				memset(&stats, 0, sizeof(stats));
+				stats.hookid = hookid;
+				stats.serial = serial;
+				stats.plug = plug;
+				stats.vtbl_idx = vtbl_idx;
+				stats.post = post;
+
+				m_Stats.push_back(stats);
+				m_Index[hookid] = m_Stats.size() - 1;
+				pIndex = m_Index.retrieve(hookid);
+			}
+
+			Stats &stats = m_Stats[*pIndex];
+			++stats.calls;
+			stats.totalTime += time;
+			if (time > stats.maxTime)
+				stats.maxTime = time;
+
+			int bucket = 0;
+			while (bucket < NUM_BUCKETS - 1 && (time >> (bucket + 1)) != 0)
+				++bucket;
+			++stats.buckets[bucket];
+		}
+
+		void CHookProfiler::GetTopHooks(CVector<Stats> &output, size_t maxCount, bool filterPlug,
+			Plugin plug) const
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			output.clear();
+
+			// Insertion into a list sorted by total time, capped at maxCount
+			for (size_t i = 0; i < m_Stats.size(); ++i)
+			{
+				const Stats &stats = m_Stats[i];
+				if (filterPlug && stats.plug != plug)
+					continue;
+
+				size_t pos = output.size();
+				while (pos > 0 && output[pos - 1].totalTime < stats.totalTime)
+					--pos;
+
+				if (pos >= maxCount)
+					continue;
+
+				if (output.size() < maxCount)
+					output.push_back(stats);
+				for (size_t j = output.size() - 1; j > pos; --j)
+					output[j] = output[j - 1];
+				output[pos] = stats;
+			}
+		}
+
+		CHookProfiler::Timestamp CHookProfiler::GetPercentile(const Stats &stats, unsigned int percent)
+		{
+			if (stats.calls == 0)
+				return 0;
+
+			// Number of calls which have to be at or below the result
+			unsigned long long needed = (stats.calls * percent + 99) / 100;
+			if (needed == 0)
+				needed = 1;
+
+			unsigned long long seen = 0;
+			for (int bucket = 0; bucket < NUM_BUCKETS - 1; ++bucket)
+			{
+				seen += stats.buckets[bucket];
+				if (seen >= needed)
+				{
+					Timestamp upper = static_cast<Timestamp>(1) << (bucket + 1);
+					return upper < stats.maxTime ? upper : stats.maxTime;
+				}
+			}
+			return stats.maxTime;
+		}
+	}
+}
@@ -0,0 +1,77 @@
+/* ======== SourceHook ========
+* Copyright (C) 2004-2010 Metamod:Source Development Team
+* No warranties of any kind
+*
+* License: zlib/libpng
+*
+* Author(s): Pavol "PM OnoTo" Marko
+* ============================
+*/
+
+#ifndef __SOURCEHOOK_IMPL_CHOOKPROFILER_H__
+#define __SOURCEHOOK_IMPL_CHOOKPROFILER_H__
+
+#include <mutex>
+
+namespace SourceHook
+{
+	namespace Impl
+	{
+		// Collects per-hook call counts and handler times while it is running.
+		// The hook loop measures from handing out a handler (CHookContext::GetNext) until
+		// it asks for the next one, so the time of nested hook loops is included.
+		// Hook loops on any thread may report in; the stats are guarded by a lock.
+		class CHookProfiler
+		{
+		public:
+			typedef unsigned long long Timestamp;		// in nanoseconds
+
+			// Bucket i counts calls which took [2^i, 2^(i+1)) ns; the last one is open-ended
+			static const int NUM_BUCKETS = 32;
+
+			struct Stats
+			{
+				int hookid;
+				HookSerial serial;			// tells apart hooks which got the same (recycled) id
+				Plugin plug;
+				int vtbl_idx;
+				bool post;
+
+				unsigned long long calls;
+				Timestamp totalTime;
+				Timestamp maxTime;
+				unsigned int buckets[NUM_BUCKETS];
+			};
+		private:
+			mutable std::mutex m_Lock;
+			bool m_Running;
+			Timestamp m_StartTime;
+			Timestamp m_StopTime;
+
+			CVector<Stats> m_Stats;
+			THash<int, size_t> m_Index;			// hookid -> index of its latest Stats
+		public:
+			CHookProfiler();
+
+			static Timestamp Now();
+
+			// Start() throws away the stats of the last session
+			void Start();
+			void Stop();
+			bool IsRunning() const;
+
+			// Time the session has been / was running
+			Timestamp GetDuration() const;
+
+			void Record(int hookid, HookSerial serial, Plugin plug, int vtbl_idx, bool post, Timestamp time);
+
+			// Copies out the stats with the highest total time, optionally only of one plugin
+			void GetTopHooks(CVector<Stats> &output, size_t maxCount, bool filterPlug, Plugin plug) const;
+
+			// Approximate percentile (0-100) from the histogram: the upper bound of its bucket
+			static Timestamp GetPercentile(const Stats &stats, unsigned int percent);
+		};
+	}
+}
+
+#endif
@@ -11,53 +11,139 @@
 #ifndef __SOURCEHOOK_IMPL_CIFACE_H__
 #define __SOURCEHOOK_IMPL_CIFACE_H__
 
-#include "sh_list.h"
+#include <atomic>
+#include "sh_slaballoc.h"
+#include "sh_vector.h"
+#include "sourcehook_impl_cepochman.h"
 
 namespace SourceHook
 {
 	namespace Impl
 	{
+		// The active (= not paused) hooks of a hook list, compiled into a contiguous array.
+		// This is what the hook loop walks; the PooledList<CHook> stays the authoritative copy.
+		// Arrays are immutable once created: adding, removing, pausing or unpausing a hook
+		// publishes a new array and retires the old one, so hook loops on other threads
+		// can keep walking it.
+		class CHookArray
+		{
+		public:
+			struct Entry
+			{
+				ISHDelegate *m_pHandler;
+				int m_ThisPointerOffset;
+				int m_HookID;
+				Plugin m_OwnerPlugin;
+				HookSerial m_Serial;
+				const CHookFilter *m_pFilter;		// NULL = call for every call
+			};
+		private:
+			// Unique across all arrays, so a hook loop can tell whether its position is still valid
+			HookSerial m_Version;
+			size_t m_Count;
+			static std::atomic<HookSerial> ms_LastVersion;
+
+			inline CHookArray(HookSerial version, size_t count);
+			inline Entry *GetEntries();
+		public:
+			// Shared by all hook lists without active hooks
+			static const CHookArray ms_Empty;
+
+			static CHookArray *Create(const PooledList<CHook> &hooks);
+			static void Free(void *array);
+
+			inline size_t size() const;
+			inline const Entry &operator[](size_t pos) const;
+			inline const Entry *GetEntries() const;
+			inline HookSerial GetVersion() const;
+			inline size_t UpperBound(HookSerial serial) const;
+		};
+
 		class CIface
 		{
 			// *** Data ***
 			void *m_Ptr;
+			CEpochManager *m_pEpochs;
+
+			PooledList<CHook> m_PreHooks;
+			PooledList<CHook> m_PostHooks;
+
+			std::atomic<const CHookArray *> m_pPreHookArray;
+			std::atomic<const CHookArray *> m_pPostHookArray;
 
-			List<CHook> m_PreHooks;
-			List<CHook> m_PostHooks;
+			void PublishArray(std::atomic<const CHookArray *> &array, const PooledList<CHook> &hooks);
+
+			CIface(const CIface &other);
+			CIface &operator =(const CIface &other);
 		public:
 
 			// *** Descriptor ***
 			typedef void* Descriptor;
 
 			// *** Interface ***
-			inline CIface(void *ptr);
-			inline ~CIface();
+			CIface(void *ptr, CEpochManager *pEpochs);
+			~CIface();
 			inline bool operator==(const Descriptor &other);
 			inline void *GetPtr() const;
-			inline List<CHook> &GetPreHookList();
-			inline List<CHook> &GetPostHookList();
-			inline const List<CHook> &GetPreHookList() const;
-			inline const List<CHook> &GetPostHookList() const;
+			inline PooledList<CHook> &GetPreHookList();
+			inline PooledList<CHook> &GetPostHookList();
+			inline const PooledList<CHook> &GetPreHookList() const;
+			inline const PooledList<CHook> &GetPostHookList() const;
+
+			inline void AddHook(const CHook &hook, bool post);
+			inline void EraseHook(PooledList<CHook>::iterator iter, bool post);
+			void HookListChanged(bool post);
+
+			// Readers have to be inside of the epoch manager while using the result
+			inline const CHookArray &GetPreHookArray() const;
+			inline const CHookArray &GetPostHookArray() const;
 		};
 
 		// *** Implementation ***
-		inline CIface::CIface(void *ptr)
-			: m_Ptr(ptr)
+		inline CHookArray::CHookArray(HookSerial version, size_t count) : m_Version(version), m_Count(count)
 		{
 		}
 
-		inline CIface::~CIface()
+		inline CHookArray::Entry *CHookArray::GetEntries()
 		{
-			// Before getting deleted, delete all remaining hook handlers
-			for (List<CHook>::iterator iter = m_PreHooks.begin(); iter != m_PreHooks.end(); ++iter)
-			{
-				iter->GetHandler()->DeleteThis();
-			}
+			return reinterpret_cast<Entry*>(this + 1);
+		}
+
+		inline size_t CHookArray::size() const
+		{
+			return m_Count;
+		}
+
+		inline const CHookArray::Entry &CHookArray::operator[](size_t pos) const
+		{
+			return GetEntries()[pos];
+		}
 
-			for (List<CHook>::iterator iter = m_PostHooks.begin(); iter != m_PostHooks.end(); ++iter)
+		inline const CHookArray::Entry *CHookArray::GetEntries() const
+		{
+			return reinterpret_cast<const Entry*>(this + 1);
+		}
+
+		inline HookSerial CHookArray::GetVersion() const
+		{
+			return m_Version;
+		}
+
+		// Returns the position of the first entry whose serial is greater than the given one
+		inline size_t CHookArray::UpperBound(HookSerial serial) const
+		{
+			const Entry *entries = GetEntries();
+			size_t lo = 0;
+			size_t hi = m_Count;
+			while (lo < hi)
 			{
-				iter->GetHandler()->DeleteThis();
+				size_t mid = lo + (hi - lo) / 2;
+				if (entries[mid].m_Serial <= serial)
+					lo = mid + 1;
+				else
+					hi = mid;
 			}
+			return lo;
 		}
 
 		inline bool CIface::operator==(const Descriptor &other)
@@ -70,25 +156,53 @@ namespace SourceHook
 			return m_Ptr;
 		}
 
-		inline List<CHook> &CIface::GetPreHookList()
+		inline PooledList<CHook> &CIface::GetPreHookList()
 		{
 			return m_PreHooks;
 		}
 
-		inline List<CHook> &CIface::GetPostHookList()
+		inline PooledList<CHook> &CIface::GetPostHookList()
 		{
 			return m_PostHooks;
 		}
 
-		inline const List<CHook> &CIface::GetPreHookList() const
+		inline const PooledList<CHook> &CIface::GetPreHookList() const
 		{
 			return m_PreHooks;
 		}
 
-		inline const List<CHook> &CIface::GetPostHookList() const
+		inline const PooledList<CHook> &CIface::GetPostHookList() const
 		{
 			return m_PostHooks;
 		}
+
+		inline void CIface::AddHook(const CHook &hook, bool post)
+		{
+			if (post)
+				m_PostHooks.push_back(hook);
+			else
+				m_PreHooks.push_back(hook);
+			HookListChanged(post);
+		}
+
+		inline void CIface::EraseHook(PooledList<CHook>::iterator iter, bool post)
+		{
+			if (post)
+				m_PostHooks.erase(iter);
+			else
+				m_PreHooks.erase(iter);
+			HookListChanged(post);
+		}
+
+		inline const CHookArray &CIface::GetPreHookArray() const
+		{
+			return *m_pPreHookArray.load(std::memory_order_acquire);
+		}
+
+		inline const CHookArray &CIface::GetPostHookArray() const
+		{
+			return *m_pPostHookArray.load(std::memory_order_acquire);
+		}
 	}
 }
 
@@ -0,0 +1,320 @@
+/* ======== SourceHook ========
+* Copyright (C) 2004-2010 Metamod:Source Development Team
+* No warranties of any kind
+*
+* License: zlib/libpng
+*
+* Author(s): Pavol "PM OnoTo" Marko
+* ============================
+*/
+
+#include "sourcehook_impl.h"
+
+#if SH_SYS == SH_SYS_LINUX
+#	include <errno.h>
+#	include <link.h>
+#	include <stddef.h>
+#	include <stdlib.h>
+#endif
+
+namespace SourceHook
+{
+	namespace Impl
+	{
+#if SH_SYS == SH_SYS_LINUX
+		static int CountersCallback(struct dl_phdr_info *info, size_t size, void *data)
+		{
+			unsigned long long *counters = reinterpret_cast<unsigned long long*>(data);
+			if (size >= offsetof(struct dl_phdr_info, dlpi_subs) + sizeof(info->dlpi_subs))
+			{
+				counters[0] = info->dlpi_adds;
+				counters[1] = info->dlpi_subs;
+			}
+
+			// The counters are the same for every object
+			return 1;
+		}
+#endif
+
+		CPageMap::CPageMap() : m_Valid(false)
+		{
+			m_Counters.adds = 0;
+			m_Counters.subs = 0;
+		}
+
+		CPageMap &CPageMap::Get()
+		{
+			static CPageMap s_PageMap;
+			return s_PageMap;
+		}
+
+		// Returns false if the loader doesn't keep count
+		bool CPageMap::GetLoadCounters(LoadCounters &counters)
+		{
+			counters.adds = 0;
+			counters.subs = 0;
+#if SH_SYS == SH_SYS_LINUX
+			unsigned long long values[2] = { 0, 0 };
+			dl_iterate_phdr(&CountersCallback, values);
+			counters.adds = values[0];
+			counters.subs = values[1];
+#endif
+			return counters.adds != 0;
+		}
+
+		bool CPageMap::Read()
+		{
+#if SH_SYS == SH_SYS_LINUX
+			FILE *pF = fopen("/proc/self/maps", "r");
+			if (!pF)
+				return false;
+
+			size_t size = 0;
+			size_t capacity = 64 * 1024;
+			char *buf = reinterpret_cast<char*>(malloc(capacity));
+			size_t got;
+			while (buf && (got = fread(buf + size, 1, capacity - size - 1, pF)) > 0)
+			{
+				size += got;
+				if (size + 1 == capacity)
+				{
+					capacity *= 2;
+					char *newBuf = reinterpret_cast<char*>(realloc(buf, capacity));
+					if (!newBuf)
+						free(buf);
+					buf = newBuf;
+				}
+			}
+			fclose(pF);
+
+			if (!buf)
+				return false;
+			buf[size] = 0;
+
+			// Format:
+			// lower    upper    prot     stuff                 path
+			// 08048000-0804c000 r-xp 00000000 03:03 1010107    /bin/cat
+			// The kernel lists the mappings in ascending order.
+			m_Regions.clear();
+			char *cur = buf;
+			while (*cur)
+			{
+				char *end;
+				Region region;
+				region.lower = strtoul(cur, &end, 16);
+				if (*end == '-')
+				{
+					region.upper = strtoul(end + 1, &end, 16);
+					if (end[0] == ' ' && end[1] && end[2] && end[3])
+					{
+						region.bits = 0;
+						if (end[1] == 'r')
+							region.bits |= SH_MEM_READ;
+						if (end[2] == 'w')
+							region.bits |= SH_MEM_WRITE;
+						if (end[3] == 'x')
+							region.bits |= SH_MEM_EXEC;
+						m_Regions.push_back(region);
+					}
+				}
+
+				// Next line
+				while (*cur && *cur != '\n')
+					++cur;
+				if (*cur)
+					++cur;
+			}
+
+			free(buf);
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		// Index of the region containing addr, or -1
+		int CPageMap::Find(uintptr_t addr) const
+		{
+			size_t lower = 0;
+			size_t upper = m_Regions.size();
+			while (lower < upper)
+			{
+				size_t mid = lower + (upper - lower) / 2;
+				if (addr < m_Regions[mid].lower)
+					upper = mid;
+				else if (addr >= m_Regions[mid].upper)
+					lower = mid + 1;
+				else
+					return static_cast<int>(mid);
+			}
+			return -1;
+		}
+
+		// counters have to be taken before the map is read: whatever gets loaded while
+		// we read is noticed next time then
+		bool CPageMap::Refresh(const LoadCounters &counters)
+		{
+			m_Counters = counters;
+			m_Valid = Read();
+			return m_Valid;
+		}
+
+		CPageMap::Result CPageMap::Lookup(void *addr, size_t len, Region &region)
+		{
+#if SH_SYS == SH_SYS_LINUX
+			// Not under our lock: dl_iterate_phdr takes the loader's lock, and code running
+			// in dlopen may want ours
+			LoadCounters counters;
+			bool counted = GetLoadCounters(counters);
+
+			std::lock_guard<std::mutex> lock(m_Lock);
+
+			bool fresh = false;
+			if (!m_Valid || !counted || counters.adds != m_Counters.adds || counters.subs != m_Counters.subs)
+			{
+				if (!Refresh(counters))
+					return Result_NoMap;
+				fresh = true;
+			}
+
+			uintptr_t laddr = reinterpret_cast<uintptr_t>(addr);
+			int index = Find(laddr);
+
+			// Memory can be unmapped without the loader knowing: a cached hit only counts
+			// if the kernel still has the pages
+			if (index >= 0 && !fresh && msync(SH_LALIGN(addr), len + SH_LALDIF(addr), MS_ASYNC) != 0 &&
+				errno == ENOMEM)
+			{
+				index = -1;
+			}
+
+			if (index < 0 && !fresh)
+			{
+				if (!Refresh(counters))
+					return Result_NoMap;
+				index = Find(laddr);
+			}
+
+			if (index < 0)
+				return Result_NotMapped;
+
+			region = m_Regions[index];
+			return Result_Found;
+#else
+			return Result_NoMap;
+#endif
+		}
+
+		void CPageMap::UpdateBits(void *addr, size_t len, int bits)
+		{
+#if SH_SYS == SH_SYS_LINUX
+			std::lock_guard<std::mutex> lock(m_Lock);
+			if (!m_Valid)
+				return;
+
+			// mprotect works on whole pages
+			uintptr_t lower = reinterpret_cast<uintptr_t>(SH_LALIGN(addr));
+			uintptr_t upper = reinterpret_cast<uintptr_t>(addr) + len;
+			upper = (upper + PAGESIZE - 1) & ~static_cast<uintptr_t>(PAGESIZE - 1);
+
+			int index = Find(lower);
+			if (index < 0 || upper > m_Regions[index].upper)
+			{
+				// Spans several mappings; not worth splitting them all up
+				m_Valid = false;
+				return;
+			}
+
+			Region region = m_Regions[index];
+			if (region.bits == bits)
+				return;
+
+			// The kernel splits the mapping into up to three parts
+			Region part;
+			part.lower = lower;
+			part.upper = upper;
+			part.bits = bits;
+			m_Regions[index] = part;
+
+			if (region.lower < lower)
+			{
+				part.lower = region.lower;
+				part.upper = lower;
+				part.bits = region.bits;
+				m_Regions.insert(m_Regions.iterAt(index), part);
+				++index;
+			}
+			if (upper < region.upper)
+			{
+				part.lower = upper;
+				part.upper = region.upper;
+				part.bits = region.bits;
+				m_Regions.insert(m_Regions.iterAt(index + 1), part);
+			}
+#endif
+		}
+
+		void CPageMap::Invalidate()
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			m_Valid = false;
+		}
+
+		bool CPageMap::GetPageBits(void *addr, int *bits)
+		{
+			Region region;
+			switch (Get().Lookup(addr, 1, region))
+			{
+			case Result_Found:
+				*bits = region.bits;
+				return true;
+			case Result_NotMapped:
+				return false;
+			default:
+				return SourceHook::GetPageBits(addr, bits);
+			}
+		}
+
+		bool CPageMap::SetMemAccess(void *addr, size_t len, int access)
+		{
+			bool result = SourceHook::SetMemAccess(addr, len, access);
+#if SH_SYS == SH_SYS_LINUX
+			if (result)
+				Get().UpdateBits(addr, len, access);
+			else
+				Get().Invalidate();
+#endif
+			return result;
+		}
+
+		bool CPageMap::MakePageWritable(void *addr)
+		{
+			int bits;
+			if (GetPageBits(addr, &bits))
+			{
+				if (bits & SH_MEM_WRITE)
+					return true;
+				bits |= SH_MEM_WRITE;
+			}
+			else
+			{
+				bits = SH_MEM_READ | SH_MEM_WRITE | SH_MEM_EXEC;
+			}
+			return SetMemAccess(addr, sizeof(void *), bits);
+		}
+
+		bool CPageMap::ModuleInMemory(char *addr, size_t len)
+		{
+			Region region;
+			switch (Get().Lookup(addr, len, region))
+			{
+			case Result_Found:
+				return reinterpret_cast<uintptr_t>(addr) + len <= region.upper;
+			case Result_NotMapped:
+				return false;
+			default:
+				return SourceHook::ModuleInMemory(addr, len);
+			}
+		}
+	}
+}
@@ -0,0 +1,88 @@
+/* ======== SourceHook ========
+* Copyright (C) 2004-2010 Metamod:Source Development Team
+* No warranties of any kind
+*
+* License: zlib/libpng
+*
+* Author(s): Pavol "PM OnoTo" Marko
+* ============================
+*/
+
+#ifndef __SOURCEHOOK_IMPL_CPAGEMAP_H__
+#define __SOURCEHOOK_IMPL_CPAGEMAP_H__
+
+#include <mutex>
+
+namespace SourceHook
+{
+	namespace Impl
+	{
+		// Cached copy of the process's memory map (/proc/self/maps), for the page queries
+		// SourceHook makes whenever it patches or reverts a vtable entry.
+		//
+		// The kernel formats a line per mapping whenever /proc/self/maps is read, and a server
+		// has thousands of them, so every query used to cost a full read and parse. The regions
+		// are kept sorted, and a query is a binary search. The map is read again when:
+		//   - a shared object has been loaded or unloaded since the last read,
+		//   - the queried address isn't in any cached region (it may have been mapped since),
+		//   - the cached region isn't mapped anymore (checked with msync on every hit).
+		// SetMemAccess updates the cached protection itself. Protection changes made by others
+		// aren't seen until the map is read again.
+		//
+		// Other platforms ask the OS every time; the functions just forward to sh_memory.h there.
+		class CPageMap
+		{
+		public:
+			struct Region
+			{
+				uintptr_t lower;
+				uintptr_t upper;
+				int bits;
+			};
+
+			enum Result
+			{
+				Result_Found,
+				Result_NotMapped,
+				Result_NoMap			// /proc/self/maps can't be read
+			};
+		private:
+			struct LoadCounters
+			{
+				unsigned long long adds;
+				unsigned long long subs;
+			};
+
+			std::mutex m_Lock;
+			CVector<Region> m_Regions;
+			bool m_Valid;
+			LoadCounters m_Counters;		// of the last read
+
+			static bool GetLoadCounters(LoadCounters &counters);
+			bool Read();
+			int Find(uintptr_t addr) const;
+			bool Refresh(const LoadCounters &counters);
+		public:
+			CPageMap();
+
+			// The one map of this binary
+			static CPageMap &Get();
+
+			// Finds the region containing [addr, addr+len)'s first byte
+			Result Lookup(void *addr, size_t len, Region &region);
+
+			// Called after [addr, addr+len) has been mprotect'ed to bits
+			void UpdateBits(void *addr, size_t len, int bits);
+
+			void Invalidate();
+
+			// Like the sh_memory.h functions of the same names, through the map
+			static bool GetPageBits(void *addr, int *bits);
+			static bool SetMemAccess(void *addr, size_t len, int access);
+			static bool MakePageWritable(void *addr);
+			static bool ModuleInMemory(char *addr, size_t len);
+		};
+	}
+}
+
+#endif
@@ -140,6 +140,161 @@ namespace SourceHook
 
 			return true;
 		}
-		
+
+		bool CProto::IsIdentical(const CProto &other) const
+		{
+			if (m_Version < 0 || other.m_Version < 0)
+				return false;
+
+			if (!ExactlyEqual(other))
+				return false;
+
+			if (GetRet().pCopyCtor != other.GetRet().pCopyCtor)
+				return false;
+
+			for (int i = 0; i < m_NumOfParams; ++i)
+			{
+				if (GetParam(i).pCopyCtor != other.GetParam(i).pCopyCtor)
+					return false;
+			}
+
+			return true;
+		}
+
+		static unsigned int HashPassInfo(unsigned int hash, const IntPassInfo &info)
+		{
+			hash = hash * 31 + static_cast<unsigned int>(info.size);
+			hash = hash * 31 + static_cast<unsigned int>(info.type);
+			hash = hash * 31 + info.flags;
+			hash = hash * 31 + static_cast<unsigned int>(reinterpret_cast<uintptr_t>(info.pCopyCtor) >> 4);
+			return hash;
+		}
+
+		unsigned int CProto::Hash() const
+		{
+			if (m_Version < 0)
+				return 0;
+
+			unsigned int hash = static_cast<unsigned int>(m_Version);
+			hash = hash * 31 + static_cast<unsigned int>(m_Convention);
+			hash = hash * 31 + static_cast<unsigned int>(m_NumOfParams);
+			hash = HashPassInfo(hash, GetRet());
+			for (int i = 0; i < m_NumOfParams; ++i)
+				hash = HashPassInfo(hash, GetParam(i));
+			return hash;
+		}
+
+		// The table is shared by all SourceHook instances in this binary, which may live on different
+		// threads. It is never destroyed: refs may be released from static destructors.
+		struct CProtoRef::Table
+		{
+			std::mutex lock;
+			CVector<Node*> buckets;			// chained through Node::next; size is a power of 2
+			size_t count;
+
+			Table() : count(0)
+			{
+				buckets.resize(64, NULL);
+			}
+
+			Node *&GetBucket(unsigned int hash)
+			{
+				return buckets[hash & (buckets.size() - 1)];
+			}
+
+			void Grow()
+			{
+				CVector<Node*> oldBuckets(buckets);
+				buckets.clear();
+				buckets.resize(oldBuckets.size() * 2, NULL);
+
+				for (size_t i = 0; i < oldBuckets.size(); ++i)
+				{
+					Node *pNode = oldBuckets[i];
+					while (pNode)
+					{
+						Node *pNext = pNode->next;
+						Node *&head = GetBucket(pNode->hash);
+						pNode->next = head;
+						head = pNode;
+						pNode = pNext;
+					}
+				}
+			}
+		};
+
+		CProtoRef::Table &CProtoRef::GetTable()
+		{
+			static Table *s_pTable = new Table;
+			return *s_pTable;
+		}
+
+		CProtoRef::Node *CProtoRef::Intern(const CProto &proto)
+		{
+			if (proto.GetVersion() < 0)
+				return NULL;
+
+			Table &table = GetTable();
+			unsigned int hash = proto.Hash();
+
+			std::lock_guard<std::mutex> lock(table.lock);
+
+			Node *&head = table.GetBucket(hash);
+			for (Node *pNode = head; pNode; pNode = pNode->next)
+			{
+				if (pNode->hash != hash || !pNode->proto.IsIdentical(proto))
+					continue;
+
+				// A node whose count has dropped to 0 is being released; don't revive it
+				int refCount = pNode->refCount.load(std::memory_order_relaxed);
+				while (refCount > 0)
+				{
+					if (pNode->refCount.compare_exchange_weak(refCount, refCount + 1, std::memory_order_relaxed))
+						return pNode;
+				}
+			}
+
+			Node *pNode = new Node(proto, hash);
+			pNode->next = head;
+			head = pNode;
+
+			if (++table.count > table.buckets.size())
+				table.Grow();
+
+			return pNode;
+		}
+
+		void CProtoRef::Release(Node *pNode)
+		{
+			if (pNode->refCount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+				return;
+
+			// Nobody can get it back now (see Intern); we own it
+			Table &table = GetTable();
+			{
+				std::lock_guard<std::mutex> lock(table.lock);
+
+				Node **ppCur = &table.GetBucket(pNode->hash);
+				while (*ppCur != pNode)
+					ppCur = &(*ppCur)->next;
+				*ppCur = pNode->next;
+				--table.count;
+			}
+
+			delete pNode;
+		}
+
+		const CProto &CProtoRef::operator *() const
+		{
+			static const CProto s_Invalid;
+			return m_pNode ? m_pNode->proto : s_Invalid;
+		}
+
+		size_t CProtoRef::GetNumInterned()
+		{
+			Table &table = GetTable();
+			std::lock_guard<std::mutex> lock(table.lock);
+			return table.count;
+		}
 	}
 }
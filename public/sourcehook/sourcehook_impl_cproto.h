@@ -11,6 +11,8 @@
 #ifndef __SOURCEHOOK_IMPL_CPROTO_H__
 #define __SOURCEHOOK_IMPL_CPROTO_H__
 
+#include <atomic>
+
 namespace SourceHook
 {
 	namespace Impl
@@ -133,6 +135,106 @@ namespace SourceHook
 
 				return info.size;
 			}
+
+			// Unlike ExactlyEqual, also compares the copy constructors. Invalid protos aren't
+			// identical to anything.
+			bool IsIdentical(const CProto &other) const;
+			unsigned int Hash() const;
+		};
+
+		// Reference to an interned, immutable proto.
+		//
+		// Every hook entry and hook manager used to carry its own CProto copy (with a heap
+		// allocated parameter vector). Now each distinct signature exists once in a global
+		// table, and two refs are equal iff they refer to identical protos. The table entry
+		// goes away when its last ref does.
+		// Invalid protos aren't interned: their refs are empty, so check IsValid before
+		// treating equal refs as matching signatures.
+		class CProtoRef
+		{
+			struct Node
+			{
+				CProto proto;
+				unsigned int hash;
+				std::atomic<int> refCount;
+				Node *next;
+
+				Node(const CProto &pproto, unsigned int phash) : proto(pproto), hash(phash), refCount(1),
+					next(NULL)
+				{
+				}
+			};
+			struct Table;
+
+			Node *m_pNode;
+
+			static Table &GetTable();
+			static Node *Intern(const CProto &proto);
+			static void Release(Node *pNode);
+		public:
+			CProtoRef() : m_pNode(NULL)
+			{
+			}
+
+			explicit CProtoRef(const CProto &proto) : m_pNode(Intern(proto))
+			{
+			}
+
+			explicit CProtoRef(const ProtoInfo *pProto) : m_pNode(Intern(CProto(pProto)))
+			{
+			}
+
+			CProtoRef(const CProtoRef &other) : m_pNode(other.m_pNode)
+			{
+				if (m_pNode)
+					m_pNode->refCount.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			~CProtoRef()
+			{
+				if (m_pNode)
+					Release(m_pNode);
+			}
+
+			CProtoRef &operator =(const CProtoRef &other)
+			{
+				if (other.m_pNode)
+					other.m_pNode->refCount.fetch_add(1, std::memory_order_relaxed);
+				if (m_pNode)
+					Release(m_pNode);
+				m_pNode = other.m_pNode;
+				return *this;
+			}
+
+			bool operator ==(const CProtoRef &other) const
+			{
+				return m_pNode == other.m_pNode;
+			}
+
+			bool operator !=(const CProtoRef &other) const
+			{
+				return m_pNode != other.m_pNode;
+			}
+
+			unsigned int Hash() const
+			{
+				return m_pNode ? m_pNode->hash : 0;
+			}
+
+			bool IsValid() const
+			{
+				return m_pNode != NULL;
+			}
+
+			// An empty ref acts like an invalid proto
+			const CProto &operator *() const;
+			const CProto *operator ->() const
+			{
+				return &**this;
+			}
+
+			// Number of distinct protos in the table
+			static size_t GetNumInterned();
 		};
 	}
 }
@@ -0,0 +1,242 @@
+/* ======== SourceHook ========
+* Copyright (C) 2004-2010 Metamod:Source Development Team
+* No warranties of any kind
+*
+* License: zlib/libpng
+*
+* Author(s): Pavol "PM OnoTo" Marko
+* ============================
+*/
+
+#ifndef __SOURCEHOOK_IMPL_CPTRMAP_H__
+#define __SOURCEHOOK_IMPL_CPTRMAP_H__
+
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+#include <stdint.h>
+#include "sourcehook_impl_cepochman.h"
+
+namespace SourceHook
+{
+	namespace Impl
+	{
+		// Pointer -> pointer map which the hook loop can read on any thread without locking.
+		//
+		// Open addressing with linear probing. The single writer fills in the value before the key,
+		// so a reader that finds the key also finds the value. Removed keys become tombstones which
+		// are never reused (a reader may still be looking at the slot); the table is rebuilt instead,
+		// and the old table is retired through the epoch manager.
+		template <class V> class CPtrMap
+		{
+			struct Slot
+			{
+				std::atomic<void*> key;
+				std::atomic<V*> value;
+			};
+
+			struct Table
+			{
+				size_t mask;
+				size_t used;			// live keys + tombstones
+				size_t live;
+				Slot *GetSlots()
+				{
+					return reinterpret_cast<Slot*>(this + 1);
+				}
+			};
+
+			static const size_t MIN_SIZE = 8;
+
+			std::atomic<Table*> m_pTable;
+
+			static void *Tombstone()
+			{
+				return reinterpret_cast<void*>(~static_cast<uintptr_t>(0));
+			}
+
+			static size_t HashPtr(void *key)
+			{
+				// Objects are at least pointer-aligned, so the low bits carry no information
+				uintptr_t addr = reinterpret_cast<uintptr_t>(key);
+				return static_cast<size_t>((addr >> 3) ^ (addr >> 17));
+			}
+
+			static Table *NewTable(size_t size)
+			{
+				Table *table = reinterpret_cast<Table*>(malloc(sizeof(Table) + size * sizeof(Slot)));
+				table->mask = size - 1;
+				table->used = 0;
+				table->live = 0;
+
+				Slot *slots = table->GetSlots();
+				for (size_t i = 0; i < size; ++i)
+				{
+					new (&slots[i].key) std::atomic<void*>(static_cast<void*>(NULL));
+					new (&slots[i].value) std::atomic<V*>(static_cast<V*>(NULL));
+				}
+				return table;
+			}
+
+			static void FreeTable(void *table)
+			{
+				// The slots are trivially destructible
+				free(table);
+			}
+
+			static void InsertInto(Table *table, void *key, V *value)
+			{
+				Slot *slots = table->GetSlots();
+				size_t pos = HashPtr(key) & table->mask;
+				while (slots[pos].key.load(std::memory_order_relaxed) != NULL)
+					pos = (pos + 1) & table->mask;
+
+				slots[pos].value.store(value, std::memory_order_relaxed);
+				slots[pos].key.store(key, std::memory_order_release);
+				++table->used;
+				++table->live;
+			}
+
+			// Replaces the table by one with room for at least minLive keys and no tombstones
+			void Rebuild(size_t minLive, CEpochManager *pEpochs)
+			{
+				Table *old = m_pTable.load(std::memory_order_relaxed);
+
+				size_t size = MIN_SIZE;
+				while (size * 3 < (minLive + 1) * 4)
+					size *= 2;
+
+				Table *table = NewTable(size);
+				if (old)
+				{
+					Slot *slots = old->GetSlots();
+					for (size_t i = 0; i <= old->mask; ++i)
+					{
+						void *key = slots[i].key.load(std::memory_order_relaxed);
+						if (key != NULL && key != Tombstone())
+							InsertInto(table, key, slots[i].value.load(std::memory_order_relaxed));
+					}
+				}
+
+				m_pTable.store(table, std::memory_order_release);
+
+				if (old)
+				{
+					if (pEpochs)
+						pEpochs->Retire(&FreeTable, old);
+					else
+						FreeTable(old);
+				}
+			}
+
+			void CopyFrom(const CPtrMap &other)
+			{
+				Table *table = other.m_pTable.load(std::memory_order_relaxed);
+				if (table == NULL)
+					return;
+
+				Slot *slots = table->GetSlots();
+				for (size_t i = 0; i <= table->mask; ++i)
+				{
+					void *key = slots[i].key.load(std::memory_order_relaxed);
+					if (key != NULL && key != Tombstone())
+						Insert(key, slots[i].value.load(std::memory_order_relaxed), NULL);
+				}
+			}
+		public:
+			CPtrMap() : m_pTable(NULL)
+			{
+			}
+
+			// Copies are only made of objects nobody reads from concurrently
+			CPtrMap(const CPtrMap &other) : m_pTable(NULL)
+			{
+				CopyFrom(other);
+			}
+
+			CPtrMap &operator =(const CPtrMap &other)
+			{
+				if (this != &other)
+				{
+					Table *table = m_pTable.exchange(NULL, std::memory_order_relaxed);
+					if (table)
+						FreeTable(table);
+					CopyFrom(other);
+				}
+				return *this;
+			}
+
+			~CPtrMap()
+			{
+				Table *table = m_pTable.load(std::memory_order_relaxed);
+				if (table)
+					FreeTable(table);
+			}
+
+			// Reader side
+			V *Find(void *key) const
+			{
+				Table *table = m_pTable.load(std::memory_order_acquire);
+				if (table == NULL)
+					return NULL;
+
+				Slot *slots = table->GetSlots();
+				size_t pos = HashPtr(key) & table->mask;
+				for (;;)
+				{
+					void *cur = slots[pos].key.load(std::memory_order_acquire);
+					if (cur == key)
+						return slots[pos].value.load(std::memory_order_relaxed);
+					if (cur == NULL)
+						return NULL;
+					pos = (pos + 1) & table->mask;
+				}
+			}
+
+			// Writer side. The key must not be in the map yet.
+			// Without an epoch manager, replaced tables are freed right away.
+			void Insert(void *key, V *value, CEpochManager *pEpochs)
+			{
+				Table *table = m_pTable.load(std::memory_order_relaxed);
+				if (table == NULL || (table->used + 1) * 4 > (table->mask + 1) * 3)
+				{
+					Rebuild(table ? table->live + 1 : 1, pEpochs);
+					table = m_pTable.load(std::memory_order_relaxed);
+				}
+
+				InsertInto(table, key, value);
+			}
+
+			bool Remove(void *key)
+			{
+				Table *table = m_pTable.load(std::memory_order_relaxed);
+				if (table == NULL)
+					return false;
+
+				Slot *slots = table->GetSlots();
+				size_t pos = HashPtr(key) & table->mask;
+				for (;;)
+				{
+					void *cur = slots[pos].key.load(std::memory_order_relaxed);
+					if (cur == key)
+					{
+						slots[pos].key.store(Tombstone(), std::memory_order_release);
+						--table->live;
+						return true;
+					}
+					if (cur == NULL)
+						return false;
+					pos = (pos + 1) & table->mask;
+				}
+			}
+
+			size_t size() const
+			{
+				Table *table = m_pTable.load(std::memory_order_relaxed);
+				return table ? table->live : 0;
+			}
+		};
+	}
+}
+
+#endif
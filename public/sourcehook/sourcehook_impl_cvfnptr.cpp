@@ -14,18 +14,113 @@ namespace SourceHook
 {
 	namespace Impl
 	{
-		CPageAlloc CVfnPtr::ms_AlignedPageAllocator(8);
+		CPageAlloc CVfnPtr::ms_AlignedPageAllocator(8, true);
 
-		CVfnPtr::CVfnPtr(void *ptr)
+		// Other threads may be calling through the vtable entry while it is patched:
+		//  store it in one piece and after everything the new target depends on
+		static inline void StoreEntry(void *vfnptr, void *newValue)
+		{
+#if SH_COMP == SH_COMP_MSVC
+			*reinterpret_cast<void * volatile *>(vfnptr) = newValue;
+#else
+			__atomic_store_n(reinterpret_cast<void**>(vfnptr), newValue, __ATOMIC_RELEASE);
+#endif
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// CPatchBatch
+		//////////////////////////////////////////////////////////////////////////
+
+		CPatchBatch::CPatchBatch() : m_Active(false)
+		{
+		}
+
+		void CPatchBatch::Begin()
+		{
+			m_Active = true;
+		}
+
+		void CPatchBatch::Queue(void *vfnptr, void *newValue)
+		{
+			PendingPatch patch;
+			patch.vfnptr = vfnptr;
+			patch.newValue = newValue;
+			patch.seq = m_Patches.size();
+			m_Patches.push_back(patch);
+		}
+
+		void CPatchBatch::PatchedDirectly(void *vfnptr)
+		{
+			Queue(vfnptr, NULL);
+		}
+
+		int CPatchBatch::ComparePatches(const void *a, const void *b)
+		{
+			const PendingPatch *pa = reinterpret_cast<const PendingPatch*>(a);
+			const PendingPatch *pb = reinterpret_cast<const PendingPatch*>(b);
+			if (pa->vfnptr != pb->vfnptr)
+				return reinterpret_cast<uintptr_t>(pa->vfnptr) < reinterpret_cast<uintptr_t>(pb->vfnptr) ? -1 : 1;
+			return pa->seq < pb->seq ? -1 : (pa->seq > pb->seq ? 1 : 0);
+		}
+
+		void CPatchBatch::Commit()
+		{
+			m_Active = false;
+			if (m_Patches.empty())
+				return;
+
+			// Sorted by address, the patches of a vfnptr are next to each other (the last one
+			// counts) and so are the vfnptrs of a page. Querying and changing the page protection
+			// is the expensive part (a lookup in the page map, maybe a syscall), so do it once per
+			// page. 4K granularity is conservative: real pages are at least that big.
+			qsort(m_Patches.begin().base(), m_Patches.size(), sizeof(PendingPatch), ComparePatches);
+
+			uintptr_t lastPage = 0;
+			bool writable = false;
+			for (size_t i = 0; i < m_Patches.size(); ++i)
+			{
+				const PendingPatch &patch = m_Patches[i];
+				if (i + 1 < m_Patches.size() && m_Patches[i + 1].vfnptr == patch.vfnptr)
+					continue;
+				if (patch.newValue == NULL)
+					continue;
+
+				uintptr_t page = reinterpret_cast<uintptr_t>(patch.vfnptr) >> 12;
+				if (page != lastPage)
+				{
+					lastPage = page;
+					writable = CPageMap::MakePageWritable(patch.vfnptr);
+				}
+
+				if (writable)
+					StoreEntry(patch.vfnptr, patch.newValue);
+			}
+
+			m_Patches.clear();
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// CVfnPtr
+		//////////////////////////////////////////////////////////////////////////
+
+		CVfnPtr::CVfnPtr(void *ptr, CEpochManager *pEpochs, CPatchBatch *pBatch)
 			: m_Ptr(ptr), m_OrigEntry(*reinterpret_cast<void**>(m_Ptr)),
-			m_OrigCallThunk(NULL)
+			m_OrigCallThunk(NULL), m_pEpochs(pEpochs), m_pBatch(pBatch), m_pVPIface(NULL), m_Idle(false), m_Unpatched(false)
 		{
 		}
 
 		CVfnPtr::~CVfnPtr()
+		{
+			// Detach() has been called when we were removed
+			for (PooledList<CIface*>::iterator iter = m_IfaceList.begin(); iter != m_IfaceList.end(); ++iter)
+				delete *iter;
+		}
+
+		void CVfnPtr::Detach()
 		{
 			if (!m_HookMans.empty())
 				m_HookMans.front()->DecrRef(this);
+			m_HookMans.clear();
 		}
 
 		bool CVfnPtr::Init()
@@ -35,7 +130,7 @@ namespace SourceHook
 			// If we're running on GCC and the original vtable entry is odd
 			// we have a problem.
 			// The hook functions use non-virtual member function pointers to
-			// call the original function (see sourcehook.hxx, SH_SETUP_MFP and SH_CALL_ORIG)
+			// call the original function (see sourcehook.hxx, SH_SETUP_MFP and HookFuncBody)
 			// GCC has the same format for virtual and non-virtual MFPs:
 			// virtual ones have an odd value as "funcptr" where the offset into the vtable is encoded
 			// non-virtual ones have the direct function pointer as "funcptr", assuming that it is even
@@ -52,8 +147,11 @@ namespace SourceHook
 				m_OrigCallThunk = ms_AlignedPageAllocator.Alloc(12);
 				ms_AlignedPageAllocator.SetRW(m_OrigCallThunk);
 
-				unsigned char* thunkBase = reinterpret_cast<unsigned char*>(m_OrigCallThunk);
-				ptrdiff_t offset = reinterpret_cast<unsigned char*>(m_OrigEntry) - thunkBase - 5;
+				// Jumps are relative to where the thunk runs, which need not be where we write it
+				unsigned char* thunkBase = reinterpret_cast<unsigned char*>(
+					ms_AlignedPageAllocator.GetWritable(m_OrigCallThunk));
+				ptrdiff_t offset = reinterpret_cast<unsigned char*>(m_OrigEntry) -
+					reinterpret_cast<unsigned char*>(m_OrigCallThunk) - 5;
 
 				if (offset >= INT_MIN && offset <= INT_MAX)
 				{
@@ -84,7 +182,7 @@ namespace SourceHook
 			return true;
 		}
 
-		class CVfnPtrOrigThunkCleanup : public ICleanupTask
+		class CVfnPtrOrigThunkCleanup : public ICleanupTask, public CSlabAllocated<CVfnPtrOrigThunkCleanup>
 		{
 			CPageAlloc *m_Allocator;
 			void *m_AddrToFree;
@@ -132,7 +230,11 @@ namespace SourceHook
 			// If it's not, do not remove stuff like we did before
 			// First off we did it wrong (shutdown the whole hookman, uh..) and secondly applications may be
 			// confused by RemoveHook returning false then (yeah, I know, I made this one up, no one checks for RemoveHook error)
-			if (ModuleInMemory(reinterpret_cast<char*>(m_Ptr), SH_PTRSIZE))
+			if (m_Unpatched)
+			{
+				return true;
+			}
+			else if (CPageMap::ModuleInMemory(reinterpret_cast<char*>(m_Ptr), SH_PTRSIZE))
 			{
 				return Patch(m_OrigEntry);
 			}
@@ -142,18 +244,9 @@ namespace SourceHook
 			}
 		}
 
-		CIface *CVfnPtr::FindIface(void *iface)
-		{
-			List<CIface>::iterator iter = m_IfaceList.find(iface);
-			if (iter == m_IfaceList.end())
-				return NULL;
-			else
-				return &(*iter);
-		}
-
 		void CVfnPtr::AddHookMan(CHookManager *pHookMan)
 		{
-			List<CHookManager*>::iterator iter;
+			PooledList<CHookManager*>::iterator iter;
 
 			// Don't accept invalid hook managers
 			if (!*pHookMan)
@@ -177,21 +270,25 @@ namespace SourceHook
 
 			if (isBeginning)
 			{
-				pHookMan->IncrRef(this);
+				pHookMan->IncrRef(this, m_pEpochs);
+
+				// Make sure that this vfnptr points at it
+				if (!m_Unpatched)
+					SetEntry(pHookMan->GetHookFunc());
+
 				if (m_HookMans.size() > 1)
 				{
 					// If another hookman was used until now but this one is better
 					// (which it is because it's the first -> it has a higher version)
 					// -> switch!
+					// Only let go of it after patching: hook funcs which are being called
+					// on other threads have to find us in their hook manager.
 
-					List<CHookManager*>::iterator second = m_HookMans.begin();
+					PooledList<CHookManager*>::iterator second = m_HookMans.begin();
 					++second;
 
-					(*second)->DecrRef(this);
+					(*second)->DecrRef(this, pHookMan);
 				}
-
-				// Make sure that this vfnptr points at it
-				Patch(pHookMan->GetHookFunc());
 			}
 		}
 
@@ -201,22 +298,24 @@ namespace SourceHook
 			if (!*pHookMan)
 				return true;
 
-			List<CHookManager*>::iterator iter = m_HookMans.find(pHookMan);
+			PooledList<CHookManager*>::iterator iter = m_HookMans.find(pHookMan);
 			if (iter == m_HookMans.end())
 				return true;							// Didn't exist here anyway
 
 			if (iter == m_HookMans.begin())
 			{
 				// It is the first one!
-				pHookMan->DecrRef(this);
-				m_HookMans.erase(iter);
-
-				if (m_HookMans.empty())
-					return false;				// No more hookmans -> let SH delete us
+				// As in AddHookMan, the vtable entry must not point at a hook func whose
+				// hook manager doesn't know us anymore.
+				if (m_HookMans.size() == 1)
+					return false;				// No more hookmans -> let SH revert and delete us (see Detach)
 
 				// Activate second -> now first hookman
-				m_HookMans.front()->IncrRef(this);
-				Patch(m_HookMans.front()->GetHookFunc());
+				m_HookMans.erase(iter);
+				m_HookMans.front()->IncrRef(this, m_pEpochs);
+				if (!m_Unpatched)
+					Patch(m_HookMans.front()->GetHookFunc());
+				pHookMan->DecrRef(this, m_HookMans.front());
 			}
 			else
 			{
@@ -227,37 +326,93 @@ namespace SourceHook
 
 		bool CVfnPtr::Patch(void *newValue)
 		{
-			if (!MakePageWritable(m_Ptr))
+			// A queued patch must not overwrite this one on commit
+			if (m_pBatch->IsActive())
+				m_pBatch->PatchedDirectly(m_Ptr);
+
+			if (!CPageMap::MakePageWritable(m_Ptr))
 			{
 				return false;
 			}
 
-			*reinterpret_cast<void**>(m_Ptr) = newValue;
+			StoreEntry(m_Ptr, newValue);
 
 			return true;
 		}
 
-		CIface &CVfnPtr::GetIface(void *iface)
+		void CVfnPtr::SetEntry(void *newValue)
 		{
-			List<CIface>::iterator iter = m_IfaceList.find(iface);
-			if (iter == m_IfaceList.end())
+			if (m_pBatch->IsActive())
+				m_pBatch->Queue(m_Ptr, newValue);
+			else
 			{
-				CIface newIface(iface);
-				if (iface == NULL)
-				{
-					m_IfaceList.push_front(newIface);
-					return m_IfaceList.front();
-				}
-				else
+				Patch(newValue);
+			}
+		}
+
+		void CVfnPtr::UpdateIdle()
+		{
+			bool idle = true;
+			for (PooledList<CIface*>::iterator iter = m_IfaceList.begin(); iter != m_IfaceList.end(); ++iter)
+			{
+				if ((*iter)->GetPreHookArray().size() || (*iter)->GetPostHookArray().size())
 				{
-					m_IfaceList.push_back(newIface);
-					return m_IfaceList.back();
+					idle = false;
+					break;
 				}
 			}
+
+			m_Idle = idle;
+
+			if (!idle && m_Unpatched)
+			{
+				m_Unpatched = false;
+				if (!m_HookMans.empty())
+					SetEntry(m_HookMans.front()->GetHookFunc());
+			}
+		}
+
+		void CVfnPtr::Unpatch()
+		{
+			if (m_Unpatched || !m_Idle)
+				return;
+
+			// Hook funcs which are running at the moment just bypass the hook loop
+			if (Revert())
+				m_Unpatched = true;
+		}
+
+		CIface &CVfnPtr::GetIface(void *iface)
+		{
+			CIface *pIface = FindIface(iface);
+			if (pIface != NULL)
+				return *pIface;
+
+			pIface = new CIface(iface, m_pEpochs);
+			m_IfaceList.push_back(pIface);
+
+			// Publish it only after it has been set up completely
+			if (iface == NULL)
+				m_pVPIface.store(pIface, std::memory_order_release);
 			else
+				m_IfaceIndex.Insert(iface, pIface, m_pEpochs);
+			return *pIface;
+		}
+
+		void CVfnPtr::EraseIface(CIface *pIface)
+		{
+			if (pIface->GetPtr() == NULL)
 			{
-				return *iter;
+				SH_ASSERT(pIface == m_pVPIface.load(std::memory_order_relaxed), ("VP iface is not the cached one?!"));
+				m_pVPIface.store(NULL, std::memory_order_release);
 			}
+			else if (!m_IfaceIndex.Remove(pIface->GetPtr()))
+			{
+				SH_ASSERT(false, ("Iface is not indexed?!"));
+			}
+
+			m_IfaceList.remove(pIface);
+			m_pEpochs->RetireObject(pIface);
 		}
 	}
 }
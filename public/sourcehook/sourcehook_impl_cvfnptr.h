@@ -11,15 +11,52 @@
 #ifndef __SOURCEHOOK_IMPL_CVFNPTR_H__
 #define __SOURCEHOOK_IMPL_CVFNPTR_H__
 
-#include "sh_list.h"
+#include <atomic>
+#include "sh_slaballoc.h"
+#include "sh_vector.h"
+#include "sh_tinyhash.h"
 #include "sh_memory.h"
 #include "sh_pagealloc.h"
 #include "sourcehook_impl_cleanuptask.h"
+#include "sourcehook_impl_cepochman.h"
+#include "sourcehook_impl_cptrmap.h"
 
 namespace SourceHook
 {
 	namespace Impl
 	{
+		// Vtable patches deferred by a hook batch (see CSourceHookImpl::BeginHookBatch)
+		class CPatchBatch
+		{
+			// A direct patch is recorded with a NULL newValue: nothing queued before it may
+			// overwrite it on commit
+			struct PendingPatch
+			{
+				void *vfnptr;
+				void *newValue;
+				size_t seq;
+			};
+			CVector<PendingPatch> m_Patches;
+			bool m_Active;
+
+			static int ComparePatches(const void *a, const void *b);
+		public:
+			CPatchBatch();
+
+			inline bool IsActive() const;
+			void Begin();
+			void Queue(void *vfnptr, void *newValue);
+			void PatchedDirectly(void *vfnptr);
+
+			// Applies the last patch queued for each vfnptr, making each page writable once
+			void Commit();
+		};
+
+		inline bool CPatchBatch::IsActive() const
+		{
+			return m_Active;
+		}
+
 		class CVfnPtr
 		{
 			static CPageAlloc ms_AlignedPageAllocator;
@@ -28,34 +65,76 @@ namespace SourceHook
 			void *m_Ptr;
 			void *m_OrigEntry;
 			void *m_OrigCallThunk;		// See Init() method
+			CEpochManager *m_pEpochs;
+			CPatchBatch *m_pBatch;
+
+			PooledList<CHookManager*> m_HookMans;
+			PooledList<CIface*> m_IfaceList;
+
+			// FindIface is called twice per hooked call, possibly on several threads at once;
+			// the hook loop only reads the index and the VP iface, never the list.
+			CPtrMap<CIface> m_IfaceIndex;
+			std::atomic<CIface *> m_pVPIface;
+
+			// A slot whose hooks are all paused still runs the hook func, which bypasses the hook
+			// loop. CSourceHookImpl puts the original entry back once the slot has stayed idle over
+			// the next change of the hooks; a hook which becomes active again re-patches it.
+			// Only touched under the write lock.
+			bool m_Idle;
+			bool m_Unpatched;
 
-			List<CHookManager*> m_HookMans;
-			List<CIface> m_IfaceList;
+			void SetEntry(void *newValue);
+
+			CVfnPtr(const CVfnPtr &other);
+			CVfnPtr &operator =(const CVfnPtr &other);
 		public:
 			// *** Descriptor ***
 			typedef void* Descriptor;
 
 			// *** Interface ***
-			CVfnPtr(void *ptr);
+			CVfnPtr(void *ptr, CEpochManager *pEpochs, CPatchBatch *pBatch);
 			~CVfnPtr();
 			bool Init();
 			inline bool operator==(const Descriptor &other);
 			inline void *GetPtr() const;
 			inline void *GetOrigEntry() const;
 			void *GetOrigCallAddr() const;
-			inline List<CIface> &GetIfaceList();
-			inline const List<CIface> &GetIfaceList() const;
-			CIface *FindIface(void *iface);
+			inline PooledList<CIface*> &GetIfaceList();
+			inline const PooledList<CIface*> &GetIfaceList() const;
+			inline CIface *FindIface(void *iface);
 			CIface &GetIface(void *iface);
+
+			// The iface is retired, not deleted
+			void EraseIface(CIface *pIface);
 			bool Patch(void *newValue);
 			bool Revert();
 
+			// While the patch batch is active, AddHookMan only queues the patch. Patch() and
+			// Revert() are always immediate (a replaced hook func may go away right after) and
+			// win over patches queued before them.
+
 			ICleanupTask *GetCleanupTask();
 
 			void AddHookMan(CHookManager *pHookMan);
 			// If this returns false, it means that there is no hook manager left
 			// to use and that this vfnptr should be removed.
 			bool HookManRemoved(CHookManager *pHookMan);
+
+			// The hook manager whose hook func is installed, NULL if none
+			inline CHookManager *GetActiveHookMan();
+
+			// Has to be called whenever the hooks have changed; re-patches an unpatched slot
+			// which has active hooks again
+			void UpdateIdle();
+			inline bool IsIdle() const;
+			inline bool IsUnpatched() const;
+
+			// Puts the original entry back if the slot is still idle
+			void Unpatch();
+
+			// Releases the active hook manager; called when the vfnptr is removed,
+			// the object itself is only deleted once no hook loop can use it anymore.
+			void Detach();
 		};
 
 		// *** Implementation ***
@@ -75,12 +154,35 @@ namespace SourceHook
 			return m_OrigEntry;
 		}
 
-		inline List<CIface> &CVfnPtr::GetIfaceList()
+		inline PooledList<CIface*> &CVfnPtr::GetIfaceList()
 		{
 			return m_IfaceList;
 		}
 
-		inline const List<CIface> &CVfnPtr::GetIfaceList() const
+		inline CHookManager *CVfnPtr::GetActiveHookMan()
+		{
+			return m_HookMans.empty() ? NULL : m_HookMans.front();
+		}
+
+		inline bool CVfnPtr::IsIdle() const
+		{
+			return m_Idle;
+		}
+
+		inline bool CVfnPtr::IsUnpatched() const
+		{
+			return m_Unpatched;
+		}
+
+		inline CIface *CVfnPtr::FindIface(void *iface)
+		{
+			if (iface == NULL)
+				return m_pVPIface.load(std::memory_order_acquire);
+
+			return m_IfaceIndex.Find(iface);
+		}
+
+		inline const PooledList<CIface*> &CVfnPtr::GetIfaceList() const
 		{
 			return m_IfaceList;
 		}
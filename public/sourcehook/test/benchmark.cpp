@@ -0,0 +1,528 @@
+/* ======== SourceHook ========
+* Copyright (C) 2004-2010 Metamod:Source Development Team
+* No warranties of any kind
+*
+* License: zlib/libpng
+*
+* ============================
+*/
+
+// Dispatch benchmarks for SourceHook.
+// Unlike the test suite, this only measures: it prints the cost of a hooked call
+// in ns/call for a couple of scenarios so that regressions in the hook loop
+// (SetupHookLoop/GetNext/EndContext) show up before a build is rolled out.
+//
+// Usage: sourcehook_bench [-n iterations] [-f text|csv|json] [-o file] [filter]
+//   filter: only run scenarios whose name contains this string
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "sourcehook_impl.h"
+#include "sourcehook.h"
+
+#if SH_COMP == SH_COMP_MSVC
+# define BENCH_NOINLINE __declspec(noinline)
+#else
+# define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+SourceHook::ISourceHook *g_SHPtr;
+SourceHook::Plugin g_PLID;
+
+namespace
+{
+	class IBench
+	{
+	public:
+		virtual int Func(int x) = 0;
+	};
+
+	// Every CDerived<N> has its own vtable, i.e. its own vfnptr for Func
+	template <int N>
+	class CDerived : public IBench
+	{
+	public:
+		virtual int Func(int x)
+		{
+			return x + N;
+		}
+	};
+
+	SH_DECL_HOOK1(IBench, Func, SH_NOATTRIB, 0, int, int);
+
+	int Handler_Func(int x)
+	{
+		RETURN_META_VALUE(MRES_IGNORED, 0);
+	}
+
+	int Handler_Func_Recall(int x)
+	{
+		RETURN_META_VALUE_NEWPARAMS(MRES_IGNORED, 0, &IBench::Func, (x + 1));
+	}
+
+	const int MAX_VTABLES = 64;
+	IBench *g_Instances[MAX_VTABLES];
+
+	template <int N>
+	struct InstanceMaker
+	{
+		static void Make()
+		{
+			g_Instances[N - 1] = new CDerived<N>;
+			InstanceMaker<N - 1>::Make();
+		}
+	};
+
+	template <>
+	struct InstanceMaker<0>
+	{
+		static void Make()
+		{
+		}
+	};
+
+	typedef std::chrono::steady_clock BenchClock;
+
+	// Makes sure the calls aren't thrown away
+	volatile int g_Sink;
+
+	double NsPerCall(BenchClock::time_point start, BenchClock::time_point end, int calls)
+	{
+		return std::chrono::duration<double, std::nano>(end - start).count() / calls;
+	}
+
+	// Calls pInst->Func iterations times and returns ns/call
+	BENCH_NOINLINE double TimeCalls(IBench *pInst, int iterations)
+	{
+		int acc = 0;
+		BenchClock::time_point start = BenchClock::now();
+		for (int i = 0; i < iterations; ++i)
+			acc += pInst->Func(i);
+		BenchClock::time_point end = BenchClock::now();
+
+		g_Sink = acc;
+		return NsPerCall(start, end, iterations);
+	}
+
+	// Calls Func on the instances round robin, iterations calls in total
+	BENCH_NOINLINE double TimeCallsOn(IBench **ppInsts, int numInsts, int iterations)
+	{
+		int acc = 0;
+		int cur = 0;
+		BenchClock::time_point start = BenchClock::now();
+		for (int i = 0; i < iterations; ++i)
+		{
+			acc += ppInsts[cur]->Func(i);
+			if (++cur == numInsts)
+				cur = 0;
+		}
+		BenchClock::time_point end = BenchClock::now();
+
+		g_Sink = acc;
+		return NsPerCall(start, end, iterations);
+	}
+
+	BENCH_NOINLINE double TimeSHCalls(IBench *pInst, int iterations)
+	{
+		int acc = 0;
+		BenchClock::time_point start = BenchClock::now();
+		for (int i = 0; i < iterations; ++i)
+			acc += SH_CALL(pInst, &IBench::Func)(i);
+		BenchClock::time_point end = BenchClock::now();
+
+		g_Sink = acc;
+		return NsPerCall(start, end, iterations);
+	}
+
+	double WarmAndTime(IBench *pInst, int iterations)
+	{
+		TimeCalls(pInst, iterations / 10 + 1);
+		return TimeCalls(pInst, iterations);
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Results
+
+	struct Result
+	{
+		std::string scenario;
+		std::string param;
+		double nsPerCall;
+	};
+
+	std::vector<Result> g_Results;
+	const char *g_Filter = NULL;
+
+	bool ShouldRun(const char *scenario)
+	{
+		return g_Filter == NULL || strstr(scenario, g_Filter) != NULL;
+	}
+
+	void AddResult(const char *scenario, const char *param, double nsPerCall)
+	{
+		Result res;
+		res.scenario = scenario;
+		res.param = param;
+		res.nsPerCall = nsPerCall;
+		g_Results.push_back(res);
+	}
+
+	void AddResult(const char *scenario, int param, double nsPerCall)
+	{
+		char buf[32];
+		snprintf(buf, sizeof(buf), "%d", param);
+		AddResult(scenario, buf, nsPerCall);
+	}
+
+	void WriteText(FILE *fp)
+	{
+		fprintf(fp, "%-20s %-12s %12s\n", "scenario", "param", "ns/call");
+		for (size_t i = 0; i < g_Results.size(); ++i)
+		{
+			fprintf(fp, "%-20s %-12s %12.2f\n", g_Results[i].scenario.c_str(), g_Results[i].param.c_str(),
+				g_Results[i].nsPerCall);
+		}
+	}
+
+	void WriteCSV(FILE *fp)
+	{
+		fprintf(fp, "scenario,param,ns_per_call\n");
+		for (size_t i = 0; i < g_Results.size(); ++i)
+		{
+			fprintf(fp, "%s,%s,%.3f\n", g_Results[i].scenario.c_str(), g_Results[i].param.c_str(),
+				g_Results[i].nsPerCall);
+		}
+	}
+
+	void WriteJSON(FILE *fp, int iterations)
+	{
+		// Scenario names and params are plain identifiers/numbers, no escaping needed
+		fprintf(fp, "{\n  \"iterations\": %d,\n  \"results\": [\n", iterations);
+		for (size_t i = 0; i < g_Results.size(); ++i)
+		{
+			fprintf(fp, "    { \"scenario\": \"%s\", \"param\": \"%s\", \"ns_per_call\": %.3f }%s\n",
+				g_Results[i].scenario.c_str(), g_Results[i].param.c_str(), g_Results[i].nsPerCall,
+				(i + 1 < g_Results.size()) ? "," : "");
+		}
+		fprintf(fp, "  ]\n}\n");
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Scenarios
+
+	// No hook anywhere on the vtable
+	void Bench_Unhooked(int iterations)
+	{
+		AddResult("unhooked", "-", WarmAndTime(g_Instances[0], iterations));
+	}
+
+	// numHandlers pre hooks on the called instance. With 0 handlers, the vtable slot
+	// is hooked through another instance, so the called instance takes the hook loop
+	// without anything to run.
+	void Bench_Handlers(int numHandlers, int iterations)
+	{
+		CDerived<1> other;
+		std::vector<int> hookids;
+
+		if (numHandlers == 0)
+			hookids.push_back(SH_ADD_HOOK(IBench, Func, &other, SH_STATIC(Handler_Func), false));
+
+		for (int i = 0; i < numHandlers; ++i)
+			hookids.push_back(SH_ADD_HOOK(IBench, Func, g_Instances[0], SH_STATIC(Handler_Func), false));
+
+		AddResult("handlers", numHandlers, WarmAndTime(g_Instances[0], iterations));
+
+		for (size_t i = 0; i < hookids.size(); ++i)
+			SH_REMOVE_HOOK_ID(hookids[i]);
+	}
+
+	// The set up and tear down of the hook loop of a hooked call, the way a hook func does it.
+	// legacy: SetupHookLoop always makes a context, like before hook funcs could bypass the loop.
+	// params: SetupHookLoopParams also decides whether the call can bypass the loop, from the same
+	// lookup, so a hooked call mustn't cost more through it.
+	void Bench_HookedSetup(bool params, int iterations)
+	{
+		int hookid = SH_ADD_HOOK(IBench, Func, g_Instances[0], SH_STATIC(Handler_Func), false);
+
+		SourceHook::IHookManagerInfo *hi = SH_FHCls(IBench, Func, 0)::ms_HI;
+		void *vfnptr = *reinterpret_cast<void***>(g_Instances[0]);
+		void *thisptr = g_Instances[0];
+		void *origEntry;
+		META_RES status, prevRes, curRes;
+		int origRet, overrideRet = 0;
+
+		BenchClock::time_point start = BenchClock::now();
+		for (int i = 0; i < iterations; ++i)
+		{
+			status = MRES_IGNORED;
+			SourceHook::IHookContext *pContext = params ?
+				g_SHPtr->SetupHookLoopParams(hi, vfnptr, thisptr, &origEntry, &status, &prevRes, &curRes,
+					&origRet, &overrideRet, NULL) :
+				g_SHPtr->SetupHookLoop(hi, vfnptr, thisptr, &origEntry, &status, &prevRes, &curRes,
+					&origRet, &overrideRet);
+			g_SHPtr->EndContext(pContext);
+		}
+		BenchClock::time_point end = BenchClock::now();
+
+		AddResult("hooked_setup", params ? "params" : "legacy",
+			NsPerCall(start, end, iterations));
+
+		SH_REMOVE_HOOK_ID(hookid);
+	}
+
+	// Many instances of one class, called round robin: one hook per instance vs. one VP hook
+	void Bench_Instances(bool vp, int numInstances, int iterations)
+	{
+		CDerived<1> *insts = new CDerived<1>[numInstances];
+		IBench **ppInsts = new IBench*[numInstances];
+		std::vector<int> hookids;
+
+		for (int i = 0; i < numInstances; ++i)
+		{
+			ppInsts[i] = &insts[i];
+			if (!vp)
+				hookids.push_back(SH_ADD_HOOK(IBench, Func, ppInsts[i], SH_STATIC(Handler_Func), false));
+		}
+		if (vp)
+			hookids.push_back(SH_ADD_VPHOOK(IBench, Func, ppInsts[0], SH_STATIC(Handler_Func), false));
+
+		TimeCallsOn(ppInsts, numInstances, iterations / 10 + 1);
+		AddResult(vp ? "instances_vp" : "instances_normal", numInstances,
+			TimeCallsOn(ppInsts, numInstances, iterations));
+
+		for (size_t i = 0; i < hookids.size(); ++i)
+			SH_REMOVE_HOOK_ID(hookids[i]);
+
+		delete [] ppInsts;
+		delete [] insts;
+	}
+
+	// Hooks Func on the first numVtables vtables (all through the same hook manager)
+	// and measures a call on the vtable that was hooked last.
+	void Bench_Vtables(int numVtables, int iterations)
+	{
+		std::vector<int> hookids;
+		for (int i = 0; i < numVtables; ++i)
+			hookids.push_back(SH_ADD_VPHOOK(IBench, Func, g_Instances[i], SH_STATIC(Handler_Func), false));
+
+		AddResult("vtables", numVtables, WarmAndTime(g_Instances[numVtables - 1], iterations));
+
+		for (size_t i = 0; i < hookids.size(); ++i)
+			SH_REMOVE_HOOK_ID(hookids[i]);
+	}
+
+	// SH_CALL on a hooked instance, bypassing its handler
+	void Bench_SHCall(int iterations)
+	{
+		int hookid = SH_ADD_HOOK(IBench, Func, g_Instances[0], SH_STATIC(Handler_Func), false);
+
+		TimeSHCalls(g_Instances[0], iterations / 10 + 1);
+		AddResult("sh_call", "1", TimeSHCalls(g_Instances[0], iterations));
+
+		SH_REMOVE_HOOK_ID(hookid);
+	}
+
+	// Every call does one RETURN_META_VALUE_NEWPARAMS from its first pre hook
+	void Bench_Recall(int iterations)
+	{
+		int hookid1 = SH_ADD_HOOK(IBench, Func, g_Instances[0], SH_STATIC(Handler_Func_Recall), false);
+		int hookid2 = SH_ADD_HOOK(IBench, Func, g_Instances[0], SH_STATIC(Handler_Func), false);
+
+		AddResult("recall", "1", WarmAndTime(g_Instances[0], iterations));
+
+		SH_REMOVE_HOOK_ID(hookid1);
+		SH_REMOVE_HOOK_ID(hookid2);
+	}
+
+	// 64 pre hooks of which all but numActive are paused
+	void Bench_Paused(int numActive, int iterations)
+	{
+		const int numHooks = 64;
+		int hookids[numHooks];
+		for (int i = 0; i < numHooks; ++i)
+		{
+			hookids[i] = SH_ADD_HOOK(IBench, Func, g_Instances[0], SH_STATIC(Handler_Func), false);
+			if (i >= numActive)
+				g_SHPtr->PauseHookByID(hookids[i]);
+		}
+
+		AddResult("paused_64", numActive, WarmAndTime(g_Instances[0], iterations));
+
+		for (int i = 0; i < numHooks; ++i)
+			SH_REMOVE_HOOK_ID(hookids[i]);
+	}
+
+#if SH_SYS == SH_SYS_LINUX
+	// Adding and removing a hook patches the vtable entry twice: each patch queries the
+	// page protection, and the removal checks whether the module is still loaded first.
+	// Uncached throws away the page map before every operation, so each one reads
+	// /proc/self/maps like before the cache. numMappings extra mappings make the map
+	// about as long as a game server's. Reports ns per add + remove.
+	void Bench_Patch(bool cached, int numMappings, int rounds)
+	{
+		// Alternating protections keep the kernel from merging the pages into one mapping
+		size_t size = static_cast<size_t>(numMappings) * PAGESIZE;
+		char *pages = NULL;
+		if (numMappings > 0)
+		{
+			pages = reinterpret_cast<char*>(mmap(NULL, size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+			if (pages == MAP_FAILED)
+				return;
+			for (int i = 1; i < numMappings; i += 2)
+				mprotect(pages + i * PAGESIZE, PAGESIZE, PROT_NONE);
+		}
+		SourceHook::Impl::CPageMap::Get().Invalidate();
+
+		BenchClock::time_point start = BenchClock::now();
+		for (int i = 0; i < rounds; ++i)
+		{
+			if (!cached)
+				SourceHook::Impl::CPageMap::Get().Invalidate();
+			int hookid = SH_ADD_HOOK(IBench, Func, g_Instances[0], SH_STATIC(Handler_Func), false);
+
+			if (!cached)
+				SourceHook::Impl::CPageMap::Get().Invalidate();
+			SH_REMOVE_HOOK_ID(hookid);
+		}
+		BenchClock::time_point end = BenchClock::now();
+
+		char param[32];
+		snprintf(param, sizeof(param), "%s/%d", cached ? "cached" : "uncached", numMappings);
+		AddResult("patch", param, NsPerCall(start, end, rounds));
+
+		if (pages)
+			munmap(pages, size);
+		SourceHook::Impl::CPageMap::Get().Invalidate();
+	}
+#endif
+
+	void Usage(const char *self)
+	{
+		fprintf(stderr, "Usage: %s [-n iterations] [-f text|csv|json] [-o file] [filter]\n", self);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	int iterations = 2000000;
+	const char *format = "text";
+	const char *outfile = NULL;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+			iterations = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+			format = argv[++i];
+		else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+			outfile = argv[++i];
+		else if (argv[i][0] == '-')
+		{
+			Usage(argv[0]);
+			return 1;
+		}
+		else
+			g_Filter = argv[i];
+	}
+
+	if (iterations <= 0 || (strcmp(format, "text") != 0 && strcmp(format, "csv") != 0 && strcmp(format, "json") != 0))
+	{
+		Usage(argv[0]);
+		return 1;
+	}
+
+	SourceHook::Impl::CSourceHookImpl sh;
+	g_SHPtr = &sh;
+	g_PLID = 1;
+
+	InstanceMaker<MAX_VTABLES>::Make();
+
+	if (ShouldRun("unhooked"))
+		Bench_Unhooked(iterations);
+
+	static const int handlerCounts[] = { 0, 1, 8, 64 };
+	if (ShouldRun("handlers"))
+	{
+		for (size_t i = 0; i < sizeof(handlerCounts) / sizeof(handlerCounts[0]); ++i)
+			Bench_Handlers(handlerCounts[i], iterations);
+	}
+
+	if (ShouldRun("hooked_setup"))
+	{
+		Bench_HookedSetup(false, iterations);
+		Bench_HookedSetup(true, iterations);
+	}
+
+	static const int instanceCounts[] = { 1, 10, 100, 1000, 10000 };
+	for (int vp = 0; vp <= 1; ++vp)
+	{
+		if (!ShouldRun(vp ? "instances_vp" : "instances_normal"))
+			continue;
+		for (size_t i = 0; i < sizeof(instanceCounts) / sizeof(instanceCounts[0]); ++i)
+			Bench_Instances(vp != 0, instanceCounts[i], iterations);
+	}
+
+	static const int vtableCounts[] = { 1, 8, 64 };
+	if (ShouldRun("vtables"))
+	{
+		for (size_t i = 0; i < sizeof(vtableCounts) / sizeof(vtableCounts[0]); ++i)
+			Bench_Vtables(vtableCounts[i], iterations);
+	}
+
+	if (ShouldRun("sh_call"))
+		Bench_SHCall(iterations);
+
+	if (ShouldRun("recall"))
+		Bench_Recall(iterations);
+
+	static const int activeCounts[] = { 0, 1 };
+	if (ShouldRun("paused_64"))
+	{
+		for (size_t i = 0; i < sizeof(activeCounts) / sizeof(activeCounts[0]); ++i)
+			Bench_Paused(activeCounts[i], iterations);
+	}
+
+#if SH_SYS == SH_SYS_LINUX
+	static const int mappingCounts[] = { 0, 4000 };
+	if (ShouldRun("patch"))
+	{
+		// Much slower than a call
+		int rounds = iterations / 1000 + 1;
+		for (size_t i = 0; i < sizeof(mappingCounts) / sizeof(mappingCounts[0]); ++i)
+		{
+			Bench_Patch(false, mappingCounts[i], rounds);
+			Bench_Patch(true, mappingCounts[i], rounds);
+		}
+	}
+#endif
+
+	sh.CompleteShutdown();
+
+	FILE *fp = stdout;
+	if (outfile)
+	{
+		fp = fopen(outfile, "w");
+		if (!fp)
+		{
+			fprintf(stderr, "Could not open %s for writing\n", outfile);
+			return 1;
+		}
+	}
+
+	if (strcmp(format, "csv") == 0)
+		WriteCSV(fp);
+	else if (strcmp(format, "json") == 0)
+		WriteJSON(fp, iterations);
+	else
+		WriteText(fp);
+
+	if (fp != stdout)
+		fclose(fp);
+
+	return 0;
+}
@@ -54,7 +54,10 @@ DECL_TEST(RefRet);
 DECL_TEST(VPHooks);
 DECL_TEST(CPageAlloc);					// in testhookmangen.cpp
 DECL_TEST(HookManGen);
+DECL_TEST(HookManGenSpecialized);
 DECL_TEST(OddThunks);
+DECL_TEST(ProtoRef);
+DECL_TEST(MT);
 
 int main(int argc, char *argv[])
 {
@@ -78,10 +81,13 @@ int main(int argc, char *argv[])
 	DO_TEST(RefRet);
 	DO_TEST(VPHooks);
 	DO_TEST(CPageAlloc);
-#if !defined( _M_AMD64 ) && !defined( __amd64__ ) && !defined(__x86_64__)	// TODO: Fix for 64-bit
+#if !defined( _M_AMD64 )	// TODO: Microsoft x64 calling convention
 	DO_TEST(HookManGen);
+	DO_TEST(HookManGenSpecialized);
 #endif
 	DO_TEST(OddThunks);
+	DO_TEST(ProtoRef);
+	DO_TEST(MT);
 
 	cout << endl << "----" << endl << "Passed: " << passed << endl << "Failed: " << failed << endl;
 	cout << "Total: " << passed + failed << endl;
@@ -128,7 +134,42 @@ void Test_UnpausePlugin(SourceHook::ISourceHook *shptr, SourceHook::Plugin plug)
 	static_cast<SourceHook::Impl::CSourceHookImpl *>(shptr)->UnpausePlugin(plug);
 }
 
-#if !defined( _M_AMD64 ) && !defined( __amd64__ ) && !defined(__x86_64__)
+void Test_StartProfiling(SourceHook::ISourceHook *shptr)
+{
+	static_cast<SourceHook::Impl::CSourceHookImpl *>(shptr)->StartProfiling();
+}
+
+void Test_StopProfiling(SourceHook::ISourceHook *shptr)
+{
+	static_cast<SourceHook::Impl::CSourceHookImpl *>(shptr)->StopProfiling();
+}
+
+unsigned long long Test_GetProfiledCalls(SourceHook::ISourceHook *shptr, int hookid)
+{
+	const SourceHook::Impl::CHookProfiler &profiler =
+		static_cast<SourceHook::Impl::CSourceHookImpl *>(shptr)->GetProfiler();
+
+	SourceHook::CVector<SourceHook::Impl::CHookProfiler::Stats> stats;
+	profiler.GetTopHooks(stats, static_cast<size_t>(-1), false, 0);
+	for (size_t i = 0; i < stats.size(); ++i)
+	{
+		if (stats[i].hookid == hookid)
+			return stats[i].calls;
+	}
+	return 0;
+}
+
+bool Test_PageMap_GetPageBits(void *addr, int *bits)
+{
+	return SourceHook::Impl::CPageMap::GetPageBits(addr, bits);
+}
+
+bool Test_PageMap_SetMemAccess(void *addr, size_t len, int access)
+{
+	return SourceHook::Impl::CPageMap::SetMemAccess(addr, len, access);
+}
+
+#if !defined( _M_AMD64 )
 SourceHook::IHookManagerAutoGen *Test_HMAG_Factory(SourceHook::ISourceHook *shptr)
 {
 	return new SourceHook::Impl::CHookManagerAutoGen(shptr);
@@ -138,5 +179,10 @@ void Test_HMAG_Delete(SourceHook::IHookManagerAutoGen *ptr)
 {
 	delete static_cast<SourceHook::Impl::CHookManagerAutoGen*>(ptr);
 }
+
+void Test_HMAG_EnableSpecialization(SourceHook::IHookManagerAutoGen *ptr)
+{
+	static_cast<SourceHook::Impl::CHookManagerAutoGen*>(ptr)->EnableSpecialization();
+}
 #endif
 
@@ -34,9 +34,17 @@ void Test_CompleteShutdown(SourceHook::ISourceHook *shptr);
 void Test_UnloadPlugin(SourceHook::ISourceHook *shptr, SourceHook::Plugin plug);
 void Test_PausePlugin(SourceHook::ISourceHook *shptr, SourceHook::Plugin plug);
 void Test_UnpausePlugin(SourceHook::ISourceHook *shptr, SourceHook::Plugin plug);
+void Test_StartProfiling(SourceHook::ISourceHook *shptr);
+void Test_StopProfiling(SourceHook::ISourceHook *shptr);
+unsigned long long Test_GetProfiledCalls(SourceHook::ISourceHook *shptr, int hookid);
+
+// Access to the page map
+bool Test_PageMap_GetPageBits(void *addr, int *bits);
+bool Test_PageMap_SetMemAccess(void *addr, size_t len, int access);
 
 SourceHook::IHookManagerAutoGen *Test_HMAG_Factory(SourceHook::ISourceHook *pSHPtr);
 void Test_HMAG_Delete(SourceHook::IHookManagerAutoGen *ptr);
+void Test_HMAG_EnableSpecialization(SourceHook::IHookManagerAutoGen *ptr);
 
 struct CHMAGAutoDestruction
 {
@@ -3,6 +3,7 @@
 #include "testevents.h"
 
 #include "sh_memory.h"
+#include "sh_pagealloc.h"
 
 namespace
 {
@@ -419,6 +420,37 @@ bool TestBasic(std::string &error)
 		new State_ModuleInMemory(false),
 		NULL), "ModuleInMemory");
 
+	// The page map has to see memory mapped after earlier queries, protection
+	// changes made through it and memory unmapped behind its back
+	{
+		SourceHook::CPageAlloc alloc;
+		void *mem = alloc.Alloc(16);
+
+		int bitsRE = 0, bitsRW = 0;
+		bool foundRE = Test_PageMap_SetMemAccess(mem, 16, SH_MEM_READ | SH_MEM_EXEC) &&
+			Test_PageMap_GetPageBits(mem, &bitsRE);
+		bool foundRW = Test_PageMap_SetMemAccess(mem, 16, SH_MEM_READ | SH_MEM_WRITE) &&
+			Test_PageMap_GetPageBits(mem, &bitsRW);
+		alloc.Free(mem);
+
+		CHECK_COND(foundRE && bitsRE == (SH_MEM_READ | SH_MEM_EXEC), "PageMap 1");
+		CHECK_COND(foundRW && bitsRW == (SH_MEM_READ | SH_MEM_WRITE), "PageMap 2");
+	}
+#if SH_SYS == SH_SYS_LINUX
+	{
+		void *mem = mmap(NULL, PAGESIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		CHECK_COND(mem != MAP_FAILED, "PageMap 3");
+
+		int bits = 0;
+		bool foundMapped = Test_PageMap_GetPageBits(mem, &bits);
+		munmap(mem, PAGESIZE);
+		bool foundUnmapped = Test_PageMap_GetPageBits(mem, &bits);
+
+		CHECK_COND(foundMapped, "PageMap 4");
+		CHECK_COND(!foundUnmapped, "PageMap 5");
+	}
+#endif
+
 	GET_SHPTR(g_SHPtr);
 	g_PLID = 1337;
 
@@ -207,8 +207,8 @@ bool TestPlugSys(std::string &error)
 	SH_ADD_HOOK(Test, Func3, pInst, SH_STATIC(Handler_Func3), false);
 
 	g_PLID = 3;
-	SH_ADD_HOOK(Test, Func1, pInst, SH_STATIC(Handler_Func1), false);
-	SH_ADD_HOOK(Test, Func2, pInst, SH_STATIC(Handler_Func2), true);
+	int func1Hook3 = SH_ADD_HOOK(Test, Func1, pInst, SH_STATIC(Handler_Func1), false);
+	int func2Hook3 = SH_ADD_HOOK(Test, Func2, pInst, SH_STATIC(Handler_Func2), true);
 
 	pInst->Func1();
 	pInst->Func2();
@@ -263,6 +263,9 @@ bool TestPlugSys(std::string &error)
 		new State_Func3_Called,
 		NULL), "Part 3.4.1");
 
+	void **vtable = *reinterpret_cast<void***>(pInst);
+	void *hookFunc1 = vtable[0];
+
 	Test_PausePlugin(g_SHPtr, 1);
 
 	pInst->Func1();
@@ -275,6 +278,25 @@ bool TestPlugSys(std::string &error)
 		new State_Func3_Called,
 		NULL), "Part 3.5.1");
 
+	// Everything on Func1 is paused now; the hook func stays in the vtable until the next change
+	CHECK_COND(vtable[0] == hookFunc1, "Part 3.6.1");
+
+	// Pausing and unpausing right away doesn't touch the vtable
+	g_SHPtr->UnpauseHookByID(func1Hook3);
+	CHECK_COND(vtable[0] == hookFunc1, "Part 3.6.2");
+	g_SHPtr->PauseHookByID(func1Hook3);
+	CHECK_COND(vtable[0] == hookFunc1, "Part 3.6.3");
+
+	// Func1 stays idle over a change of Func2 -> the original function is back in the vtable
+	g_SHPtr->UnpauseHookByID(func2Hook3);
+	CHECK_COND(vtable[0] == SH_GET_ORIG_VFNPTR_ENTRY(pInst, &Test::Func1), "Part 3.6.4");
+	g_SHPtr->PauseHookByID(func2Hook3);
+
+	// A hook which becomes active again patches it back
+	g_SHPtr->UnpauseHookByID(func1Hook3);
+	CHECK_COND(vtable[0] == hookFunc1, "Part 3.6.5");
+	g_SHPtr->PauseHookByID(func1Hook3);
+
 	Test_UnpausePlugin(g_SHPtr, 1);
 	Test_UnpausePlugin(g_SHPtr, 2);
 	Test_UnpausePlugin(g_SHPtr, 3);
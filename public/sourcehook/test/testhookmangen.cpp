@@ -317,7 +317,7 @@ namespace
 		);
 
 	THGM_MAKE_TEST1_void(8, POD<7>);
-	THGM_SETUP_PI1(8, POD<7>, SourceHook::PassInfo::PassType_Object, SourceHook::PassInfo::PassFlag_ByVal);
+	THGM_SETUP_PI1(8, POD<7>, SourceHook::PassInfo::PassType_Object, (SourceHook::PassInfo::PassFlag_ByVal | SourceHook::PassInfo::PassFlag_IntClass));
 
 	THGM_MAKE_TEST1_void(9, POD<600>);
 	THGM_SETUP_PI1(9, POD<600>, SourceHook::PassInfo::PassType_Object, SourceHook::PassInfo::PassFlag_ByVal);
@@ -357,28 +357,28 @@ namespace
 	THGM_SETUP_PI1(106,
 		int, SourceHook::PassInfo::PassType_Basic, SourceHook::PassInfo::PassFlag_ByVal
 		);
-	THGM_SETUP_RI(106, PodRet1, SourceHook::PassInfo::PassType_Object, SourceHook::PassInfo::PassFlag_ByVal);
+	THGM_SETUP_RI(106, PodRet1, SourceHook::PassInfo::PassType_Object, (SourceHook::PassInfo::PassFlag_ByVal | SourceHook::PassInfo::PassFlag_IntClass));
 
 	MAKE_PODRET(4);
 	THGM_MAKE_TEST1(107, PodRet4, int);
 	THGM_SETUP_PI1(107,
 		int, SourceHook::PassInfo::PassType_Basic, SourceHook::PassInfo::PassFlag_ByVal
 		);
-	THGM_SETUP_RI(107, PodRet4, SourceHook::PassInfo::PassType_Object, SourceHook::PassInfo::PassFlag_ByVal);
+	THGM_SETUP_RI(107, PodRet4, SourceHook::PassInfo::PassType_Object, (SourceHook::PassInfo::PassFlag_ByVal | SourceHook::PassInfo::PassFlag_IntClass));
 
 	MAKE_PODRET(8);
 	THGM_MAKE_TEST1(108, PodRet8, int);
 	THGM_SETUP_PI1(108,
 		int, SourceHook::PassInfo::PassType_Basic, SourceHook::PassInfo::PassFlag_ByVal
 		);
-	THGM_SETUP_RI(108, PodRet8, SourceHook::PassInfo::PassType_Object, SourceHook::PassInfo::PassFlag_ByVal);
+	THGM_SETUP_RI(108, PodRet8, SourceHook::PassInfo::PassType_Object, (SourceHook::PassInfo::PassFlag_ByVal | SourceHook::PassInfo::PassFlag_IntClass));
 
 	MAKE_PODRET(13);
 	THGM_MAKE_TEST1(109, PodRet13, int);
 	THGM_SETUP_PI1(109,
 		int, SourceHook::PassInfo::PassType_Basic, SourceHook::PassInfo::PassFlag_ByVal
 		);
-	THGM_SETUP_RI(109, PodRet13, SourceHook::PassInfo::PassType_Object, SourceHook::PassInfo::PassFlag_ByVal);
+	THGM_SETUP_RI(109, PodRet13, SourceHook::PassInfo::PassType_Object, (SourceHook::PassInfo::PassFlag_ByVal | SourceHook::PassInfo::PassFlag_IntClass));
 
 	MAKE_OBJRET(13);
 	THGM_MAKE_TEST1(110, ObjRet13, int);
@@ -430,6 +430,16 @@ namespace
 		double, SourceHook::PassInfo::PassType_Float, SourceHook::PassInfo::PassFlag_ByVal,
 		int, SourceHook::PassInfo::PassType_Basic, SourceHook::PassInfo::PassFlag_ByVal);
 
+	// More integer class params than argument registers on x86-64
+	THGM_MAKE_TEST6_void(151, int, int, POD<16>, int, double, int);
+	THGM_SETUP_PI6(151,
+		int, SourceHook::PassInfo::PassType_Basic, SourceHook::PassInfo::PassFlag_ByVal,
+		int, SourceHook::PassInfo::PassType_Basic, SourceHook::PassInfo::PassFlag_ByVal,
+		POD<16>, SourceHook::PassInfo::PassType_Object, (SourceHook::PassInfo::PassFlag_ByVal | SourceHook::PassInfo::PassFlag_IntClass),
+		int, SourceHook::PassInfo::PassType_Basic, SourceHook::PassInfo::PassFlag_ByVal,
+		double, SourceHook::PassInfo::PassType_Float, SourceHook::PassInfo::PassFlag_ByVal,
+		int, SourceHook::PassInfo::PassType_Basic, SourceHook::PassInfo::PassFlag_ByVal);
+
 	// vafmt tests
 	THGM_MAKE_TEST0_vafmt_void(200);
 	THGM_SETUP_PI0(200);
@@ -456,7 +466,7 @@ namespace
 		);
 
 	THGM_MAKE_TEST1_vafmt_void(208, POD<7>);
-	THGM_SETUP_PI1(208, POD<7>, SourceHook::PassInfo::PassType_Object, SourceHook::PassInfo::PassFlag_ByVal);
+	THGM_SETUP_PI1(208, POD<7>, SourceHook::PassInfo::PassType_Object, (SourceHook::PassInfo::PassFlag_ByVal | SourceHook::PassInfo::PassFlag_IntClass));
 
 	THGM_MAKE_TEST1_vafmt_void(210, POD<600> &);
 	THGM_SETUP_PI1(210, POD<600> &, SourceHook::PassInfo::PassType_Object, SourceHook::PassInfo::PassFlag_ByRef)
@@ -477,7 +487,7 @@ namespace
 	THGM_SETUP_PI1(213,
 		int, SourceHook::PassInfo::PassType_Basic, SourceHook::PassInfo::PassFlag_ByVal
 		);
-	THGM_SETUP_RI(213, PodRet8, SourceHook::PassInfo::PassType_Object, SourceHook::PassInfo::PassFlag_ByVal);
+	THGM_SETUP_RI(213, PodRet8, SourceHook::PassInfo::PassType_Object, (SourceHook::PassInfo::PassFlag_ByVal | SourceHook::PassInfo::PassFlag_IntClass));
 
 	THGM_MAKE_TEST1_vafmt_void(214, Object<133>);
 	THGM_SETUP_PI1(214, Object<133>, SourceHook::PassInfo::PassType_Object,
@@ -598,6 +608,19 @@ namespace
 		}
 	};
 
+	// Removes another hook from inside the hook loop
+	class Hello_Func4_RemoveDeleg : public MyDelegate
+	{
+	public:
+		int m_Victim;
+		virtual void Func()
+		{
+			ADD_STATE(State_Hello_Func4_PreHook);
+			if (m_Victim)
+				g_SHPtr->RemoveHookByID(m_Victim);
+		}
+	};
+
 	bool Tests1(std::string &error)
 	{
 		THGM_DO_TEST_void(0, ());
@@ -779,6 +802,7 @@ namespace
 			new State_ObjODtor_Called(3),
 			NULL), "Test" "11" " Part4");
 		g_Inside_LeafFunc = false;
+		TestClass11::ms_DoRecall = false;
 
 		THGM_REMOVE_HOOK(11, 1);
 		THGM_REMOVE_HOOK(11, 3);
@@ -1006,6 +1030,9 @@ namespace
 
 		THGM_DO_TEST_void(150, (5, 5.5, 6));
 
+		POD<16> pod16 = MakeRet< POD<16> >::Do(12);
+		THGM_DO_TEST_void(151, (1, 2, pod16, 3, 4.5, 5));
+
 		return true;
 	}
 
@@ -1053,6 +1080,15 @@ namespace
 		SourceHook::HookManagerPubFunc helloHM_4 = g_HMAGPtr->MakeHookMan(helloPi, 0, 4);
 		SourceHook::HookManagerPubFunc helloHM_79 = g_HMAGPtr->MakeHookMan(helloPi, 0, 79);
 
+		// Same proto and index -> same hook manager; releasing it once keeps it alive
+		SourceHook::HookManagerPubFunc helloHM_4_again = g_HMAGPtr->MakeHookMan(helloPi, 0, 4);
+		CHECK_COND(helloHM_4_again == helloHM_4, "Test" "Hello" " Part0");
+		g_HMAGPtr->ReleaseHookMan(helloHM_4_again);
+
+		// The pub funcs may live where ones of earlier tests did; forget about those
+		g_SHPtr->RemoveHookManager(g_PLID, helloHM_4);
+		g_SHPtr->RemoveHookManager(g_PLID, helloHM_79);
+
 		pHello->Func4();
 		pHello->Func79();
 		SH_CALL(pHello, &Hello::Func4)();
@@ -1092,9 +1128,115 @@ namespace
 
 		return true;
 	}
+
+	// Hook funcs which call their handlers directly have to notice changes made by the handlers
+	bool TestsSpecialized(std::string &error)
+	{
+		Hello *pHello = new Hello;
+		CAutoPtrDestruction<Hello> apdHello(pHello);
+		SourceHook::CProtoInfoBuilder helloPi(SourceHook::ProtoInfo::CallConv_ThisCall);
+		SourceHook::HookManagerPubFunc helloHM_4 = g_HMAGPtr->MakeHookMan(helloPi, 0, 4);
+		CAutoReleaseHookMan arhm(helloHM_4);
+
+		// The pub func may live where one of an earlier test did; forget about that one
+		g_SHPtr->RemoveHookManager(g_PLID, helloHM_4);
+
+		Hello_Func4_RemoveDeleg *remover = new Hello_Func4_RemoveDeleg;
+		remover->m_Victim = 0;
+		int hookA = g_SHPtr->AddHook(g_PLID, SourceHook::ISourceHook::Hook_Normal, reinterpret_cast<void*>(pHello),
+			0, helloHM_4, remover, false);
+		int hookB = g_SHPtr->AddHook(g_PLID, SourceHook::ISourceHook::Hook_Normal, reinterpret_cast<void*>(pHello),
+			0, helloHM_4, new Hello_Func4_Deleg, false);
+
+		pHello->Func4();
+		CHECK_STATES((&g_States,
+			new State_Hello_Func4_PreHook,
+			new State_Hello_Func4_PreHook,
+			new State_Hello_Func4_Called,
+			NULL), "TestSpecialized Part1");
+
+		// The first handler removes the second one
+		remover->m_Victim = hookB;
+		pHello->Func4();
+		pHello->Func4();
+		remover->m_Victim = 0;
+		CHECK_STATES((&g_States,
+			new State_Hello_Func4_PreHook,
+			new State_Hello_Func4_Called,
+			new State_Hello_Func4_PreHook,
+			new State_Hello_Func4_Called,
+			NULL), "TestSpecialized Part2");
+
+		// Pausing and unpausing
+		hookB = g_SHPtr->AddHook(g_PLID, SourceHook::ISourceHook::Hook_Normal, reinterpret_cast<void*>(pHello),
+			0, helloHM_4, new Hello_Func4_Deleg, false);
+		g_SHPtr->PauseHookByID(hookA);
+		pHello->Func4();
+		g_SHPtr->UnpauseHookByID(hookA);
+		g_SHPtr->PauseHookByID(hookB);
+		pHello->Func4();
+		g_SHPtr->UnpauseHookByID(hookB);
+		pHello->Func4();
+		CHECK_STATES((&g_States,
+			new State_Hello_Func4_PreHook,
+			new State_Hello_Func4_Called,
+			new State_Hello_Func4_PreHook,
+			new State_Hello_Func4_Called,
+			new State_Hello_Func4_PreHook,
+			new State_Hello_Func4_PreHook,
+			new State_Hello_Func4_Called,
+			NULL), "TestSpecialized Part3");
+
+		g_SHPtr->RemoveHookByID(hookA);
+		g_SHPtr->RemoveHookByID(hookB);
+		pHello->Func4();
+		CHECK_STATES((&g_States,
+			new State_Hello_Func4_Called,
+			NULL), "TestSpecialized Part4");
+
+		return true;
+	}
+
+	// Small byval objects have to be declared INTEGER class on x86-64
+	bool TestsIntClass(std::string &error)
+	{
+		SourceHook::CProtoInfoBuilder param(SourceHook::ProtoInfo::CallConv_ThisCall);
+		param.AddParam(sizeof(POD<8>), SourceHook::PassInfo::PassType_Object, SourceHook::PassInfo::PassFlag_ByVal,
+			NULL, NULL, NULL, NULL);
+
+		SourceHook::CProtoInfoBuilder ret(SourceHook::ProtoInfo::CallConv_ThisCall);
+		ret.SetReturnType(sizeof(PodRet8), SourceHook::PassInfo::PassType_Object, SourceHook::PassInfo::PassFlag_ByVal,
+			NULL, NULL, NULL, NULL);
+
+		SourceHook::CProtoInfoBuilder big(SourceHook::ProtoInfo::CallConv_ThisCall);
+		big.AddParam(sizeof(POD<600>), SourceHook::PassInfo::PassType_Object, SourceHook::PassInfo::PassFlag_ByVal,
+			NULL, NULL, NULL, NULL);
+
+		SourceHook::HookManagerPubFunc paramHM = g_HMAGPtr->MakeHookMan(param, 0, 0);
+		SourceHook::HookManagerPubFunc retHM = g_HMAGPtr->MakeHookMan(ret, 0, 1);
+		SourceHook::HookManagerPubFunc bigHM = g_HMAGPtr->MakeHookMan(big, 0, 2);
+
+#if defined( __x86_64__ ) || defined( __amd64__ )
+		CHECK_COND(paramHM == NULL, "TestIntClass Part1.1");
+		CHECK_COND(retHM == NULL, "TestIntClass Part1.2");
+#else
+		CHECK_COND(paramHM != NULL, "TestIntClass Part1.1");
+		CHECK_COND(retHM != NULL, "TestIntClass Part1.2");
+#endif
+		// Passed in memory, doesn't matter
+		CHECK_COND(bigHM != NULL, "TestIntClass Part1.3");
+
+		if (paramHM)
+			g_HMAGPtr->ReleaseHookMan(paramHM);
+		if (retHM)
+			g_HMAGPtr->ReleaseHookMan(retHM);
+		g_HMAGPtr->ReleaseHookMan(bigHM);
+
+		return true;
+	}
 }
 
-#if !defined( _M_AMD64 ) && !defined( __amd64__ ) && !defined(__x86_64__)
+#if !defined( _M_AMD64 )
 bool TestHookManGen(std::string &error)
 {
 	GET_SHPTR(g_SHPtr);
@@ -1120,6 +1262,8 @@ bool TestHookManGen(std::string &error)
 		return false;
 	if (!Tests5(error))
 		return false;
+	if (!TestsIntClass(error))
+		return false;
 
 	// Shutdown now!
 	// If we don't SH will auto-shutdown _after_ genc's destructor is called
@@ -1134,6 +1278,32 @@ bool TestHookManGen(std::string &error)
 
 	return true;
 }
+
+// The same with hook funcs that are regenerated for their hooks
+bool TestHookManGenSpecialized(std::string &error)
+{
+	GET_SHPTR(g_SHPtr);
+	GET_HMAG(g_HMAGPtr, g_SHPtr);
+	Test_HMAG_EnableSpecialization(g_HMAGPtr);
+	g_PLID = 1337;
+
+	if (!Tests1(error))
+		return false;
+	if (!Tests2(error))
+		return false;
+	if (!Tests3(error))
+		return false;
+	if (!Tests4(error))
+		return false;
+	if (!Tests5(error))
+		return false;
+	if (!TestsSpecialized(error))
+		return false;
+
+	Test_CompleteShutdown(g_SHPtr);
+
+	return true;
+}
 #endif
 
 bool TestCPageAlloc(std::string &error)
@@ -1228,5 +1398,41 @@ bool TestCPageAlloc(std::string &error)
 	}
 
 	alloc16.Free(alloc16.Alloc(1));
+
+	// Arena mode
+	CPageAlloc arena(8, true);
+
+	// Small blocks come from size classes
+	char *small1 = reinterpret_cast<char*>(arena.Alloc(12));
+	char *small2 = reinterpret_cast<char*>(arena.Alloc(12));
+	CHECK_COND(small2 == small1 + 16, "Part 5.1");
+
+	arena.Free(small1);
+	CHECK_COND(arena.Alloc(9) == small1, "Part 5.2");
+
+	// Code is written through the writable view and run through the returned address:
+	//   mov eax, 42
+	//   ret
+	static const unsigned char code[] = { 0xB8, 0x2A, 0x00, 0x00, 0x00, 0xC3 };
+	void *func = arena.Alloc(sizeof(code));
+	arena.SetRW(func);
+	memcpy(arena.GetWritable(func), code, sizeof(code));
+	arena.SetRE(func);
+
+	CHECK_COND(memcmp(func, code, sizeof(code)) == 0, "Part 5.3");
+	CHECK_COND(reinterpret_cast<int (*)()>(func)() == 42, "Part 5.4");
+
+	// If the memory could be mapped twice, the code is never writable where it runs
+	int bits;
+	if (arena.GetWritable(func) != func)
+		CHECK_COND(GetPageBits(func, &bits) && (bits & SH_MEM_WRITE) == 0, "Part 5.5");
+
+	// Bigger blocks still go through the regions
+	void *big = arena.Alloc(ps / 2);
+	arena.SetRW(big);
+	memset(arena.GetWritable(big), 0, ps / 2);
+	arena.SetRE(big);
+	arena.Free(big);
+
 	return true;
 }
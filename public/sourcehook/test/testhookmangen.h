@@ -692,6 +692,11 @@ std::ostream& operator <<(std::ostream &os,const ParamState6<0, p1, p2, p3, p4,
 #define THGM_SETUP_PI0(id) \
 	void setuppi_##id() \
 	{ \
+		/* the params are appended, so only once */ \
+		static bool s_Done = false; \
+		if (s_Done) \
+			return; \
+		s_Done = true; \
 		 \
 	}
 	
@@ -886,6 +891,11 @@ std::ostream& operator <<(std::ostream &os,const ParamState6<0, p1, p2, p3, p4,
 #define THGM_SETUP_PI1(id, p1_type, p1_passtype, p1_flags) \
 	void setuppi_##id() \
 	{ \
+		/* the params are appended, so only once */ \
+		static bool s_Done = false; \
+		if (s_Done) \
+			return; \
+		s_Done = true; \
 		 \
 		protoinfo_##id.AddParam(sizeof(p1_type), p1_passtype, p1_flags, \
 			(p1_flags & SourceHook::PassInfo::PassFlag_OCtor) ? FindFuncAddr(&Ctor_Thunk<StripRef< p1_type >::type>::NormalConstructor) : NULL, \
@@ -1087,6 +1097,11 @@ std::ostream& operator <<(std::ostream &os,const ParamState6<0, p1, p2, p3, p4,
 #define THGM_SETUP_PI2(id, p1_type, p1_passtype, p1_flags, p2_type, p2_passtype, p2_flags) \
 	void setuppi_##id() \
 	{ \
+		/* the params are appended, so only once */ \
+		static bool s_Done = false; \
+		if (s_Done) \
+			return; \
+		s_Done = true; \
 		 \
 		protoinfo_##id.AddParam(sizeof(p1_type), p1_passtype, p1_flags, \
 			(p1_flags & SourceHook::PassInfo::PassFlag_OCtor) ? FindFuncAddr(&Ctor_Thunk<StripRef< p1_type >::type>::NormalConstructor) : NULL, \
@@ -1295,6 +1310,11 @@ std::ostream& operator <<(std::ostream &os,const ParamState6<0, p1, p2, p3, p4,
 #define THGM_SETUP_PI3(id, p1_type, p1_passtype, p1_flags, p2_type, p2_passtype, p2_flags, p3_type, p3_passtype, p3_flags) \
 	void setuppi_##id() \
 	{ \
+		/* the params are appended, so only once */ \
+		static bool s_Done = false; \
+		if (s_Done) \
+			return; \
+		s_Done = true; \
 		 \
 		protoinfo_##id.AddParam(sizeof(p1_type), p1_passtype, p1_flags, \
 			(p1_flags & SourceHook::PassInfo::PassFlag_OCtor) ? FindFuncAddr(&Ctor_Thunk<StripRef< p1_type >::type>::NormalConstructor) : NULL, \
@@ -1510,6 +1530,11 @@ std::ostream& operator <<(std::ostream &os,const ParamState6<0, p1, p2, p3, p4,
 #define THGM_SETUP_PI4(id, p1_type, p1_passtype, p1_flags, p2_type, p2_passtype, p2_flags, p3_type, p3_passtype, p3_flags, p4_type, p4_passtype, p4_flags) \
 	void setuppi_##id() \
 	{ \
+		/* the params are appended, so only once */ \
+		static bool s_Done = false; \
+		if (s_Done) \
+			return; \
+		s_Done = true; \
 		 \
 		protoinfo_##id.AddParam(sizeof(p1_type), p1_passtype, p1_flags, \
 			(p1_flags & SourceHook::PassInfo::PassFlag_OCtor) ? FindFuncAddr(&Ctor_Thunk<StripRef< p1_type >::type>::NormalConstructor) : NULL, \
@@ -1732,6 +1757,11 @@ std::ostream& operator <<(std::ostream &os,const ParamState6<0, p1, p2, p3, p4,
 #define THGM_SETUP_PI5(id, p1_type, p1_passtype, p1_flags, p2_type, p2_passtype, p2_flags, p3_type, p3_passtype, p3_flags, p4_type, p4_passtype, p4_flags, p5_type, p5_passtype, p5_flags) \
 	void setuppi_##id() \
 	{ \
+		/* the params are appended, so only once */ \
+		static bool s_Done = false; \
+		if (s_Done) \
+			return; \
+		s_Done = true; \
 		 \
 		protoinfo_##id.AddParam(sizeof(p1_type), p1_passtype, p1_flags, \
 			(p1_flags & SourceHook::PassInfo::PassFlag_OCtor) ? FindFuncAddr(&Ctor_Thunk<StripRef< p1_type >::type>::NormalConstructor) : NULL, \
@@ -1961,6 +1991,11 @@ std::ostream& operator <<(std::ostream &os,const ParamState6<0, p1, p2, p3, p4,
 #define THGM_SETUP_PI6(id, p1_type, p1_passtype, p1_flags, p2_type, p2_passtype, p2_flags, p3_type, p3_passtype, p3_flags, p4_type, p4_passtype, p4_flags, p5_type, p5_passtype, p5_flags, p6_type, p6_passtype, p6_flags) \
 	void setuppi_##id() \
 	{ \
+		/* the params are appended, so only once */ \
+		static bool s_Done = false; \
+		if (s_Done) \
+			return; \
+		s_Done = true; \
 		 \
 		protoinfo_##id.AddParam(sizeof(p1_type), p1_passtype, p1_flags, \
 			(p1_flags & SourceHook::PassInfo::PassFlag_OCtor) ? FindFuncAddr(&Ctor_Thunk<StripRef< p1_type >::type>::NormalConstructor) : NULL, \
@@ -388,6 +388,11 @@ std::ostream& operator <<(std::ostream &os,const ParamState$1<0@[$2,1,$1:, p$2@]
 #define THGM_SETUP_PI$1(id@[$2,1,$1:, p$2_type, p$2_passtype, p$2_flags@]) \
 	void setuppi_##id() \
 	{ \
+		/* the params are appended, so only once */ \
+		static bool s_Done = false; \
+		if (s_Done) \
+			return; \
+		s_Done = true; \
 		@[$2,1,$1: \
 		protoinfo_##id.AddParam(sizeof(p$2_type), p$2_passtype, p$2_flags, \
 			(p$2_flags & SourceHook::PassInfo::PassFlag_OCtor) ? FindFuncAddr(&Ctor_Thunk<StripRef< p$2_type >::type>::NormalConstructor) : NULL, \
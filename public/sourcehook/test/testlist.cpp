@@ -3,10 +3,11 @@
 #include "sh_stack.h"
 #include "sh_tinyhash.h"
 #include "sh_vector.h"
+#include "sh_slaballoc.h"
 #include "testevents.h"
 
 // TEST LIST
-// Tests sh_list, sh_tinyhash, sh_vector
+// Tests sh_list, sh_tinyhash, sh_vector, sh_slaballoc
 
 // :TODO: vector test, list insert test
 
@@ -212,6 +213,66 @@ namespace
 		return true;
 	}
 
+	struct SlabObj : public SourceHook::CSlabAllocated<SlabObj>
+	{
+		int m_Data[5];
+	};
+
+	struct BigSlabObj : public SlabObj
+	{
+		int m_More[64];
+	};
+
+	bool DoTestSlab(std::string &error)
+	{
+		typedef SourceHook::CSlabAllocator<SlabObj> Pool;
+		const int COUNT = 1000;
+		SlabObj *objs[COUNT];
+
+		for (int i = 0; i < COUNT; ++i)
+		{
+			objs[i] = new SlabObj;
+			objs[i]->m_Data[0] = i;
+		}
+		CHECK_COND(Pool::GetLiveCount() == COUNT && Pool::GetSlabCount() > 1, "Part1");
+
+		for (int i = 0; i < COUNT; ++i)
+			CHECK_COND(objs[i]->m_Data[0] == i, "Part2");
+
+		// Freed slots are reused before new slabs get allocated
+		size_t slabs = Pool::GetSlabCount();
+		SlabObj *freed = objs[COUNT / 2];
+		delete freed;
+		objs[COUNT / 2] = new SlabObj;
+		CHECK_COND(objs[COUNT / 2] == freed && Pool::GetSlabCount() == slabs, "Part3");
+
+		// Derived classes don't fit into the slots
+		SlabObj *big = new BigSlabObj;
+		CHECK_COND(Pool::GetLiveCount() == COUNT, "Part4");
+		delete static_cast<BigSlabObj*>(big);
+
+		// Once the last object is gone, one slab is kept for the next ones
+		for (int i = 0; i < COUNT; ++i)
+			delete objs[i];
+		CHECK_COND(Pool::GetLiveCount() == 0 && Pool::GetSlabCount() == 1, "Part5");
+
+		for (int i = 0; i < 10; ++i)
+			delete new SlabObj;
+		CHECK_COND(Pool::GetLiveCount() == 0 && Pool::GetSlabCount() == 1, "Part5.1");
+
+		// Nodes of pooled lists live in their own pool
+		typedef SourceHook::PooledList<Hmm> ListType;
+		{
+			ListType lst;
+			for (int i = 0; i < 100; ++i)
+				lst.push_back(i);
+			CHECK_COND(SourceHook::CSlabAllocator<ListType::ListNode>::GetLiveCount() == 100, "Part6");
+		}
+		CHECK_COND(SourceHook::CSlabAllocator<ListType::ListNode>::GetLiveCount() == 0, "Part7");
+
+		return true;
+	}
+
 	bool DoTestVec(std::string &error)
 	{
 		typedef SourceHook::CVector<int> IntVector;
@@ -278,5 +339,8 @@ bool TestList(std::string &error)
 	if (!DoTestVec(error))
 		return false;
 
+	if (!DoTestSlab(error))
+		return false;
+
 	return true;
 }
@@ -0,0 +1,153 @@
+#include <string>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "sourcehook.h"
+#include "sourcehook_test.h"
+#include "testevents.h"
+
+// TEST MT
+// Hooked functions get called on worker threads while the main thread
+// keeps adding, pausing and removing hooks on them
+
+namespace
+{
+	SourceHook::ISourceHook *g_SHPtr;
+	SourceHook::Plugin g_PLID;
+
+	const int NUM_WORKERS = 4;
+	const int NUM_ROUNDS = 2000;
+
+	class VMTTest
+	{
+	public:
+		virtual int Calc(int x)
+		{
+			return x;
+		}
+	};
+
+	SH_DECL_HOOK1(VMTTest, Calc, SH_NOATTRIB, 0, int, int);
+
+	// The object the current worker calls; hooks must only ever see their own thread's calls
+	thread_local VMTTest *t_Self;
+
+	std::atomic<bool> g_Stop;
+	std::atomic<unsigned int> g_HookCalls;
+	std::atomic<unsigned int> g_Mismatches;
+	std::atomic<unsigned int> g_BadResults;
+	std::atomic<unsigned int> g_WorkerCalls;
+
+	void CheckIface(VMTTest *pIface)
+	{
+		++g_HookCalls;
+		if (pIface != t_Self)
+			++g_Mismatches;
+	}
+
+	int Calc_Pre(int x)
+	{
+		CheckIface(META_IFACEPTR(VMTTest));
+		RETURN_META_VALUE(MRES_IGNORED, 0);
+	}
+
+	int Calc_Supercede(int x)
+	{
+		CheckIface(META_IFACEPTR(VMTTest));
+		RETURN_META_VALUE(MRES_SUPERCEDE, x + 1000);
+	}
+
+	int Calc_VPPost(int x)
+	{
+		CheckIface(META_IFACEPTR(VMTTest));
+
+		// The orig ret belongs to this thread's call as well (the override one if superceded)
+		int ret = META_RESULT_ORIG_RET(int);
+		if (ret != x && ret != x + 1000)
+			++g_BadResults;
+		RETURN_META_VALUE(MRES_IGNORED, 0);
+	}
+
+	void Worker(VMTTest *pObj)
+	{
+		t_Self = pObj;
+
+		int x = 0;
+		while (!g_Stop.load())
+		{
+			++x;
+			int ret = pObj->Calc(x);
+			if (ret != x && ret != x + 1000)
+				++g_BadResults;
+
+			// SH_CALL goes through this thread's context stack only
+			if (SH_CALL(pObj, &VMTTest::Calc)(x) != x)
+				++g_BadResults;
+
+			++g_WorkerCalls;
+		}
+	}
+}
+
+bool TestMT(std::string &error)
+{
+	GET_SHPTR(g_SHPtr);
+	g_PLID = 1337;
+
+	g_Stop = false;
+	g_HookCalls = 0;
+	g_Mismatches = 0;
+	g_BadResults = 0;
+	g_WorkerCalls = 0;
+
+	VMTTest objects[NUM_WORKERS];
+
+	// Keep the vfnptr alive the whole time so the workers always run through the hook loop
+	SH_ADD_HOOK(VMTTest, Calc, &objects[0], SH_STATIC(Calc_Pre), false);
+
+	std::vector<std::thread> workers;
+	for (int i = 0; i < NUM_WORKERS; ++i)
+		workers.push_back(std::thread(Worker, &objects[i]));
+
+	for (int round = 0; round < NUM_ROUNDS; ++round)
+	{
+		VMTTest *pObj = &objects[round % NUM_WORKERS];
+
+		int pre = SH_ADD_HOOK(VMTTest, Calc, pObj, SH_STATIC(Calc_Pre), false);
+		int supercede = SH_ADD_HOOK(VMTTest, Calc, pObj, SH_STATIC(Calc_Supercede), false);
+		int vp = SH_ADD_VPHOOK(VMTTest, Calc, pObj, SH_STATIC(Calc_VPPost), true);
+
+		if (round % 3 == 0)
+		{
+			g_SHPtr->PauseHookByID(supercede);
+			g_SHPtr->UnpauseHookByID(supercede);
+		}
+
+		SH_REMOVE_HOOK_ID(vp);
+		SH_REMOVE_HOOK_ID(supercede);
+		SH_REMOVE_HOOK_ID(pre);
+
+		if (round % 500 == 0)
+			std::this_thread::yield();
+	}
+
+	// Also let the whole vfnptr go away and come back while the workers are calling
+	SH_REMOVE_HOOK(VMTTest, Calc, &objects[0], SH_STATIC(Calc_Pre), false);
+	SH_ADD_HOOK(VMTTest, Calc, &objects[1], SH_STATIC(Calc_Pre), false);
+	SH_REMOVE_HOOK(VMTTest, Calc, &objects[1], SH_STATIC(Calc_Pre), false);
+
+	g_Stop = true;
+	for (size_t i = 0; i < workers.size(); ++i)
+		workers[i].join();
+
+	CHECK_COND(g_WorkerCalls > 0, "Part 1");
+	CHECK_COND(g_HookCalls > 0, "Part 2");
+	CHECK_COND(g_Mismatches == 0, "Part 3");
+	CHECK_COND(g_BadResults == 0, "Part 4");
+
+	// Everything is unhooked -> plain calls again
+	for (int i = 0; i < NUM_WORKERS; ++i)
+		CHECK_COND(objects[i].Calc(i) == i, "Part 5");
+
+	return true;
+}
@@ -39,7 +39,89 @@ namespace
 		pv->Notify();
 	}
 
+	unsigned int g_ManyCalls;
+	unsigned int g_ManyVPCalls;
+
+	void ManyHookFunction()
+	{
+		g_ManyCalls++;
+	}
+
+	void ManyVPHookFunction()
+	{
+		g_ManyVPCalls++;
+	}
+
 	SH_DECL_HOOK0_void(VMultiTest, HookTarget, SH_NOATTRIB, false);
+
+	// Only hooked inside of hook batches
+	class VBatchTest
+	{
+	public:
+		virtual void BatchTarget()
+		{
+		}
+	};
+
+	SH_DECL_HOOK0_void(VBatchTest, BatchTarget, SH_NOATTRIB, false);
+
+	void *BatchVtblEntry(VBatchTest *p)
+	{
+		return (*reinterpret_cast<void***>(p))[0];
+	}
+
+	// Hooks which change the hook list while the hook loop is running
+	std::string g_MidLoopOrder;
+	int g_MidLoopIDs[4];
+	int g_MidLoopAdded;
+
+	void MidLoopHook3()
+	{
+		g_MidLoopOrder += '3';
+	}
+
+	void MidLoopHook0()
+	{
+		g_MidLoopOrder += '0';
+
+		// Pause the next hook, remove ourselves and add a new one at the end
+		g_SHPtr->PauseHookByID(g_MidLoopIDs[1]);
+		SH_REMOVE_HOOK_ID(g_MidLoopIDs[0]);
+		g_MidLoopAdded = SH_ADD_HOOK(VMultiTest, HookTarget, META_IFACEPTR(VMultiTest), SH_STATIC(MidLoopHook3), false);
+	}
+
+	void MidLoopHook1()
+	{
+		g_MidLoopOrder += '1';
+	}
+
+	void MidLoopHook2()
+	{
+		g_MidLoopOrder += '2';
+	}
+
+	// Parameter filters
+	class VFilterTest
+	{
+	public:
+		virtual void FilterTarget(int msgid, const char *name, int &out)
+		{
+		}
+	};
+
+	SH_DECL_HOOK3_void(VFilterTest, FilterTarget, SH_NOATTRIB, false, int, const char *, int &);
+
+	unsigned int g_FilteredCalls;
+
+	void FilteredHookFunction(int msgid, const char *name, int &out)
+	{
+		g_FilteredCalls++;
+	}
+
+	void UnfilteredHookFunction(int msgid, const char *name, int &out)
+	{
+		g_ManyCalls++;
+	}
 };
 
 bool TestMulti(std::string &error)
@@ -102,5 +184,287 @@ bool TestMulti(std::string &error)
 
 	delete [] pv;
 
+	// Many instances on one vfnptr: per-instance lookups have to keep working
+	// while ifaces are added and removed in arbitrary order
+	const unsigned int MANY = 1000;
+	VMultiTest **many = new VMultiTest *[MANY];
+	for (unsigned int i=0; i<MANY; i++)
+		many[i] = new VMultiTest(0);
+
+	for (unsigned int i=0; i<MANY; i+=2)
+		SH_ADD_HOOK(VMultiTest, HookTarget, many[i], SH_STATIC(ManyHookFunction), false);
+	int vphook = SH_ADD_VPHOOK(VMultiTest, HookTarget, many[0], SH_STATIC(ManyVPHookFunction), false);
+
+	g_ManyCalls = g_ManyVPCalls = 0;
+	for (unsigned int i=0; i<MANY; i++)
+		many[i]->HookTarget();
+
+	if (g_ManyCalls != MANY/2 || g_ManyVPCalls != MANY)
+	{
+		error.assign("Part many 1");
+		return false;
+	}
+
+	// Remove every fourth hook, starting from the back
+	for (int i=MANY-4; i>=0; i-=4)
+		SH_REMOVE_HOOK(VMultiTest, HookTarget, many[i], SH_STATIC(ManyHookFunction), false);
+	SH_REMOVE_HOOK_ID(vphook);
+
+	g_ManyCalls = g_ManyVPCalls = 0;
+	for (unsigned int i=0; i<MANY; i++)
+		many[i]->HookTarget();
+
+	if (g_ManyCalls != MANY/4 || g_ManyVPCalls != 0)
+	{
+		error.assign("Part many 2");
+		return false;
+	}
+
+	for (unsigned int i=0; i<MANY; i++)
+	{
+		SH_REMOVE_HOOK(VMultiTest, HookTarget, many[i], SH_STATIC(ManyHookFunction), false);
+		delete many[i];
+	}
+	delete [] many;
+
+	// Pausing, removing and adding hooks from inside the hook loop
+	VMultiTest *midloop = new VMultiTest(0);
+	g_MidLoopIDs[0] = SH_ADD_HOOK(VMultiTest, HookTarget, midloop, SH_STATIC(MidLoopHook0), false);
+	g_MidLoopIDs[1] = SH_ADD_HOOK(VMultiTest, HookTarget, midloop, SH_STATIC(MidLoopHook1), false);
+	g_MidLoopIDs[2] = SH_ADD_HOOK(VMultiTest, HookTarget, midloop, SH_STATIC(MidLoopHook2), false);
+
+	g_MidLoopOrder.clear();
+	midloop->HookTarget();
+	if (g_MidLoopOrder != "023")
+	{
+		error.assign("Part midloop 1");
+		return false;
+	}
+
+	g_SHPtr->UnpauseHookByID(g_MidLoopIDs[1]);
+	g_MidLoopOrder.clear();
+	midloop->HookTarget();
+	if (g_MidLoopOrder != "123")
+	{
+		error.assign("Part midloop 2");
+		return false;
+	}
+
+	SH_REMOVE_HOOK_ID(g_MidLoopIDs[1]);
+	SH_REMOVE_HOOK_ID(g_MidLoopIDs[2]);
+	SH_REMOVE_HOOK_ID(g_MidLoopAdded);
+
+	// Hook funcs skip the hook loop if there's nothing to call for the instance,
+	// but they still have to notice VP hooks and unpaused hooks
+	VMultiTest *other = new VMultiTest(0);
+	int otherhook = SH_ADD_HOOK(VMultiTest, HookTarget, other, SH_STATIC(ManyHookFunction), false);
+	g_SHPtr->PauseHookByID(otherhook);
+
+	g_ManyCalls = g_ManyVPCalls = 0;
+	midloop->HookTarget();
+	other->HookTarget();
+	if (g_ManyCalls != 0 || g_ManyVPCalls != 0)
+	{
+		error.assign("Part bypass 1");
+		return false;
+	}
+
+	g_SHPtr->UnpauseHookByID(otherhook);
+	vphook = SH_ADD_VPHOOK(VMultiTest, HookTarget, other, SH_STATIC(ManyVPHookFunction), false);
+	midloop->HookTarget();
+	other->HookTarget();
+	if (g_ManyCalls != 1 || g_ManyVPCalls != 2)
+	{
+		error.assign("Part bypass 2");
+		return false;
+	}
+
+	SH_REMOVE_HOOK_ID(vphook);
+	SH_REMOVE_HOOK_ID(otherhook);
+	delete other;
+	delete midloop;
+
+	// Hook ids are recycled; removing by handler and unloading a plugin
+	// only affect the hooks of that instance / plugin
+	VMultiTest *first = new VMultiTest(0);
+	VMultiTest *second = new VMultiTest(0);
+	int firsthook = SH_ADD_HOOK(VMultiTest, HookTarget, first, SH_STATIC(ManyHookFunction), false);
+	int secondhook = SH_ADD_HOOK(VMultiTest, HookTarget, second, SH_STATIC(ManyHookFunction), false);
+	SH_REMOVE_HOOK_ID(firsthook);
+	if (SH_ADD_HOOK(VMultiTest, HookTarget, first, SH_STATIC(ManyHookFunction), false) != firsthook)
+	{
+		error.assign("Part ids 1");
+		return false;
+	}
+
+	g_PLID = 1338;
+	SH_ADD_HOOK(VMultiTest, HookTarget, first, SH_STATIC(ManyVPHookFunction), false);
+	g_PLID = 1337;
+
+	if (!SH_REMOVE_HOOK(VMultiTest, HookTarget, first, SH_STATIC(ManyHookFunction), false) ||
+		SH_REMOVE_HOOK(VMultiTest, HookTarget, first, SH_STATIC(ManyVPHookFunction), false))
+	{
+		error.assign("Part ids 2");
+		return false;
+	}
+
+	g_ManyCalls = g_ManyVPCalls = 0;
+	first->HookTarget();
+	second->HookTarget();
+	if (g_ManyCalls != 1 || g_ManyVPCalls != 1)
+	{
+		error.assign("Part ids 3");
+		return false;
+	}
+
+	Test_UnloadPlugin(g_SHPtr, 1338);
+	g_ManyCalls = g_ManyVPCalls = 0;
+	first->HookTarget();
+	second->HookTarget();
+	if (g_ManyCalls != 1 || g_ManyVPCalls != 0)
+	{
+		error.assign("Part ids 4");
+		return false;
+	}
+
+	SH_REMOVE_HOOK_ID(secondhook);
+	delete first;
+	delete second;
+
+	// Hook batches: newly hooked vtable entries are patched on the outermost commit
+	const unsigned int BATCH = 16;
+	VBatchTest *batch = new VBatchTest[BATCH];
+	void *origentry = BatchVtblEntry(&batch[0]);
+	int batchhooks[BATCH];
+
+	SH_BEGIN_HOOK_BATCH();
+	SH_BEGIN_HOOK_BATCH();
+	for (unsigned int i=0; i<BATCH; i++)
+		batchhooks[i] = SH_ADD_HOOK(VBatchTest, BatchTarget, &batch[i], SH_STATIC(ManyHookFunction), false);
+	SH_COMMIT_HOOK_BATCH();
+
+	g_ManyCalls = 0;
+	batch[0].BatchTarget();
+	if (BatchVtblEntry(&batch[0]) != origentry || g_ManyCalls != 0)
+	{
+		error.assign("Part batch 1");
+		return false;
+	}
+
+	SH_COMMIT_HOOK_BATCH();
+	for (unsigned int i=0; i<BATCH; i++)
+		batch[i].BatchTarget();
+	if (BatchVtblEntry(&batch[0]) == origentry || g_ManyCalls != BATCH)
+	{
+		error.assign("Part batch 2");
+		return false;
+	}
+
+	// Removing everything reverts right away
+	SH_BEGIN_HOOK_BATCH();
+	for (unsigned int i=0; i<BATCH; i++)
+		SH_REMOVE_HOOK_ID(batchhooks[i]);
+	if (BatchVtblEntry(&batch[0]) != origentry)
+	{
+		error.assign("Part batch 3");
+		return false;
+	}
+
+	// Adding and removing in the same batch leaves the vtable alone
+	int tmphook = SH_ADD_HOOK(VBatchTest, BatchTarget, &batch[0], SH_STATIC(ManyHookFunction), false);
+	SH_REMOVE_HOOK_ID(tmphook);
+	SH_COMMIT_HOOK_BATCH();
+	if (BatchVtblEntry(&batch[0]) != origentry)
+	{
+		error.assign("Part batch 4");
+		return false;
+	}
+
+	delete [] batch;
+
+	// Profiling counts the handler calls of every hook while it's running
+	VMultiTest *profiled = new VMultiTest(0);
+	int prehook = SH_ADD_HOOK(VMultiTest, HookTarget, profiled, SH_STATIC(ManyHookFunction), false);
+	int posthook = SH_ADD_HOOK(VMultiTest, HookTarget, profiled, SH_STATIC(ManyHookFunction), true);
+	vphook = SH_ADD_VPHOOK(VMultiTest, HookTarget, profiled, SH_STATIC(ManyVPHookFunction), false);
+
+	profiled->HookTarget();
+	Test_StartProfiling(g_SHPtr);
+	for (int i = 0; i < 3; ++i)
+		profiled->HookTarget();
+	SH_REMOVE_HOOK_ID(posthook);
+	profiled->HookTarget();
+	Test_StopProfiling(g_SHPtr);
+	profiled->HookTarget();
+
+	if (Test_GetProfiledCalls(g_SHPtr, prehook) != 4 || Test_GetProfiledCalls(g_SHPtr, posthook) != 3 ||
+		Test_GetProfiledCalls(g_SHPtr, vphook) != 4)
+	{
+		error.assign("Part profile 1");
+		return false;
+	}
+
+	// Starting again throws away the old stats
+	posthook = SH_ADD_HOOK(VMultiTest, HookTarget, profiled, SH_STATIC(ManyHookFunction), true);
+	Test_StartProfiling(g_SHPtr);
+	profiled->HookTarget();
+	Test_StopProfiling(g_SHPtr);
+	if (Test_GetProfiledCalls(g_SHPtr, prehook) != 1 || Test_GetProfiledCalls(g_SHPtr, posthook) != 1)
+	{
+		error.assign("Part profile 2");
+		return false;
+	}
+
+	SH_REMOVE_HOOK_ID(prehook);
+	SH_REMOVE_HOOK_ID(posthook);
+	SH_REMOVE_HOOK_ID(vphook);
+	delete profiled;
+
+	// Filtered hooks only see the calls whose parameter matches
+	VFilterTest *filtertest = new VFilterTest;
+	const char *name = "name";
+	int out = 0;
+	SourceHook::HookFilter filter;
+	filter.param = 0;
+	filter.numValues = 2;
+	filter.values[0] = 5;
+	filter.values[1] = static_cast<unsigned long long>(-1);
+
+	int filtered = SH_ADD_HOOK_FILTERED(VFilterTest, FilterTarget, filtertest, SH_STATIC(FilteredHookFunction), false, &filter);
+	int unfiltered = SH_ADD_HOOK(VFilterTest, FilterTarget, filtertest, SH_STATIC(UnfilteredHookFunction), true);
+	g_ManyCalls = 0;
+	filtertest->FilterTarget(5, name, out);
+	filtertest->FilterTarget(6, name, out);
+	filtertest->FilterTarget(-1, name, out);
+	if (!filtered || g_FilteredCalls != 2 || g_ManyCalls != 3)
+	{
+		error.assign("Part filter 1");
+		return false;
+	}
+
+	// Pointers are compared too; out of range or by reference parameters can't be filtered
+	filter.param = 1;
+	filter.numValues = 1;
+	filter.values[0] = reinterpret_cast<unsigned long long>(name);
+	int filtered2 = SH_ADD_HOOK_FILTERED(VFilterTest, FilterTarget, filtertest, SH_STATIC(FilteredHookFunction), true, &filter);
+	filter.param = 2;
+	int byref = SH_ADD_HOOK_FILTERED(VFilterTest, FilterTarget, filtertest, SH_STATIC(FilteredHookFunction), true, &filter);
+	filter.param = 3;
+	int outofrange = SH_ADD_HOOK_FILTERED(VFilterTest, FilterTarget, filtertest, SH_STATIC(FilteredHookFunction), true, &filter);
+
+	g_FilteredCalls = 0;
+	filtertest->FilterTarget(5, name, out);
+	filtertest->FilterTarget(7, "other", out);
+	if (!filtered2 || byref || outofrange || g_FilteredCalls != 2)
+	{
+		error.assign("Part filter 2");
+		return false;
+	}
+
+	SH_REMOVE_HOOK_ID(filtered);
+	SH_REMOVE_HOOK_ID(filtered2);
+	SH_REMOVE_HOOK_ID(unfiltered);
+	delete filtertest;
+
 	return true;
 }
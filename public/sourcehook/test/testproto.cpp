@@ -0,0 +1,83 @@
+#include <string>
+#include "sourcehook_impl.h"
+#include "testevents.h"
+
+// TEST PROTO
+// Tests the interning of CProtoRef and how the hook id manager matches protos
+
+namespace
+{
+	class Deleg : public SourceHook::ISHDelegate
+	{
+	public:
+		bool IsEqual(SourceHook::ISHDelegate *pOtherDeleg)
+		{
+			return pOtherDeleg == this;
+		}
+		void DeleteThis()
+		{
+		}
+	};
+
+	// Signatures nothing else in the test suite uses
+	typedef SourceHook::HookProto<double, char, double, short, float> ProtoA;
+	typedef SourceHook::HookProto<double, char, double, short, float &> ProtoB;
+}
+
+bool TestProtoRef(std::string &error)
+{
+	using namespace SourceHook;
+	using namespace SourceHook::Impl;
+
+	size_t numBefore = CProtoRef::GetNumInterned();
+	{
+		// Same signature -> same node
+		CProtoRef a1(&ProtoA::ms_Proto);
+		CProtoRef a2(&ProtoA::ms_Proto);
+		CProtoRef a3(CProto(&ProtoA::ms_Proto));
+
+		CHECK_COND(a1.IsValid(), "Part 1.1");
+		CHECK_COND(a1 == a2 && a1 == a3, "Part 1.2");
+		CHECK_COND(CProtoRef::GetNumInterned() == numBefore + 1, "Part 1.3");
+
+		// Different signature -> different node
+		CProtoRef b(&ProtoB::ms_Proto);
+
+		CHECK_COND(b.IsValid(), "Part 2.1");
+		CHECK_COND(a1 != b, "Part 2.2");
+		CHECK_COND(CProtoRef::GetNumInterned() == numBefore + 2, "Part 2.3");
+
+		// Invalid protos aren't interned
+		CProtoRef inv1((CProto()));
+		CProtoRef inv2((CProto()));
+
+		CHECK_COND(!inv1.IsValid() && !inv2.IsValid(), "Part 3.1");
+		CHECK_COND(inv1->GetVersion() == -1, "Part 3.2");
+		CHECK_COND(inv1 != a1 && inv1 != b, "Part 3.3");
+		CHECK_COND(CProtoRef::GetNumInterned() == numBefore + 2, "Part 3.4");
+
+		// The hook id manager matches valid protos by identity; an invalid proto matches nothing
+		CHookIDManager hookIDMan;
+		Deleg deleg;
+		int dummy;
+		int hookA = hookIDMan.New(a1, 0, 1, &dummy, &dummy, 1, 0, &deleg, false);
+		hookIDMan.New(inv1, 0, 1, &dummy, &dummy, 1, 0, &deleg, false);
+
+		CVector<int> found;
+		hookIDMan.FindAllHooks(found, a2, 0, 1, &dummy, 1, 0, &deleg, false);
+		CHECK_COND(found.size() == 1 && found[0] == hookA, "Part 4.1");
+
+		found.clear();
+		hookIDMan.FindAllHooks(found, b, 0, 1, &dummy, 1, 0, &deleg, false);
+		CHECK_COND(found.empty(), "Part 4.2");
+
+		found.clear();
+		hookIDMan.FindAllHooks(found, inv2, 0, 1, &dummy, 1, 0, &deleg, false);
+		CHECK_COND(found.empty(), "Part 4.3");
+	}
+
+	// The nodes go away with their last ref
+	CHECK_COND(CProtoRef::GetNumInterned() == numBefore, "Part 5");
+
+	return true;
+}
@@ -81,6 +81,36 @@ namespace
 		}
 	};
 
+	// Return value which counts its copies
+	struct CopyCounter
+	{
+		static int ms_Copies;
+		int m_Val;
+
+		CopyCounter(int val = 0) : m_Val(val)
+		{
+		}
+		CopyCounter(const CopyCounter &other) : m_Val(other.m_Val)
+		{
+			++ms_Copies;
+		}
+		CopyCounter(CopyCounter &&other) : m_Val(other.m_Val)
+		{
+		}
+		CopyCounter &operator =(const CopyCounter &other)
+		{
+			m_Val = other.m_Val;
+			++ms_Copies;
+			return *this;
+		}
+		CopyCounter &operator =(CopyCounter &&other)
+		{
+			m_Val = other.m_Val;
+			return *this;
+		}
+	};
+	int CopyCounter::ms_Copies = 0;
+
 	class CHello
 	{
 	public:
@@ -92,6 +122,11 @@ namespace
 		virtual void F2(POD a)
 		{
 		}
+
+		virtual CopyCounter F3()
+		{
+			return CopyCounter(1);
+		}
 	};
 
 
@@ -122,11 +157,22 @@ namespace
 		virtual void F21(POD a)
 		{
 		}
+
+		virtual CopyCounter F3_Ignore()
+		{
+			RETURN_META_VALUE(MRES_IGNORED, CopyCounter(2));
+		}
+
+		virtual CopyCounter F3_Override()
+		{
+			RETURN_META_VALUE(MRES_OVERRIDE, CopyCounter(3));
+		}
 	};
 
 	SH_DECL_HOOK1(CHello, Func, SH_NOATTRIB, 0, int, CBase&);
 	SH_DECL_HOOK1_void(CHello, F2, SH_NOATTRIB, 0, POD);
 	SH_DECL_HOOK1_void(Test2, F2, SH_NOATTRIB, 0, POD&);
+	SH_DECL_HOOK0(CHello, F3, SH_NOATTRIB, 0, CopyCounter);
 
 	CHello *MyInstanceFactory()
 	{
@@ -223,5 +269,15 @@ bool TestRef(std::string &error)
 		new State_F2_Called(1, 2),
 		NULL), "Part 5");
 
+	// Return values are moved through the hook func, not copied
+	SH_ADD_HOOK(CHello, F3, pHello, SH_MEMBER(&hook, &CHook::F3_Ignore), false);
+	CopyCounter::ms_Copies = 0;
+	CopyCounter ret = pHello->F3();
+	CHECK_COND(ret.m_Val == 1 && CopyCounter::ms_Copies == 0, "Part 6");
+
+	SH_ADD_HOOK(CHello, F3, pHello, SH_MEMBER(&hook, &CHook::F3_Override), true);
+	ret = pHello->F3();
+	CHECK_COND(ret.m_Val == 3 && CopyCounter::ms_Copies == 0, "Part 7");
+
    	return true;
 }